@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+**
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of a Qt Solutions component.
+**
+** You may use this file under the terms of the BSD license as follows:
+**
+** "Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are
+** met:
+**   * Redistributions of source code must retain the above copyright
+**     notice, this list of conditions and the following disclaimer.
+**   * Redistributions in binary form must reproduce the above copyright
+**     notice, this list of conditions and the following disclaimer in
+**     the documentation and/or other materials provided with the
+**     distribution.
+**   * Neither the name of Nokia Corporation and its Subsidiary(-ies) nor
+**     the names of its contributors may be used to endorse or promote
+**     products derived from this software without specific prior written
+**     permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+** "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+** LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+** A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+** OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+** OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE."
+**
+****************************************************************************/
+
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include "qtvariantproperty.h"
+
+// For every type the variant manager supports, reads values, reads every
+// attribute and writes the values back through the QtVariantProperty
+// interface, and prints the average time of one call.
+
+static void report(QTextStream &out, const QString &typeName, const char *operation,
+            qint64 nsecs, int calls)
+{
+    out << typeName << " " << operation << ": ";
+    if (calls)
+        out << double(nsecs) / calls << " ns per call\n";
+    else
+        out << "no calls\n";
+}
+
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+
+    int repeatCount = 100000;
+    if (argc > 1)
+        repeatCount = QString::fromLocal8Bit(argv[1]).toInt();
+
+    QtVariantPropertyManager manager;
+    QList<int> types;
+    types << QVariant::Int << QVariant::Double << QVariant::Bool << QVariant::String
+          << QVariant::Date << QVariant::Time << QVariant::DateTime << QVariant::KeySequence
+          << QVariant::Char << QVariant::Locale << QVariant::Point << QVariant::PointF
+          << QVariant::Size << QVariant::SizeF << QVariant::Rect << QVariant::RectF
+          << QVariant::Color << QVariant::SizePolicy << QVariant::Font << QVariant::Cursor
+          << QtVariantPropertyManager::enumTypeId() << QtVariantPropertyManager::flagTypeId();
+
+    QTextStream out(stdout);
+    QElapsedTimer timer;
+    QListIterator<int> itType(types);
+    while (itType.hasNext()) {
+        const int type = itType.next();
+        if (!manager.isPropertyTypeSupported(type))
+            continue;
+        QtVariantProperty *property = manager.addProperty(type, QLatin1String("Property"));
+        const QStringList names = QStringList() << QLatin1String("One")
+                    << QLatin1String("Two") << QLatin1String("Three");
+        if (type == QtVariantPropertyManager::enumTypeId())
+            property->setAttribute(QLatin1String("enumNames"), names);
+        else if (type == QtVariantPropertyManager::flagTypeId())
+            property->setAttribute(QLatin1String("flagNames"), names);
+        QString typeName;
+        if (type == QtVariantPropertyManager::enumTypeId())
+            typeName = QLatin1String("enum");
+        else if (type == QtVariantPropertyManager::flagTypeId())
+            typeName = QLatin1String("flag");
+        else
+            typeName = QLatin1String(QVariant::typeToName(type));
+
+        timer.start();
+        for (int i = 0; i < repeatCount; ++i)
+            property->value();
+        report(out, typeName, "value()", timer.nsecsElapsed(), repeatCount);
+
+        const QStringList attributes = manager.attributes(type);
+        timer.start();
+        for (int i = 0; i < repeatCount; ++i) {
+            QStringListIterator itAttribute(attributes);
+            while (itAttribute.hasNext())
+                property->attributeValue(itAttribute.next());
+        }
+        report(out, typeName, "attributeValue()", timer.nsecsElapsed(), repeatCount * attributes.count());
+
+        const QVariant value = property->value();
+        timer.start();
+        for (int i = 0; i < repeatCount; ++i)
+            property->setValue(value);
+        report(out, typeName, "setValue()", timer.nsecsElapsed(), repeatCount);
+
+        delete property;
+    }
+
+    return 0;
+}
@@ -282,21 +282,8 @@ void MainWindow::itemMoved(QtCanvasItem *item)
     doubleManager->setValue(idToProperty[QLatin1String("zpos")], item->z());
 }
 
-void MainWindow::updateExpandState()
-{
-    QList<QtBrowserItem *> list = propertyEditor->topLevelItems();
-    QListIterator<QtBrowserItem *> it(list);
-    while (it.hasNext()) {
-        QtBrowserItem *item = it.next();
-        QtProperty *prop = item->property();
-        idToExpanded[propertyToId[prop]] = propertyEditor->isExpanded(item);
-    }
-}
-
 void MainWindow::itemClicked(QtCanvasItem *item)
 {
-    updateExpandState();
-
     QMap<QtProperty *, QString>::ConstIterator itProp = propertyToId.constBegin();
     while (itProp != propertyToId.constEnd()) {
         delete itProp.key();
@@ -386,9 +373,8 @@ void MainWindow::addProperty(QtProperty *property, const QString &id)
 {
     propertyToId[property] = id;
     idToProperty[id] = property;
-    QtBrowserItem *item = propertyEditor->addProperty(property);
-    if (idToExpanded.contains(id))
-        propertyEditor->setExpanded(item, idToExpanded[id]);
+    property->setPropertyId(id);
+    propertyEditor->addProperty(property);
 }
 
 void MainWindow::valueChanged(QtProperty *property, double value)
@@ -97,7 +97,6 @@ private:
     QtCanvasItem *addLine();
     QtCanvasItem *addText();
     void addProperty(QtProperty *property, const QString &id);
-    void updateExpandState();
 
     QAction *deleteAction;
 
@@ -114,7 +113,6 @@ private:
     QtCanvasItem *currentItem;
     QMap<QtProperty *, QString> propertyToId;
     QMap<QString, QtProperty *> idToProperty;
-    QMap<QString, bool> idToExpanded;
 };
 
 #endif
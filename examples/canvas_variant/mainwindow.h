@@ -96,7 +96,6 @@ private:
     QtCanvasItem *addLine();
     QtCanvasItem *addText();
     void addProperty(QtVariantProperty *property, const QString &id);
-    void updateExpandState();
 
     QAction *deleteAction;
 
@@ -108,7 +107,6 @@ private:
     QtCanvasItem *currentItem;
     QMap<QtProperty *, QString> propertyToId;
     QMap<QString, QtVariantProperty *> idToProperty;
-    QMap<QString, bool> idToExpanded;
 };
 
 #endif
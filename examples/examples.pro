@@ -3,5 +3,5 @@
 ######################################################################
 
 TEMPLATE = subdirs
-SUBDIRS = simple canvas_variant canvas_typed demo decoration extension object_controller
+SUBDIRS = simple canvas_variant canvas_typed demo decoration extension object_controller insertion_benchmark startup_benchmark validation_benchmark attribute_benchmark
 
@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+**
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of a Qt Solutions component.
+**
+** You may use this file under the terms of the BSD license as follows:
+**
+** "Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are
+** met:
+**   * Redistributions of source code must retain the above copyright
+**     notice, this list of conditions and the following disclaimer.
+**   * Redistributions in binary form must reproduce the above copyright
+**     notice, this list of conditions and the following disclaimer in
+**     the documentation and/or other materials provided with the
+**     distribution.
+**   * Neither the name of Nokia Corporation and its Subsidiary(-ies) nor
+**     the names of its contributors may be used to endorse or promote
+**     products derived from this software without specific prior written
+**     permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+** "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+** LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+** A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+** OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+** OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE."
+**
+****************************************************************************/
+
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include "qtpropertymanager.h"
+#include "qteditorfactory.h"
+#include "qtgroupboxpropertybrowser.h"
+#include "qtbuttonpropertybrowser.h"
+#include "qtvirtualgroupboxpropertybrowser.h"
+
+// Inserts rowCount int properties at the front of a group that is shown in
+// browser, and reports the time spent in the insertions and in the deferred
+// layout update that follows them.
+static void insertAtFront(QtAbstractPropertyBrowser *browser, const QString &name, int rowCount)
+{
+    QtGroupPropertyManager groupManager;
+    QtIntPropertyManager intManager;
+    QtSpinBoxFactory spinBoxFactory;
+    browser->setFactoryForManager(&intManager, &spinBoxFactory);
+
+    QtProperty *group = groupManager.addProperty(QLatin1String("Group"));
+    QtBrowserItem *groupItem = browser->addProperty(group);
+    if (QtButtonPropertyBrowser *buttonBrowser = qobject_cast<QtButtonPropertyBrowser *>(browser))
+        buttonBrowser->setExpanded(groupItem, true);
+    browser->resize(400, 600);
+    browser->show();
+    QApplication::processEvents();
+
+    QList<QtProperty *> properties;
+    for (int i = 0; i < rowCount; ++i) {
+        QtProperty *property = intManager.addProperty(QString::number(i));
+        intManager.setValue(property, i);
+        properties.append(property);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext())
+        group->insertSubProperty(itProperty.next(), 0);
+    const qint64 insertTime = timer.elapsed();
+    QApplication::processEvents();
+    QApplication::processEvents();
+    const qint64 totalTime = timer.elapsed();
+
+    QTextStream out(stdout);
+    out << name << ": inserted " << rowCount << " rows in " << insertTime
+        << " ms, laid out after " << totalTime << " ms\n";
+
+    browser->clear();
+    browser->unsetFactoryForManager(&intManager);
+}
+
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+
+    int rowCount = 5000;
+    if (argc > 1)
+        rowCount = QString::fromLocal8Bit(argv[1]).toInt();
+
+    QtGroupBoxPropertyBrowser groupBoxBrowser;
+    insertAtFront(&groupBoxBrowser, QLatin1String("QtGroupBoxPropertyBrowser"), rowCount);
+
+    QtButtonPropertyBrowser buttonBrowser;
+    insertAtFront(&buttonBrowser, QLatin1String("QtButtonPropertyBrowser"), rowCount);
+
+    QtVirtualGroupBoxPropertyBrowser virtualBrowser;
+    insertAtFront(&virtualBrowser, QLatin1String("QtVirtualGroupBoxPropertyBrowser"), rowCount);
+
+    return 0;
+}
@@ -55,8 +55,6 @@ public:
 
     void addClassProperties(const QMetaObject *metaObject);
     void updateClassProperties(const QMetaObject *metaObject, bool recursive);
-    void saveExpandedState();
-    void restoreExpandedState();
     void slotValueChanged(QtProperty *property, const QVariant &value);
     int enumToInt(const QMetaEnum &metaEnum, int enumValue) const;
     int intToEnum(const QMetaEnum &metaEnum, int intValue) const;
@@ -72,8 +70,6 @@ public:
     QMap<QtProperty *, int>     m_propertyToIndex;
     QMap<const QMetaObject *, QMap<int, QtVariantProperty *> > m_classToIndexToProperty;
 
-    QMap<QtProperty *, bool>    m_propertyToExpanded;
-
     QList<QtProperty *>         m_topLevelProperties;
 
     QtAbstractPropertyBrowser    *m_browser;
@@ -288,16 +284,6 @@ void ObjectControllerPrivate::addClassProperties(const QMetaObject *metaObject)
     m_browser->addProperty(classProperty);
 }
 
-void ObjectControllerPrivate::saveExpandedState()
-{
-
-}
-
-void ObjectControllerPrivate::restoreExpandedState()
-{
-
-}
-
 void ObjectControllerPrivate::slotValueChanged(QtProperty *property, const QVariant &value)
 {
     if (!m_propertyToIndex.contains(property))
@@ -365,7 +351,6 @@ void ObjectController::setObject(QObject *object)
         return;
 
     if (d_ptr->m_object) {
-        d_ptr->saveExpandedState();
         QListIterator<QtProperty *> it(d_ptr->m_topLevelProperties);
         while (it.hasNext()) {
             d_ptr->m_browser->removeProperty(it.next());
@@ -379,8 +364,6 @@ void ObjectController::setObject(QObject *object)
         return;
 
     d_ptr->addClassProperties(d_ptr->m_object->metaObject());
-
-    d_ptr->restoreExpandedState();
 }
 
 QObject *ObjectController::object() const
@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+**
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of a Qt Solutions component.
+**
+** You may use this file under the terms of the BSD license as follows:
+**
+** "Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are
+** met:
+**   * Redistributions of source code must retain the above copyright
+**     notice, this list of conditions and the following disclaimer.
+**   * Redistributions in binary form must reproduce the above copyright
+**     notice, this list of conditions and the following disclaimer in
+**     the documentation and/or other materials provided with the
+**     distribution.
+**   * Neither the name of Nokia Corporation and its Subsidiary(-ies) nor
+**     the names of its contributors may be used to endorse or promote
+**     products derived from this software without specific prior written
+**     permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+** "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+** LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+** A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+** OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+** OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE."
+**
+****************************************************************************/
+
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QLocale>
+#include "qtpropertymanager.h"
+#include "qtvariantproperty.h"
+
+// Each step creates the first manager of a kind and its first property.
+// The tables that the managers build on first use are shared by the whole
+// process, so every step is run and measured only once.
+
+static void createLocaleProperty()
+{
+    QtLocalePropertyManager manager;
+    QtProperty *property = manager.addProperty(QLatin1String("Locale"));
+    manager.setValue(property, QLocale(QLocale::German, QLocale::Germany));
+    property->valueText();
+}
+
+static void createSizePolicyProperty()
+{
+    QtSizePolicyPropertyManager manager;
+    QtProperty *property = manager.addProperty(QLatin1String("Size Policy"));
+    property->valueText();
+}
+
+static void createCursorProperty()
+{
+    QtCursorPropertyManager manager;
+    QtProperty *property = manager.addProperty(QLatin1String("Cursor"));
+    property->valueText();
+    property->valueIcon();
+}
+
+static void createFontProperty()
+{
+    QtFontPropertyManager manager;
+    QtProperty *property = manager.addProperty(QLatin1String("Font"));
+    property->valueText();
+}
+
+static void loadFontFamilies()
+{
+    // The font family list is read once control returns to the event loop.
+    QApplication::processEvents();
+}
+
+static void createEnumProperty()
+{
+    QtEnumPropertyManager manager;
+    QtProperty *property = manager.addProperty(QLatin1String("Enum"));
+    manager.setEnumNames(property, QStringList() << QLatin1String("One")
+                << QLatin1String("Two") << QLatin1String("Three"));
+    property->valueText();
+}
+
+static void createVariantManager()
+{
+    QtVariantPropertyManager manager;
+    QtVariantProperty *property = manager.addProperty(QVariant::Int, QLatin1String("Int"));
+    property->valueText();
+}
+
+static void measure(QTextStream &out, const char *name, void (*step)())
+{
+    QElapsedTimer timer;
+    timer.start();
+    step();
+    out << name << ": " << timer.nsecsElapsed() / 1000 << " us\n";
+}
+
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+
+    QTextStream out(stdout);
+    measure(out, "first locale property", createLocaleProperty);
+    measure(out, "first size policy property", createSizePolicyProperty);
+    measure(out, "first cursor property", createCursorProperty);
+    measure(out, "first font property", createFontProperty);
+    measure(out, "font family list", loadFontFamilies);
+    measure(out, "first enum property", createEnumProperty);
+    measure(out, "first variant manager", createVariantManager);
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+**
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of a Qt Solutions component.
+**
+** You may use this file under the terms of the BSD license as follows:
+**
+** "Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are
+** met:
+**   * Redistributions of source code must retain the above copyright
+**     notice, this list of conditions and the following disclaimer.
+**   * Redistributions in binary form must reproduce the above copyright
+**     notice, this list of conditions and the following disclaimer in
+**     the documentation and/or other materials provided with the
+**     distribution.
+**   * Neither the name of Nokia Corporation and its Subsidiary(-ies) nor
+**     the names of its contributors may be used to endorse or promote
+**     products derived from this software without specific prior written
+**     permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+** "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+** LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+** A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+** OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+** OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE."
+**
+****************************************************************************/
+
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QRegExp>
+#include <QRegularExpression>
+#include <QTextStream>
+#include "qtpropertymanager.h"
+#include "qteditorfactory.h"
+#include "qtgroupboxpropertybrowser.h"
+
+static void report(QTextStream &out, const char *name, const QElapsedTimer &timer, int count)
+{
+    out << name << ": " << timer.elapsed() << " ms for " << count << " properties\n";
+}
+
+static void setValues(QtStringPropertyManager &manager, const QList<QtProperty *> &properties,
+            const QString &value)
+{
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext())
+        manager.setValue(itProperty.next(), value);
+}
+
+// Times setting the short and long values on all properties; the
+// expression or QRegExp must have been set already.
+static void benchmarkValues(QTextStream &out, const char *api, QtStringPropertyManager &manager,
+            const QList<QtProperty *> &properties)
+{
+    // About 11000 characters; the near miss differs only at its end, so
+    // the whole input has to be scanned before it is rejected.
+    QString longValue;
+    for (int i = 0; i < 1000; ++i)
+        longValue += QLatin1String("segment_") + QString::number(i % 10) + QLatin1Char('.');
+    longValue += QLatin1String("property");
+    const QString longNearMiss = longValue + QLatin1Char('.');
+
+    const struct {
+        const char *name;
+        QString value;
+    } cases[] = {
+        { "matching values", QLatin1String("object.child.property") },
+        { "rejected values", QLatin1String("object..property") },
+        { "long matching values", longValue },
+        { "long near-miss values", longNearMiss }
+    };
+
+    QElapsedTimer timer;
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        timer.start();
+        setValues(manager, properties, cases[i].value);
+        out << api << " setValue() with " << cases[i].name << " (" << cases[i].value.length()
+            << " characters): " << timer.elapsed() << " ms for " << properties.count() << " properties\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+
+    int propertyCount = 2000;
+    if (argc > 1)
+        propertyCount = QString::fromLocal8Bit(argv[1]).toInt();
+
+    const QString pattern = QLatin1String("[A-Za-z_][A-Za-z0-9_]*(\\.[A-Za-z_][A-Za-z0-9_]*)*");
+
+    QtStringPropertyManager manager;
+    QtStringPropertyManager regExpManager;
+    QList<QtProperty *> properties;
+    QList<QtProperty *> regExpProperties;
+    for (int i = 0; i < propertyCount; ++i) {
+        properties.append(manager.addProperty(QString::number(i)));
+        regExpProperties.append(regExpManager.addProperty(QString::number(i)));
+    }
+
+    QTextStream out(stdout);
+    QElapsedTimer timer;
+
+    // All properties use the same pattern, so they share one compiled
+    // expression.
+    const QRegularExpression expression(pattern);
+    timer.start();
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext())
+        manager.setRegularExpression(itProperty.next(), expression);
+    report(out, "setRegularExpression()", timer, propertyCount);
+    benchmarkValues(out, "QRegularExpression", manager, properties);
+
+    // The same pattern through QRegExp, as a baseline
+    const QRegExp regExp(pattern);
+    timer.start();
+    QListIterator<QtProperty *> itRegExpProperty(regExpProperties);
+    while (itRegExpProperty.hasNext())
+        regExpManager.setRegExp(itRegExpProperty.next(), regExp);
+    report(out, "setRegExp()", timer, propertyCount);
+    benchmarkValues(out, "QRegExp", regExpManager, regExpProperties);
+
+    // The line edits of all properties share one validator.
+    QtLineEditFactory lineEditFactory;
+    QtGroupBoxPropertyBrowser browser;
+    browser.setFactoryForManager(&manager, &lineEditFactory);
+    timer.start();
+    itProperty.toFront();
+    while (itProperty.hasNext())
+        browser.addProperty(itProperty.next());
+    report(out, "editors with validators", timer, propertyCount);
+
+    browser.clear();
+    return 0;
+}
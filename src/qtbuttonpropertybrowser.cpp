@@ -39,11 +39,12 @@
 
 
 #include "qtbuttonpropertybrowser.h"
+#include "qtpropertybrowserutils_p.h"
 #include <QtCore/QSet>
 #include <QtCore/QTimer>
 #include <QtCore/QMap>
 #include <QGridLayout>
-#include <QLabel>
+#include <QFrame>
 #include <QToolButton>
 #include <QStyle>
 
@@ -56,42 +57,59 @@ class QtButtonPropertyBrowserPrivate
     QtButtonPropertyBrowser *q_ptr;
     Q_DECLARE_PUBLIC(QtButtonPropertyBrowser)
 public:
+    QtButtonPropertyBrowserPrivate() : m_mainLayout(0), m_updatePending(false),
+            m_collapsedWidgetBudget(-1), m_collapsedWidgetCount(0) { }
 
     void init(QWidget *parent);
 
     void propertyInserted(QtBrowserItem *index, QtBrowserItem *afterIndex);
     void propertyRemoved(QtBrowserItem *index);
     void propertyChanged(QtBrowserItem *index);
+    void propertiesChanged(const QList<QtBrowserItem *> &indexes);
     QWidget *createEditor(QtProperty *property, QWidget *parent) const
         { return q_ptr->createEditor(property, parent); }
 
     void slotEditorDestroyed();
     void slotUpdate();
     void slotToggled(bool checked);
+    void applyExpandState();
+    void setCollapsedWidgetBudget(int budget);
 
     struct WidgetItem
     {
         WidgetItem() : widget(0), label(0), widgetLabel(0),
-                button(0), container(0), layout(0), /*line(0), */parent(0), expanded(false) { }
+                button(0), container(0), layout(0), /*line(0), */parent(0), expanded(false),
+                populated(false) { }
         QWidget *widget; // can be null
-        QLabel *label; // main label with property name
-        QLabel *widgetLabel; // label substitute showing the current value if there is no widget
+        QtTextLayoutItem *label; // painted property name
+        QtTextLayoutItem *widgetLabel; // painted value if there is no widget
         QToolButton *button; // expandable button for items with children
         QWidget *container; // container which is expanded when the button is clicked
         QGridLayout *layout; // layout in container
         WidgetItem *parent;
         QList<WidgetItem *> children;
         bool expanded;
+        bool populated; // whether the children have their widgets
     };
 private:
     void updateLater();
     void updateItem(WidgetItem *item);
-    void insertRow(QGridLayout *layout, int row) const;
-    void removeRow(QGridLayout *layout, int row) const;
-    int gridRow(WidgetItem *item) const;
-    int gridSpan(WidgetItem *item) const;
+    void layoutLater(WidgetItem *parentItem);
+    void layoutChildren(WidgetItem *parentItem);
     void setExpanded(WidgetItem *item, bool expanded);
+    void expandOnRequest(WidgetItem *item, bool expanded);
+    bool hasDeferredChildren(WidgetItem *item) const;
     QToolButton *createButton(QWidget *panret = 0) const;
+    bool isRealized(WidgetItem *item) const;
+    void createWidgets(WidgetItem *item);
+    void createContainer(WidgetItem *item);
+    void destroyWidgets(WidgetItem *item);
+    void populate(WidgetItem *item);
+    void release(WidgetItem *item);
+    void cacheCollapsed(WidgetItem *item);
+    void uncacheCollapsed(WidgetItem *item);
+    void updateCollapsedCount(WidgetItem *item);
+    int widgetCount(WidgetItem *item) const;
 
     QMap<QtBrowserItem *, WidgetItem *> m_indexToItem;
     QMap<WidgetItem *, QtBrowserItem *> m_itemToIndex;
@@ -100,6 +118,18 @@ private:
     QGridLayout *m_mainLayout;
     QList<WidgetItem *> m_children;
     QList<WidgetItem *> m_recreateQueue;
+    QSet<WidgetItem *> m_layoutQueue; // items whose layout needs a rebuild, 0 for the main layout
+    QSet<WidgetItem *> m_changeQueue; // items changed in a batch, refreshed by slotUpdate()
+    bool m_updatePending;
+    QtExpandStateStore m_expandState;
+
+    // Collapsed sections that still hold their child widgets, least
+    // recently collapsed first.
+    QList<WidgetItem *> m_collapsedSections;
+    QHash<WidgetItem *, int> m_collapsedSectionWidgets;
+    int m_collapsedWidgetBudget;
+    int m_collapsedWidgetCount;
+
 };
 
 QToolButton *QtButtonPropertyBrowserPrivate::createButton(QWidget *parent) const
@@ -119,36 +149,11 @@ QToolButton *QtButtonPropertyBrowserPrivate::createButton(QWidget *parent) const
     return button;
 }
 
-int QtButtonPropertyBrowserPrivate::gridRow(WidgetItem *item) const
-{
-    QList<WidgetItem *> siblings;
-    if (item->parent)
-        siblings = item->parent->children;
-    else
-        siblings = m_children;
-
-    int row = 0;
-    QListIterator<WidgetItem *> it(siblings);
-    while (it.hasNext()) {
-        WidgetItem *sibling = it.next();
-        if (sibling == item)
-            return row;
-        row += gridSpan(sibling);
-    }
-    return -1;
-}
-
-int QtButtonPropertyBrowserPrivate::gridSpan(WidgetItem *item) const
-{
-    if (item->container && item->expanded)
-        return 2;
-    return 1;
-}
-
 void QtButtonPropertyBrowserPrivate::init(QWidget *parent)
 {
     m_mainLayout = new QGridLayout();
     parent->setLayout(m_mainLayout);
+    QtTextLayoutItem::installPainter(parent);
     QLayoutItem *item = new QSpacerItem(0, 0,
                 QSizePolicy::Fixed, QSizePolicy::Expanding);
     m_mainLayout->addItem(item, 0, 0);
@@ -167,32 +172,91 @@ void QtButtonPropertyBrowserPrivate::slotEditorDestroyed()
 
 void QtButtonPropertyBrowserPrivate::slotUpdate()
 {
+    m_updatePending = false;
+
     QListIterator<WidgetItem *> itItem(m_recreateQueue);
     while (itItem.hasNext()) {
         WidgetItem *item = itItem.next();
+        if (item->container || item->label || !isRealized(item))
+            continue;
 
         WidgetItem *parent = item->parent;
         QWidget *w = 0;
-        QGridLayout *l = 0;
-        const int oldRow = gridRow(item);
-        if (parent) {
+        if (parent)
             w = parent->container;
-            l = parent->layout;
-        } else {
+        else
             w = q_ptr;
-            l = m_mainLayout;
-        }
 
-        int span = 1;
-        if (!item->widget && !item->widgetLabel)
-            span = 2;
-        item->label = new QLabel(w);
-        item->label->setSizePolicy(QSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed));
-        l->addWidget(item->label, oldRow, 0, 1, span);
+        item->label = new QtTextLayoutItem(w, QSizePolicy::Fixed);
+        m_layoutQueue.insert(parent);
 
         updateItem(item);
     }
     m_recreateQueue.clear();
+
+    QSetIterator<WidgetItem *> itLayout(m_layoutQueue);
+    while (itLayout.hasNext())
+        layoutChildren(itLayout.next());
+    m_layoutQueue.clear();
+
+    QSetIterator<WidgetItem *> itChanged(m_changeQueue);
+    while (itChanged.hasNext())
+        updateItem(itChanged.next());
+    m_changeQueue.clear();
+}
+
+void QtButtonPropertyBrowserPrivate::layoutLater(WidgetItem *parentItem)
+{
+    m_layoutQueue.insert(parentItem);
+    updateLater();
+}
+
+// Rebuilds the grid of parentItem (or of the main layout) from its list of
+// children. Insertions, removals and expansion changes only queue the
+// rebuild, so that inserting many rows costs one pass over the layout
+// instead of one shift per row.
+void QtButtonPropertyBrowserPrivate::layoutChildren(WidgetItem *parentItem)
+{
+    QGridLayout *layout = parentItem ? parentItem->layout : m_mainLayout;
+    if (!layout)
+        return;
+
+    // Only the wrappers of widgets are owned by the layout; painted text
+    // items belong to their WidgetItem and are added again below.
+    QList<QLayoutItem *> spacers;
+    while (QLayoutItem *layoutItem = layout->takeAt(0)) {
+        if (layoutItem->spacerItem())
+            spacers.append(layoutItem);
+        else if (layoutItem->widget())
+            delete layoutItem;
+    }
+
+    int row = 0;
+    QListIterator<WidgetItem *> itChild(parentItem ? parentItem->children : m_children);
+    while (itChild.hasNext()) {
+        WidgetItem *item = itChild.next();
+        int span = 1;
+        if (item->widget)
+            layout->addWidget(item->widget, row, 1);
+        else if (item->widgetLabel)
+            layout->addItem(item->widgetLabel, row, 1);
+        else
+            span = 2;
+        if (item->button)
+            layout->addWidget(item->button, row, 0, 1, span);
+        else if (item->label)
+            layout->addItem(item->label, row, 0, 1, span);
+        row++;
+        if (item->container && item->expanded) {
+            layout->addWidget(item->container, row, 0, 1, 2);
+            item->container->show();
+            row++;
+        }
+    }
+
+    QListIterator<QLayoutItem *> itSpacer(spacers);
+    while (itSpacer.hasNext())
+        layout->addItem(itSpacer.next(), row++, 0);
 }
 
 void QtButtonPropertyBrowserPrivate::setExpanded(WidgetItem *item, bool expanded)
@@ -204,7 +268,6 @@ void QtButtonPropertyBrowserPrivate::setExpanded(WidgetItem *item, bool expanded
         return;
 
     item->expanded = expanded;
-    const int row = gridRow(item);
     WidgetItem *parent = item->parent;
     QGridLayout *l = 0;
     if (parent)
@@ -212,18 +275,219 @@ void QtButtonPropertyBrowserPrivate::setExpanded(WidgetItem *item, bool expanded
     else
         l = m_mainLayout;
 
+    // The container is shown once the layout has placed it.
     if (expanded) {
-        insertRow(l, row + 1);
-        l->addWidget(item->container, row + 1, 0, 1, 2);
-        item->container->show();
+        uncacheCollapsed(item);
+        if (!item->populated)
+            populate(item);
     } else {
         l->removeWidget(item->container);
         item->container->hide();
-        removeRow(l, row + 1);
     }
+    layoutLater(parent);
 
     item->button->setChecked(expanded);
     item->button->setArrowType(expanded ? Qt::UpArrow : Qt::DownArrow);
+
+    if (!expanded)
+        cacheCollapsed(item);
+}
+
+// Expands item on behalf of the user or the application. Deferred
+// subproperties are created here only, never when an expand state is
+// restored.
+void QtButtonPropertyBrowserPrivate::expandOnRequest(WidgetItem *item, bool expanded)
+{
+    if (expanded && hasDeferredChildren(item))
+        q_ptr->createDeferredSubProperties(m_itemToIndex.value(item)->property());
+    setExpanded(item, expanded);
+}
+
+bool QtButtonPropertyBrowserPrivate::hasDeferredChildren(WidgetItem *item) const
+{
+    return q_ptr->hasDeferredSubProperties(m_itemToIndex.value(item)->property());
+}
+
+bool QtButtonPropertyBrowserPrivate::isRealized(WidgetItem *item) const
+{
+    return !item->parent || item->parent->populated;
+}
+
+void QtButtonPropertyBrowserPrivate::createWidgets(WidgetItem *item)
+{
+    QtProperty *property = m_itemToIndex.value(item)->property();
+    QWidget *parentWidget = item->parent ? item->parent->container : q_ptr;
+
+    item->widget = createEditor(property, parentWidget);
+    if (item->widget) {
+        QObject::connect(item->widget, SIGNAL(destroyed()), q_ptr, SLOT(slotEditorDestroyed()));
+        m_widgetToItem[item->widget] = item;
+    } else if (property->hasValue()) {
+        item->widgetLabel = new QtTextLayoutItem(parentWidget, QSizePolicy::Ignored);
+    }
+    const bool expandable = !item->children.isEmpty() || hasDeferredChildren(item);
+    if (!expandable) {
+        item->label = new QtTextLayoutItem(parentWidget, QSizePolicy::Fixed);
+    }
+    layoutLater(item->parent);
+
+    updateItem(item);
+
+    if (expandable)
+        createContainer(item);
+}
+
+void QtButtonPropertyBrowserPrivate::createContainer(WidgetItem *item)
+{
+    QtBrowserItem *index = m_itemToIndex.value(item);
+    const bool expanded = !hasDeferredChildren(item)
+                && (item->expanded || m_expandState.isExpanded(index, false));
+    item->expanded = false;
+
+    QFrame *container = new QFrame();
+    container->setFrameShape(QFrame::Panel);
+    container->setFrameShadow(QFrame::Raised);
+    QtTextLayoutItem::installPainter(container);
+    item->container = container;
+    item->button = createButton();
+    m_buttonToItem[item->button] = item;
+    q_ptr->connect(item->button, SIGNAL(toggled(bool)), q_ptr, SLOT(slotToggled(bool)));
+    item->layout = new QGridLayout();
+    container->setLayout(item->layout);
+    layoutLater(item->parent);
+    updateItem(item);
+
+    if (expanded)
+        setExpanded(item, true);
+}
+
+// Deletes all widgets of item and of its children. The structure and the
+// expanded flags are kept, so that the widgets can be created again.
+void QtButtonPropertyBrowserPrivate::destroyWidgets(WidgetItem *item)
+{
+    if (item->populated)
+        release(item);
+
+    if (item->widget) {
+        m_widgetToItem.remove(item->widget);
+        delete item->widget;
+        item->widget = 0;
+    }
+    delete item->label;
+    item->label = 0;
+    delete item->widgetLabel;
+    item->widgetLabel = 0;
+    if (item->button) {
+        m_buttonToItem.remove(item->button);
+        delete item->button;
+        item->button = 0;
+    }
+    if (item->layout)
+        QtTextLayoutItem::clearLayout(item->layout);
+    delete item->container;
+    item->container = 0;
+    item->layout = 0;
+
+    m_recreateQueue.removeAll(item);
+    m_layoutQueue.remove(item);
+}
+
+void QtButtonPropertyBrowserPrivate::populate(WidgetItem *item)
+{
+    item->populated = true;
+    QListIterator<WidgetItem *> itChild(item->children);
+    while (itChild.hasNext())
+        createWidgets(itChild.next());
+    layoutLater(item);
+}
+
+void QtButtonPropertyBrowserPrivate::release(WidgetItem *item)
+{
+    uncacheCollapsed(item);
+    item->populated = false;
+    QListIterator<WidgetItem *> itChild(item->children);
+    while (itChild.hasNext())
+        destroyWidgets(itChild.next());
+}
+
+int QtButtonPropertyBrowserPrivate::widgetCount(WidgetItem *item) const
+{
+    // Painted names and values are not widgets. Collapsed subsections are
+    // accounted for on their own.
+    int count = 0;
+    QListIterator<WidgetItem *> itChild(item->children);
+    while (itChild.hasNext()) {
+        const WidgetItem *child = itChild.next();
+        count += (child->widget ? 1 : 0) + (child->button ? 1 : 0) + (child->container ? 1 : 0);
+        if (child->populated && child->expanded)
+            count += widgetCount(const_cast<WidgetItem *>(child));
+    }
+    return count;
+}
+
+void QtButtonPropertyBrowserPrivate::cacheCollapsed(WidgetItem *item)
+{
+    if (!item->populated || m_collapsedWidgetBudget < 0)
+        return;
+
+    const int count = widgetCount(item);
+    m_collapsedSections.append(item);
+    m_collapsedSectionWidgets[item] = count;
+    m_collapsedWidgetCount += count;
+
+    while (m_collapsedWidgetCount > m_collapsedWidgetBudget && !m_collapsedSections.isEmpty())
+        release(m_collapsedSections.first());
+}
+
+void QtButtonPropertyBrowserPrivate::uncacheCollapsed(WidgetItem *item)
+{
+    if (!m_collapsedSectionWidgets.contains(item))
+        return;
+    m_collapsedWidgetCount -= m_collapsedSectionWidgets.take(item);
+    m_collapsedSections.removeAll(item);
+}
+
+// Recounts the widgets of the collapsed sections containing item after
+// widgets were created or destroyed below it, and enforces the budget.
+void QtButtonPropertyBrowserPrivate::updateCollapsedCount(WidgetItem *item)
+{
+    if (m_collapsedWidgetBudget < 0)
+        return;
+
+    for (WidgetItem *section = item; section; section = section->parent) {
+        const QHash<WidgetItem *, int>::iterator it = m_collapsedSectionWidgets.find(section);
+        if (it == m_collapsedSectionWidgets.end())
+            continue;
+        const int count = widgetCount(section);
+        m_collapsedWidgetCount += count - it.value();
+        it.value() = count;
+    }
+    while (m_collapsedWidgetCount > m_collapsedWidgetBudget && !m_collapsedSections.isEmpty())
+        release(m_collapsedSections.first());
+}
+
+void QtButtonPropertyBrowserPrivate::setCollapsedWidgetBudget(int budget)
+{
+    if (m_collapsedWidgetBudget == budget)
+        return;
+
+    m_collapsedWidgetBudget = budget;
+    if (budget < 0) {
+        m_collapsedSections.clear();
+        m_collapsedSectionWidgets.clear();
+        m_collapsedWidgetCount = 0;
+        return;
+    }
+
+    // Sections collapsed while there was no budget are not in the cache yet.
+    QMapIterator<WidgetItem *, QtBrowserItem *> it(m_itemToIndex);
+    while (it.hasNext()) {
+        WidgetItem *item = it.next().key();
+        if (item->populated && !item->expanded && !m_collapsedSectionWidgets.contains(item))
+            cacheCollapsed(item);
+    }
+    while (m_collapsedWidgetCount > m_collapsedWidgetBudget && !m_collapsedSections.isEmpty())
+        release(m_collapsedSections.first());
 }
 
 void QtButtonPropertyBrowserPrivate::slotToggled(bool checked)
@@ -232,7 +496,8 @@ void QtButtonPropertyBrowserPrivate::slotToggled(bool checked)
     if (!item)
         return;
 
-    setExpanded(item, checked);
+    expandOnRequest(item, checked);
+    m_expandState.setExpanded(m_itemToIndex.value(item), checked);
 
     if (checked)
         emit q_ptr->expanded(m_itemToIndex.value(item));
@@ -240,8 +505,22 @@ void QtButtonPropertyBrowserPrivate::slotToggled(bool checked)
         emit q_ptr->collapsed(m_itemToIndex.value(item));
 }
 
+void QtButtonPropertyBrowserPrivate::applyExpandState()
+{
+    QMapIterator<QtBrowserItem *, WidgetItem *> it(m_indexToItem);
+    while (it.hasNext()) {
+        it.next();
+        WidgetItem *item = it.value();
+        if (!hasDeferredChildren(item))
+            setExpanded(item, m_expandState.isExpanded(it.key(), item->expanded));
+    }
+}
+
 void QtButtonPropertyBrowserPrivate::updateLater()
 {
+    if (m_updatePending)
+        return;
+    m_updatePending = true;
     QTimer::singleShot(0, q_ptr, SLOT(slotUpdate()));
 }
 
@@ -253,89 +532,39 @@ void QtButtonPropertyBrowserPrivate::propertyInserted(QtBrowserItem *index, QtBr
     WidgetItem *newItem = new WidgetItem();
     newItem->parent = parentItem;
 
-    QGridLayout *layout = 0;
-    QWidget *parentWidget = 0;
-    int row = -1;
     if (!afterItem) {
-        row = 0;
         if (parentItem)
             parentItem->children.insert(0, newItem);
         else
             m_children.insert(0, newItem);
     } else {
-        row = gridRow(afterItem) + gridSpan(afterItem);
         if (parentItem)
             parentItem->children.insert(parentItem->children.indexOf(afterItem) + 1, newItem);
         else
             m_children.insert(m_children.indexOf(afterItem) + 1, newItem);
     }
 
-    if (!parentItem) {
-        layout = m_mainLayout;
-        parentWidget = q_ptr;
-    } else {
-        if (!parentItem->container) {
-            m_recreateQueue.removeAll(parentItem);
-            WidgetItem *grandParent = parentItem->parent;
-            QWidget *w = 0;
-            QGridLayout *l = 0;
-            const int oldRow = gridRow(parentItem);
-            if (grandParent) {
-                w = grandParent->container;
-                l = grandParent->layout;
-            } else {
-                w = q_ptr;
-                l = m_mainLayout;
-            }
-            QFrame *container = new QFrame();
-            container->setFrameShape(QFrame::Panel);
-            container->setFrameShadow(QFrame::Raised);
-            parentItem->container = container;
-            parentItem->button = createButton();
-            m_buttonToItem[parentItem->button] = parentItem;
-            q_ptr->connect(parentItem->button, SIGNAL(toggled(bool)), q_ptr, SLOT(slotToggled(bool)));
-            parentItem->layout = new QGridLayout();
-            container->setLayout(parentItem->layout);
-            if (parentItem->label) {
-                l->removeWidget(parentItem->label);
-                delete parentItem->label;
-                parentItem->label = 0;
-            }
-            int span = 1;
-            if (!parentItem->widget && !parentItem->widgetLabel)
-                span = 2;
-            l->addWidget(parentItem->button, oldRow, 0, 1, span);
-            updateItem(parentItem);
-        }
-        layout = parentItem->layout;
-        parentWidget = parentItem->container;
-    }
-
-    newItem->label = new QLabel(parentWidget);
-    newItem->label->setSizePolicy(QSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed));
-    newItem->widget = createEditor(index->property(), parentWidget);
-    if (newItem->widget) {
-        QObject::connect(newItem->widget, SIGNAL(destroyed()), q_ptr, SLOT(slotEditorDestroyed()));
-        m_widgetToItem[newItem->widget] = newItem;
-    } else if (index->property()->hasValue()) {
-        newItem->widgetLabel = new QLabel(parentWidget);
-        newItem->widgetLabel->setSizePolicy(QSizePolicy(QSizePolicy::Ignored, QSizePolicy::Fixed));
-    }
-
-    insertRow(layout, row);
-    int span = 1;
-    if (newItem->widget)
-        layout->addWidget(newItem->widget, row, 1);
-    else if (newItem->widgetLabel)
-        layout->addWidget(newItem->widgetLabel, row, 1);
-    else
-        span = 2;
-    layout->addWidget(newItem->label, row, 0, span, 1);
-
     m_itemToIndex[newItem] = index;
     m_indexToItem[index] = newItem;
 
-    updateItem(newItem);
+    // Children of a collapsed section get their widgets when it is expanded.
+    if (!parentItem) {
+        createWidgets(newItem);
+    } else if (!isRealized(parentItem)) {
+        return;
+    } else if (!parentItem->container) {
+        m_recreateQueue.removeAll(parentItem);
+        if (parentItem->label) {
+            delete parentItem->label;
+            parentItem->label = 0;
+        }
+        createContainer(parentItem);
+        updateCollapsedCount(parentItem->parent);
+    } else if (parentItem->populated) {
+        createWidgets(newItem);
+        // Rows inserted into a collapsed section count against the budget.
+        updateCollapsedCount(parentItem);
+    }
 }
 
 void QtButtonPropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
@@ -344,117 +573,63 @@ void QtButtonPropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
 
     m_indexToItem.remove(index);
     m_itemToIndex.remove(item);
+    m_expandState.itemRemoved(index);
 
     WidgetItem *parentItem = item->parent;
 
-    const int row = gridRow(item);
-
     if (parentItem)
-        parentItem->children.removeAt(parentItem->children.indexOf(item));
+        parentItem->children.removeAll(item);
     else
-        m_children.removeAt(m_children.indexOf(item));
-
-    const int colSpan = gridSpan(item);
+        m_children.removeAll(item);
 
-    m_buttonToItem.remove(item->button);
+    destroyWidgets(item);
+    uncacheCollapsed(item);
 
-    if (item->widget)
-        delete item->widget;
-    if (item->label)
-        delete item->label;
-    if (item->widgetLabel)
-        delete item->widgetLabel;
-    if (item->button)
-        delete item->button;
-    if (item->container)
-        delete item->container;
-
-    if (!parentItem) {
-        removeRow(m_mainLayout, row);
-        if (colSpan > 1)
-            removeRow(m_mainLayout, row);
-    } else if (parentItem->children.count() != 0) {
-        removeRow(parentItem->layout, row);
-        if (colSpan > 1)
-            removeRow(parentItem->layout, row);
-    } else {
-        const WidgetItem *grandParent = parentItem->parent;
-        QGridLayout *l = 0;
-        if (grandParent) {
-            l = grandParent->layout;
-        } else {
-            l = m_mainLayout;
-        }
-
-        const int parentRow = gridRow(parentItem);
-        const int parentSpan = gridSpan(parentItem);
+    if (parentItem && parentItem->children.count() == 0 && parentItem->container) {
+        WidgetItem *grandParent = parentItem->parent;
 
-        l->removeWidget(parentItem->button);
-        l->removeWidget(parentItem->container);
+        uncacheCollapsed(parentItem);
+        m_buttonToItem.remove(parentItem->button);
         delete parentItem->button;
+        QtTextLayoutItem::clearLayout(parentItem->layout);
         delete parentItem->container;
         parentItem->button = 0;
         parentItem->container = 0;
         parentItem->layout = 0;
+        parentItem->expanded = false;
+        parentItem->populated = false;
+        m_layoutQueue.remove(parentItem);
         if (!m_recreateQueue.contains(parentItem))
             m_recreateQueue.append(parentItem);
-        if (parentSpan > 1)
-            removeRow(l, parentRow + 1);
-
-        updateLater();
+        layoutLater(grandParent);
+        updateCollapsedCount(grandParent);
+    } else {
+        layoutLater(parentItem);
+        updateCollapsedCount(parentItem);
     }
-    m_recreateQueue.removeAll(item);
+    m_changeQueue.remove(item);
 
     delete item;
 }
 
-void QtButtonPropertyBrowserPrivate::insertRow(QGridLayout *layout, int row) const
+void QtButtonPropertyBrowserPrivate::propertyChanged(QtBrowserItem *index)
 {
-    QMap<QLayoutItem *, QRect> itemToPos;
-    int idx = 0;
-    while (idx < layout->count()) {
-        int r, c, rs, cs;
-        layout->getItemPosition(idx, &r, &c, &rs, &cs);
-        if (r >= row) {
-            itemToPos[layout->takeAt(idx)] = QRect(r + 1, c, rs, cs);
-        } else {
-            idx++;
-        }
-    }
+    WidgetItem *item = m_indexToItem.value(index);
+    m_expandState.itemChanged(index);
 
-    const QMap<QLayoutItem *, QRect>::ConstIterator icend =  itemToPos.constEnd();
-    for(QMap<QLayoutItem *, QRect>::ConstIterator it = itemToPos.constBegin(); it != icend; ++it) {
-        const QRect r = it.value();
-        layout->addItem(it.key(), r.x(), r.y(), r.width(), r.height());
-    }
+    updateItem(item);
 }
 
-void QtButtonPropertyBrowserPrivate::removeRow(QGridLayout *layout, int row) const
+// Items changed in a batch are refreshed together on the next update pass.
+void QtButtonPropertyBrowserPrivate::propertiesChanged(const QList<QtBrowserItem *> &indexes)
 {
-    QMap<QLayoutItem *, QRect> itemToPos;
-    int idx = 0;
-    while (idx < layout->count()) {
-        int r, c, rs, cs;
-        layout->getItemPosition(idx, &r, &c, &rs, &cs);
-        if (r > row) {
-            itemToPos[layout->takeAt(idx)] = QRect(r - 1, c, rs, cs);
-        } else {
-            idx++;
-        }
+    QListIterator<QtBrowserItem *> itIndex(indexes);
+    while (itIndex.hasNext()) {
+        QtBrowserItem *index = itIndex.next();
+        m_expandState.itemChanged(index);
+        m_changeQueue.insert(m_indexToItem.value(index));
     }
-
-    const QMap<QLayoutItem *, QRect>::ConstIterator icend =  itemToPos.constEnd();
-    for(QMap<QLayoutItem *, QRect>::ConstIterator it = itemToPos.constBegin(); it != icend; ++it) {
-        const QRect r = it.value();
-        layout->addItem(it.key(), r.x(), r.y(), r.width(), r.height());
-    }
-}
-
-void QtButtonPropertyBrowserPrivate::propertyChanged(QtBrowserItem *index)
-{
-    WidgetItem *item = m_indexToItem.value(index);
-
-    updateItem(item);
+    updateLater();
 }
 
 void QtButtonPropertyBrowserPrivate::updateItem(WidgetItem *item)
@@ -471,9 +646,7 @@ void QtButtonPropertyBrowserPrivate::updateItem(WidgetItem *item)
         item->button->setEnabled(property->isEnabled());
     }
     if (item->label) {
-        QFont font = item->label->font();
-        font.setUnderline(property->isModified());
-        item->label->setFont(font);
+        item->label->setUnderline(property->isModified());
         item->label->setText(property->propertyName());
         item->label->setToolTip(property->toolTip());
         item->label->setStatusTip(property->statusTip());
@@ -481,9 +654,6 @@ void QtButtonPropertyBrowserPrivate::updateItem(WidgetItem *item)
         item->label->setEnabled(property->isEnabled());
     }
     if (item->widgetLabel) {
-        QFont font = item->widgetLabel->font();
-        font.setUnderline(false);
-        item->widgetLabel->setFont(font);
         item->widgetLabel->setText(property->valueText());
         item->widgetLabel->setToolTip(property->valueText());
         item->widgetLabel->setEnabled(property->isEnabled());
@@ -517,6 +687,10 @@ void QtButtonPropertyBrowserPrivate::updateItem(WidgetItem *item)
 
     \image qtbuttonpropertybrowser.png
 
+    Subproperties that a manager defers are created when the user
+    expands their parent property. Such a property starts collapsed,
+    whatever its stored expand state.
+
     Use the QtAbstractPropertyBrowser API to add, insert and remove
     properties from an instance of the QtButtonPropertyBrowser
     class. The properties themselves are created and managed by
@@ -551,6 +725,7 @@ QtButtonPropertyBrowser::QtButtonPropertyBrowser(QWidget *parent)
     d_ptr->q_ptr = this;
 
     d_ptr->init(this);
+    setDeferSubProperties(true);
 }
 
 /*!
@@ -565,9 +740,20 @@ QtButtonPropertyBrowser::QtButtonPropertyBrowser(QWidget *parent)
 */
 QtButtonPropertyBrowser::~QtButtonPropertyBrowser()
 {
-    const QMap<QtButtonPropertyBrowserPrivate::WidgetItem *, QtBrowserItem *>::ConstIterator icend = d_ptr->m_itemToIndex.constEnd();
-    for (QMap<QtButtonPropertyBrowserPrivate::WidgetItem *, QtBrowserItem *>::ConstIterator  it =  d_ptr->m_itemToIndex.constBegin(); it != icend; ++it)
+    // The text items belong to the widget items. Take them out of the
+    // layouts first, so that deleting the hosts does not delete them again.
+    typedef QMap<QtButtonPropertyBrowserPrivate::WidgetItem *, QtBrowserItem *> ItemToIndexMap;
+    const ItemToIndexMap::ConstIterator icend = d_ptr->m_itemToIndex.constEnd();
+    QtTextLayoutItem::clearLayout(d_ptr->m_mainLayout);
+    for (ItemToIndexMap::ConstIterator it = d_ptr->m_itemToIndex.constBegin(); it != icend; ++it) {
+        if (it.key()->layout)
+            QtTextLayoutItem::clearLayout(it.key()->layout);
+    }
+    for (ItemToIndexMap::ConstIterator it = d_ptr->m_itemToIndex.constBegin(); it != icend; ++it) {
+        delete it.key()->label;
+        delete it.key()->widgetLabel;
         delete it.key();
+    }
     delete d_ptr;
 }
 
@@ -595,6 +781,14 @@ void QtButtonPropertyBrowser::itemChanged(QtBrowserItem *item)
     d_ptr->propertyChanged(item);
 }
 
+/*!
+    \reimp
+*/
+void QtButtonPropertyBrowser::itemsChanged(const QList<QtBrowserItem *> &items)
+{
+    d_ptr->propertiesChanged(items);
+}
+
 /*!
     Sets the \a item to either collapse or expanded, depending on the value of \a expanded.
 
@@ -604,8 +798,10 @@ void QtButtonPropertyBrowser::itemChanged(QtBrowserItem *item)
 void QtButtonPropertyBrowser::setExpanded(QtBrowserItem *item, bool expanded)
 {
     QtButtonPropertyBrowserPrivate::WidgetItem *itm = d_ptr->m_indexToItem.value(item);
-    if (itm)
-        d_ptr->setExpanded(itm, expanded);
+    if (itm) {
+        d_ptr->expandOnRequest(itm, expanded);
+        d_ptr->m_expandState.setExpanded(item, expanded);
+    }
 }
 
 /*!
@@ -622,6 +818,87 @@ bool QtButtonPropertyBrowser::isExpanded(QtBrowserItem *item) const
     return false;
 }
 
+/*!
+    \property QtButtonPropertyBrowser::collapsedWidgetBudget
+    \brief the number of widgets collapsed sections may keep alive.
+
+    The widgets of a section are created the first time it is
+    expanded. When the section is collapsed its widgets are hidden and
+    kept, so that expanding it again is cheap. Once the widgets kept
+    by all collapsed sections exceed this budget, the sections
+    collapsed longest ago release their widgets; they are created
+    again when the section is expanded.
+
+    A budget of 0 releases the widgets of a section as soon as it is
+    collapsed. The default of -1 never releases them.
+*/
+
+int QtButtonPropertyBrowser::collapsedWidgetBudget() const
+{
+    return d_ptr->m_collapsedWidgetBudget;
+}
+
+void QtButtonPropertyBrowser::setCollapsedWidgetBudget(int budget)
+{
+    d_ptr->setCollapsedWidgetBudget(budget);
+}
+
+/*!
+    Returns the path under which the expanded state of \a item is stored.
+
+    The path is made of the property ids of the item and all its
+    ancestors, separated by '/'. Properties without an id contribute
+    their name instead.
+
+    \sa expandState()
+*/
+
+QString QtButtonPropertyBrowser::itemPath(QtBrowserItem *item) const
+{
+    return d_ptr->m_expandState.itemPath(item);
+}
+
+/*!
+    Returns the expanded state of all items the browser has seen
+    expanded or collapsed, keyed by item path.
+
+    When a property is removed and inserted again, its item is
+    restored to the state stored for its path. Items without a stored
+    state are collapsed.
+
+    \sa setExpandState(), clearExpandState(), itemPath()
+*/
+
+QHash<QString, bool> QtButtonPropertyBrowser::expandState() const
+{
+    return d_ptr->m_expandState.state();
+}
+
+/*!
+    Replaces the stored expanded state with \a state and applies it to
+    the items currently shown in the browser.
+
+    \sa expandState()
+*/
+
+void QtButtonPropertyBrowser::setExpandState(const QHash<QString, bool> &state)
+{
+    d_ptr->m_expandState.setState(state);
+    d_ptr->applyExpandState();
+}
+
+/*!
+    Forgets the stored expanded state. Items currently shown in the
+    browser are not changed.
+
+    \sa expandState()
+*/
+
+void QtButtonPropertyBrowser::clearExpandState()
+{
+    d_ptr->m_expandState.clear();
+}
+
 #if QT_VERSION >= 0x040400
 QT_END_NAMESPACE
 #endif
@@ -42,6 +42,7 @@
 #define QTBUTTONPROPERTYBROWSER_H
 
 #include "qtpropertybrowser.h"
+#include <QtCore/QHash>
 
 #if QT_VERSION >= 0x040400
 QT_BEGIN_NAMESPACE
@@ -52,6 +53,7 @@ class QtButtonPropertyBrowserPrivate;
 class QT_QTPROPERTYBROWSER_EXPORT QtButtonPropertyBrowser : public QtAbstractPropertyBrowser
 {
     Q_OBJECT
+    Q_PROPERTY(int collapsedWidgetBudget READ collapsedWidgetBudget WRITE setCollapsedWidgetBudget)
 public:
 
     QtButtonPropertyBrowser(QWidget *parent = 0);
@@ -60,6 +62,14 @@ public:
     void setExpanded(QtBrowserItem *item, bool expanded);
     bool isExpanded(QtBrowserItem *item) const;
 
+    int collapsedWidgetBudget() const;
+    void setCollapsedWidgetBudget(int budget);
+
+    QString itemPath(QtBrowserItem *item) const;
+    QHash<QString, bool> expandState() const;
+    void setExpandState(const QHash<QString, bool> &state);
+    void clearExpandState();
+
 Q_SIGNALS:
 
     void collapsed(QtBrowserItem *item);
@@ -69,6 +79,7 @@ protected:
     virtual void itemInserted(QtBrowserItem *item, QtBrowserItem *afterItem);
     virtual void itemRemoved(QtBrowserItem *item);
     virtual void itemChanged(QtBrowserItem *item);
+    virtual void itemsChanged(const QList<QtBrowserItem *> &items);
 
 private:
 
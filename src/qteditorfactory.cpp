@@ -57,7 +57,11 @@
 #include <QSpacerItem>
 #include <QStyleOption>
 #include <QPainter>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTimer>
+#include <QRegularExpressionValidator>
 
 #if defined(Q_CC_MSVC)
 #    pragma warning(disable: 4786) /* MS VS 6: truncating debug info after 255 characters */
@@ -89,24 +93,52 @@ public:
 
     typedef QList<Editor *> EditorList;
     typedef QMap<QtProperty *, EditorList> PropertyToEditorListMap;
-    typedef QMap<Editor *, QtProperty *> EditorToPropertyMap;
+    typedef QHash<Editor *, QtProperty *> EditorToPropertyMap;
+
+    // Maximum number of released editors a factory keeps for reuse.
+    enum { MaxIdleEditors = 32 };
 
     Editor *createEditor(QtProperty *property, QWidget *parent);
+    Editor *takeIdleEditor(QWidget *parent);
     void initializeEditor(QtProperty *property, Editor *e);
+    QtProperty *propertyForEditor(QObject *object) const;
+    bool releaseEditor(QWidget *widget);
+    void deleteEditors();
     void slotEditorDestroyed(QObject *object);
 
     PropertyToEditorListMap  m_createdEditors;
     EditorToPropertyMap m_editorToProperty;
+    QList<Editor *> m_idleEditors;
+private:
+    void detachEditor(typename EditorToPropertyMap::iterator itEditor);
 };
 
 template <class Editor>
 Editor *EditorFactoryPrivate<Editor>::createEditor(QtProperty *property, QWidget *parent)
 {
-    Editor *editor = new Editor(parent);
+    Editor *editor = takeIdleEditor(parent);
+    if (!editor)
+        editor = new Editor(parent);
     initializeEditor(property, editor);
     return editor;
 }
 
+// Returns a released editor reparented to parent, or 0 if there is none. Its
+// signals are still connected to the factory, so the caller must block them
+// while it sets the editor up for the new property.
+template <class Editor>
+Editor *EditorFactoryPrivate<Editor>::takeIdleEditor(QWidget *parent)
+{
+    if (m_idleEditors.isEmpty())
+        return 0;
+    Editor *editor = m_idleEditors.takeLast();
+    editor->setParent(parent);
+    // The editor was hidden when it was released; a visible parent shows it
+    // right away, a hidden one together with itself.
+    editor->show();
+    return editor;
+}
+
 template <class Editor>
 void EditorFactoryPrivate<Editor>::initializeEditor(QtProperty *property, Editor *editor)
 {
@@ -117,42 +149,318 @@ void EditorFactoryPrivate<Editor>::initializeEditor(QtProperty *property, Editor
     m_editorToProperty.insert(editor, property);
 }
 
+// Returns the property edited by object (usually the sender of an editor
+// signal), or 0 if it is not one of our editors. The pointer is only used as
+// a hash key, so this is safe to call while object is being destroyed.
+template <class Editor>
+QtProperty *EditorFactoryPrivate<Editor>::propertyForEditor(QObject *object) const
+{
+    return m_editorToProperty.value(static_cast<Editor *>(object), 0);
+}
+
+template <class Editor>
+void EditorFactoryPrivate<Editor>::detachEditor(typename EditorToPropertyMap::iterator itEditor)
+{
+    Editor *editor = itEditor.key();
+    QtProperty *property = itEditor.value();
+    const typename PropertyToEditorListMap::iterator pit = m_createdEditors.find(property);
+    if (pit != m_createdEditors.end()) {
+        pit.value().removeAll(editor);
+        if (pit.value().empty())
+            m_createdEditors.erase(pit);
+    }
+    m_editorToProperty.erase(itEditor);
+}
+
+// Detaches widget from its property and keeps it for reuse, hidden and without
+// a parent so that it does not hold on to the old view. Returns false if
+// widget is not one of our editors or the pool is full; the caller then
+// disposes of it.
+template <class Editor>
+bool EditorFactoryPrivate<Editor>::releaseEditor(QWidget *widget)
+{
+    const typename EditorToPropertyMap::iterator itEditor = m_editorToProperty.find(static_cast<Editor *>(widget));
+    if (itEditor == m_editorToProperty.end())
+        return false;
+    Editor *editor = itEditor.key();
+    detachEditor(itEditor);
+    if (m_idleEditors.count() >= MaxIdleEditors)
+        return false;
+    editor->hide();
+    editor->setParent(0);
+    m_idleEditors.append(editor);
+    return true;
+}
+
+// Deletes all editors, including the idle ones. Each deletion removes the
+// editor from our maps through slotEditorDestroyed().
+template <class Editor>
+void EditorFactoryPrivate<Editor>::deleteEditors()
+{
+    const QList<Editor *> editors = m_editorToProperty.keys() + m_idleEditors;
+    m_idleEditors.clear();
+    qDeleteAll(editors);
+}
+
 template <class Editor>
 void EditorFactoryPrivate<Editor>::slotEditorDestroyed(QObject *object)
 {
-    const typename EditorToPropertyMap::iterator ecend = m_editorToProperty.end();
-    for (typename EditorToPropertyMap::iterator itEditor = m_editorToProperty.begin(); itEditor !=  ecend; ++itEditor) {
-        if (itEditor.key() == object) {
-            Editor *editor = itEditor.key();
-            QtProperty *property = itEditor.value();
-            const typename PropertyToEditorListMap::iterator pit = m_createdEditors.find(property);
-            if (pit != m_createdEditors.end()) {
-                pit.value().removeAll(editor);
-                if (pit.value().empty())
-                    m_createdEditors.erase(pit);
-            }
-            m_editorToProperty.erase(itEditor);
+    Editor *editor = static_cast<Editor *>(object);
+    const typename EditorToPropertyMap::iterator itEditor = m_editorToProperty.find(editor);
+    if (itEditor != m_editorToProperty.end())
+        detachEditor(itEditor);
+    else
+        m_idleEditors.removeOne(editor);
+}
+
+// Connects the value signals of adapter to the slotAdaptedValueChanged() and
+// slotAdaptedValuesChanged() slots of factory, which update the editors
+// created by createAdaptedEditor().
+static void connectAdapterValues(QtPropertyEditorAdapter *adapter, QObject *factory)
+{
+    QObject::connect(adapter, SIGNAL(valueChanged(QtProperty *)),
+                factory, SLOT(slotAdaptedValueChanged(QtProperty *)), Qt::UniqueConnection);
+    QObject::connect(adapter, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                factory, SLOT(slotAdaptedValuesChanged(QList<QtProperty *>)), Qt::UniqueConnection);
+}
+
+// ---------- IntEditorFactoryPrivate :
+// Base class for the private classes of the integer factories whose editors report
+// values continuously. Applies the factory's commit policy to the edited values.
+
+template <class Editor>
+class IntEditorFactoryPrivate : public EditorFactoryPrivate<Editor>
+{
+public:
+    IntEditorFactoryPrivate();
+
+    void initializeCommitTimer(QObject *factory);
+    void setCommitPolicy(QtAbstractEditorFactoryBase::CommitPolicy policy);
+    void setValue(QtProperty *property, int value, bool editing);
+    void writeValue(QtProperty *property, int value);
+    void commitPendingValue(QtProperty *property);
+    void commitPendingValues();
+    void removePendingValues(QtIntPropertyManager *manager);
+    bool releaseEditor(QWidget *widget);
+    void slotCommitPendingValues();
+    void slotPropertyDestroyed(QtProperty *property);
+    void slotEditorDestroyed(QObject *object);
+
+    QtAbstractEditorFactoryBase::CommitPolicy m_commitPolicy;
+    QTimer *m_commitTimer;
+    QHash<QtProperty *, int> m_pendingValues;
+};
+
+template <class Editor>
+IntEditorFactoryPrivate<Editor>::IntEditorFactoryPrivate()
+    : m_commitPolicy(QtAbstractEditorFactoryBase::ImmediateCommit),
+    m_commitTimer(0)
+{
+}
+
+template <class Editor>
+void IntEditorFactoryPrivate<Editor>::initializeCommitTimer(QObject *factory)
+{
+    m_commitTimer = new QTimer(factory);
+    m_commitTimer->setInterval(50);
+    m_commitTimer->setSingleShot(true);
+    QObject::connect(m_commitTimer, SIGNAL(timeout()), factory, SLOT(slotCommitPendingValues()));
+}
+
+template <class Editor>
+void IntEditorFactoryPrivate<Editor>::setCommitPolicy(QtAbstractEditorFactoryBase::CommitPolicy policy)
+{
+    if (m_commitPolicy == policy)
+        return;
+    m_commitPolicy = policy;
+    m_commitTimer->stop();
+    commitPendingValues();
+}
+
+// Writes value to the manager, or keeps it pending if the commit policy says so.
+// editing is true while the user is still dragging or typing in the editor.
+template <class Editor>
+void IntEditorFactoryPrivate<Editor>::setValue(QtProperty *property, int value, bool editing)
+{
+    switch (m_commitPolicy) {
+    case QtAbstractEditorFactoryBase::ThrottledCommit:
+        if (m_commitTimer->isActive()) {
+            m_pendingValues[property] = value;
+            return;
+        }
+        m_commitTimer->start();
+        break;
+    case QtAbstractEditorFactoryBase::CommitOnRelease:
+        if (editing) {
+            m_pendingValues[property] = value;
             return;
         }
+        break;
+    default:
+        break;
+    }
+    m_pendingValues.remove(property);
+    writeValue(property, value);
+}
+
+// Writes value through the property's manager, or through the adapter of
+// its manager if the editor was created by createAdaptedEditor().
+template <class Editor>
+void IntEditorFactoryPrivate<Editor>::writeValue(QtProperty *property, int value)
+{
+    if (QtIntPropertyManager *manager = qobject_cast<QtIntPropertyManager *>(property->propertyManager()))
+        manager->setValue(property, value);
+    else if (QtPropertyEditorAdapter *adapter = QtPropertyEditorAdapter::adapter(property))
+        adapter->setValue(property, QVariant(value));
+}
+
+template <class Editor>
+void IntEditorFactoryPrivate<Editor>::commitPendingValue(QtProperty *property)
+{
+    const QHash<QtProperty *, int>::iterator it = m_pendingValues.find(property);
+    if (it == m_pendingValues.end())
+        return;
+    const int value = it.value();
+    m_pendingValues.erase(it);
+    writeValue(property, value);
+}
+
+template <class Editor>
+void IntEditorFactoryPrivate<Editor>::commitPendingValues()
+{
+    const QHash<QtProperty *, int> pendingValues = m_pendingValues;
+    m_pendingValues.clear();
+    QHashIterator<QtProperty *, int> it(pendingValues);
+    while (it.hasNext()) {
+        it.next();
+        writeValue(it.key(), it.value());
+    }
+}
+
+template <class Editor>
+void IntEditorFactoryPrivate<Editor>::removePendingValues(QtIntPropertyManager *manager)
+{
+    QMutableHashIterator<QtProperty *, int> it(m_pendingValues);
+    while (it.hasNext()) {
+        if (it.next().key()->propertyManager() == manager)
+            it.remove();
     }
 }
 
+// An editor that is released or destroyed while the user is still editing
+// never reports the end of the edit, so its last value is committed here.
+template <class Editor>
+bool IntEditorFactoryPrivate<Editor>::releaseEditor(QWidget *widget)
+{
+    if (QtProperty *property = this->propertyForEditor(widget))
+        commitPendingValue(property);
+    return EditorFactoryPrivate<Editor>::releaseEditor(widget);
+}
+
+template <class Editor>
+void IntEditorFactoryPrivate<Editor>::slotCommitPendingValues()
+{
+    if (m_pendingValues.isEmpty())
+        return;
+    commitPendingValues();
+    // Keep the rate bounded: the next change must wait for another interval.
+    if (m_commitPolicy == QtAbstractEditorFactoryBase::ThrottledCommit)
+        m_commitTimer->start();
+}
+
+template <class Editor>
+void IntEditorFactoryPrivate<Editor>::slotPropertyDestroyed(QtProperty *property)
+{
+    m_pendingValues.remove(property);
+}
+
+template <class Editor>
+void IntEditorFactoryPrivate<Editor>::slotEditorDestroyed(QObject *object)
+{
+    QtProperty *property = this->propertyForEditor(object);
+    EditorFactoryPrivate<Editor>::slotEditorDestroyed(object);
+    if (property)
+        commitPendingValue(property);
+}
+
 // ------------ QtSpinBoxFactory
 
-class QtSpinBoxFactoryPrivate : public EditorFactoryPrivate<QSpinBox>
+class QtSpinBoxFactoryPrivate : public IntEditorFactoryPrivate<QSpinBox>
 {
     QtSpinBoxFactory *q_ptr;
     Q_DECLARE_PUBLIC(QtSpinBoxFactory)
 public:
 
     void slotPropertyChanged(QtProperty *property, int value);
+    void slotPropertiesChanged(const QList<QtProperty *> &properties);
     void slotRangeChanged(QtProperty *property, int min, int max);
     void slotSingleStepChanged(QtProperty *property, int step);
     void slotSetValue(int value);
+    void slotEditorReleased();
+    void slotAdaptedValueChanged(QtProperty *property);
+    void slotAdaptedValuesChanged(const QList<QtProperty *> &properties);
+    void slotAdaptedAttributeChanged(QtProperty *property);
+
+    QSpinBox *createSpinBox(QtProperty *property, QWidget *parent);
+    void setupAdaptedEditor(QSpinBox *editor, const QtPropertyEditorAdapter *adapter,
+                const QtProperty *property);
 };
 
+// Creates or reuses an editor for property; the caller sets it up.
+QSpinBox *QtSpinBoxFactoryPrivate::createSpinBox(QtProperty *property, QWidget *parent)
+{
+    QSpinBox *editor = createEditor(property, parent);
+    editor->setKeyboardTracking(false);
+    QObject::connect(editor, SIGNAL(valueChanged(int)), q_ptr, SLOT(slotSetValue(int)), Qt::UniqueConnection);
+    QObject::connect(editor, SIGNAL(editingFinished()), q_ptr, SLOT(slotEditorReleased()), Qt::UniqueConnection);
+    QObject::connect(editor, SIGNAL(destroyed(QObject *)),
+                q_ptr, SLOT(slotEditorDestroyed(QObject *)), Qt::UniqueConnection);
+    return editor;
+}
+
+void QtSpinBoxFactoryPrivate::setupAdaptedEditor(QSpinBox *editor, const QtPropertyEditorAdapter *adapter,
+            const QtProperty *property)
+{
+    editor->blockSignals(true);
+    editor->setSingleStep(adapter->attributeValue(property, QLatin1String("singleStep")).toInt());
+    editor->setRange(adapter->attributeValue(property, QLatin1String("minimum")).toInt(),
+                adapter->attributeValue(property, QLatin1String("maximum")).toInt());
+    editor->setValue(adapter->value(property).toInt());
+    editor->blockSignals(false);
+}
+
+void QtSpinBoxFactoryPrivate::slotAdaptedValueChanged(QtProperty *property)
+{
+    if (m_createdEditors.contains(property))
+        slotPropertyChanged(property, static_cast<QtPropertyEditorAdapter *>(q_ptr->sender())->value(property).toInt());
+}
+
+void QtSpinBoxFactoryPrivate::slotAdaptedValuesChanged(const QList<QtProperty *> &properties)
+{
+    const QtPropertyEditorAdapter *adapter = static_cast<QtPropertyEditorAdapter *>(q_ptr->sender());
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext()) {
+        QtProperty *property = itProperty.next();
+        if (m_createdEditors.contains(property))
+            slotPropertyChanged(property, adapter->value(property).toInt());
+    }
+}
+
+void QtSpinBoxFactoryPrivate::slotAdaptedAttributeChanged(QtProperty *property)
+{
+    if (!m_createdEditors.contains(property))
+        return;
+    const QtPropertyEditorAdapter *adapter = static_cast<QtPropertyEditorAdapter *>(q_ptr->sender());
+    QListIterator<QSpinBox *> itEditor(m_createdEditors[property]);
+    while (itEditor.hasNext())
+        setupAdaptedEditor(itEditor.next(), adapter, property);
+}
+
 void QtSpinBoxFactoryPrivate::slotPropertyChanged(QtProperty *property, int value)
 {
+    // The property changed after the pending value was edited, so the
+    // pending value is outdated.
+    m_pendingValues.remove(property);
     if (!m_createdEditors.contains(property))
         return;
     QListIterator<QSpinBox *> itEditor(m_createdEditors[property]);
@@ -166,6 +474,18 @@ void QtSpinBoxFactoryPrivate::slotPropertyChanged(QtProperty *property, int valu
     }
 }
 
+void QtSpinBoxFactoryPrivate::slotPropertiesChanged(const QList<QtProperty *> &properties)
+{
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext()) {
+        QtProperty *property = itProperty.next();
+        if (!m_createdEditors.contains(property))
+            continue;
+        if (QtIntPropertyManager *manager = q_ptr->propertyManager(property))
+            slotPropertyChanged(property, manager->value(property));
+    }
+}
+
 void QtSpinBoxFactoryPrivate::slotRangeChanged(QtProperty *property, int min, int max)
 {
     if (!m_createdEditors.contains(property))
@@ -200,18 +520,21 @@ void QtSpinBoxFactoryPrivate::slotSingleStepChanged(QtProperty *property, int st
 
 void QtSpinBoxFactoryPrivate::slotSetValue(int value)
 {
-    QObject *object = q_ptr->sender();
-    const QMap<QSpinBox *, QtProperty *>::ConstIterator  ecend = m_editorToProperty.constEnd();
-    for (QMap<QSpinBox *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor !=  ecend; ++itEditor) {
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtIntPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
-    }
+    QSpinBox *editor = static_cast<QSpinBox *>(q_ptr->sender());
+    QtProperty *property = propertyForEditor(editor);
+    if (!property)
+        return;
+    // The edit lasts until editingFinished(). A spin box takes the focus
+    // when it is clicked or wheeled, and the browsers focus their editors,
+    // so this holds back typed, stepped and wheeled values alike; only a
+    // value that changes without the focus is written at once.
+    setValue(property, value, editor->hasFocus());
+}
+
+void QtSpinBoxFactoryPrivate::slotEditorReleased()
+{
+    if (QtProperty *property = propertyForEditor(q_ptr->sender()))
+        commitPendingValue(property);
 }
 
 /*!
@@ -231,6 +554,7 @@ QtSpinBoxFactory::QtSpinBoxFactory(QObject *parent)
 {
     d_ptr = new QtSpinBoxFactoryPrivate();
     d_ptr->q_ptr = this;
+    d_ptr->initializeCommitTimer(this);
 
 }
 
@@ -239,10 +563,62 @@ QtSpinBoxFactory::QtSpinBoxFactory(QObject *parent)
 */
 QtSpinBoxFactory::~QtSpinBoxFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
+/*!
+    Returns the policy used to write values from the spin boxes to the
+    property manager.
+
+    \sa setCommitPolicy()
+*/
+QtAbstractEditorFactoryBase::CommitPolicy QtSpinBoxFactory::commitPolicy() const
+{
+    return d_ptr->m_commitPolicy;
+}
+
+/*!
+    Sets the commit \a policy of this factory. By default every change is
+    committed immediately.
+
+    With CommitOnRelease, values are written when the spin box emits
+    editingFinished(), i.e. when return is pressed or the spin box loses
+    the focus. Since the spin box has the focus while it is used, this
+    holds back values entered with the keyboard, the arrows and the
+    mouse wheel alike. Values that are pending when the policy changes,
+    or when the spin box is released or destroyed, are written at once.
+    A pending value is dropped when the property is changed otherwise.
+
+    \sa commitPolicy(), setCommitInterval()
+*/
+void QtSpinBoxFactory::setCommitPolicy(CommitPolicy policy)
+{
+    d_ptr->setCommitPolicy(policy);
+}
+
+/*!
+    Returns the minimum interval in milliseconds between two commits when
+    the commit policy is ThrottledCommit.
+
+    \sa setCommitInterval()
+*/
+int QtSpinBoxFactory::commitInterval() const
+{
+    return d_ptr->m_commitTimer->interval();
+}
+
+/*!
+    Sets the minimum interval between two throttled commits to \a msec
+    milliseconds. The default is 50 milliseconds.
+
+    \sa commitInterval(), setCommitPolicy()
+*/
+void QtSpinBoxFactory::setCommitInterval(int msec)
+{
+    d_ptr->m_commitTimer->setInterval(msec);
+}
+
 /*!
     \internal
 
@@ -250,14 +626,30 @@ QtSpinBoxFactory::~QtSpinBoxFactory()
 */
 void QtSpinBoxFactory::connectPropertyManager(QtIntPropertyManager *manager)
 {
+    connect(manager, SIGNAL(propertyDestroyed(QtProperty *)),
+                this, SLOT(slotPropertyDestroyed(QtProperty *)));
     connect(manager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotPropertyChanged(QtProperty *, int)));
+    connect(manager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotPropertiesChanged(QList<QtProperty *>)));
     connect(manager, SIGNAL(rangeChanged(QtProperty *, int, int)),
                 this, SLOT(slotRangeChanged(QtProperty *, int, int)));
     connect(manager, SIGNAL(singleStepChanged(QtProperty *, int)),
                 this, SLOT(slotSingleStepChanged(QtProperty *, int)));
 }
 
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class. Keeps the
+    released \a editor for reuse by createEditor().
+*/
+void QtSpinBoxFactory::releaseEditor(QWidget *editor)
+{
+    if (!d_ptr->releaseEditor(editor))
+        QtAbstractEditorFactoryBase::releaseEditor(editor);
+}
+
 /*!
     \internal
 
@@ -266,15 +658,28 @@ void QtSpinBoxFactory::connectPropertyManager(QtIntPropertyManager *manager)
 QWidget *QtSpinBoxFactory::createEditor(QtIntPropertyManager *manager, QtProperty *property,
         QWidget *parent)
 {
-    QSpinBox *editor = d_ptr->createEditor(property, parent);
+    QSpinBox *editor = d_ptr->createSpinBox(property, parent);
+    editor->blockSignals(true);
     editor->setSingleStep(manager->singleStep(property));
     editor->setRange(manager->minimum(property), manager->maximum(property));
     editor->setValue(manager->value(property));
-    editor->setKeyboardTracking(false);
+    editor->blockSignals(false);
+    return editor;
+}
 
-    connect(editor, SIGNAL(valueChanged(int)), this, SLOT(slotSetValue(int)));
-    connect(editor, SIGNAL(destroyed(QObject *)),
-                this, SLOT(slotEditorDestroyed(QObject *)));
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class.
+*/
+QWidget *QtSpinBoxFactory::createAdaptedEditor(QtPropertyEditorAdapter *adapter, QtProperty *property,
+        QWidget *parent)
+{
+    connectAdapterValues(adapter, this);
+    connect(adapter, SIGNAL(attributeChanged(QtProperty *)),
+                this, SLOT(slotAdaptedAttributeChanged(QtProperty *)), Qt::UniqueConnection);
+    QSpinBox *editor = d_ptr->createSpinBox(property, parent);
+    d_ptr->setupAdaptedEditor(editor, adapter, property);
     return editor;
 }
 
@@ -285,8 +690,13 @@ QWidget *QtSpinBoxFactory::createEditor(QtIntPropertyManager *manager, QtPropert
 */
 void QtSpinBoxFactory::disconnectPropertyManager(QtIntPropertyManager *manager)
 {
+    d_ptr->removePendingValues(manager);
+    disconnect(manager, SIGNAL(propertyDestroyed(QtProperty *)),
+                this, SLOT(slotPropertyDestroyed(QtProperty *)));
     disconnect(manager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotPropertyChanged(QtProperty *, int)));
+    disconnect(manager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotPropertiesChanged(QList<QtProperty *>)));
     disconnect(manager, SIGNAL(rangeChanged(QtProperty *, int, int)),
                 this, SLOT(slotRangeChanged(QtProperty *, int, int)));
     disconnect(manager, SIGNAL(singleStepChanged(QtProperty *, int)),
@@ -295,19 +705,24 @@ void QtSpinBoxFactory::disconnectPropertyManager(QtIntPropertyManager *manager)
 
 // QtSliderFactory
 
-class QtSliderFactoryPrivate : public EditorFactoryPrivate<QSlider>
+class QtSliderFactoryPrivate : public IntEditorFactoryPrivate<QSlider>
 {
     QtSliderFactory *q_ptr;
     Q_DECLARE_PUBLIC(QtSliderFactory)
 public:
     void slotPropertyChanged(QtProperty *property, int value);
+    void slotPropertiesChanged(const QList<QtProperty *> &properties);
     void slotRangeChanged(QtProperty *property, int min, int max);
     void slotSingleStepChanged(QtProperty *property, int step);
     void slotSetValue(int value);
+    void slotEditorReleased();
 };
 
 void QtSliderFactoryPrivate::slotPropertyChanged(QtProperty *property, int value)
 {
+    // The property changed after the pending value was edited, so the
+    // pending value is outdated.
+    m_pendingValues.remove(property);
     if (!m_createdEditors.contains(property))
         return;
     QListIterator<QSlider *> itEditor(m_createdEditors[property]);
@@ -319,6 +734,18 @@ void QtSliderFactoryPrivate::slotPropertyChanged(QtProperty *property, int value
     }
 }
 
+void QtSliderFactoryPrivate::slotPropertiesChanged(const QList<QtProperty *> &properties)
+{
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext()) {
+        QtProperty *property = itProperty.next();
+        if (!m_createdEditors.contains(property))
+            continue;
+        if (QtIntPropertyManager *manager = q_ptr->propertyManager(property))
+            slotPropertyChanged(property, manager->value(property));
+    }
+}
+
 void QtSliderFactoryPrivate::slotRangeChanged(QtProperty *property, int min, int max)
 {
     if (!m_createdEditors.contains(property))
@@ -353,18 +780,17 @@ void QtSliderFactoryPrivate::slotSingleStepChanged(QtProperty *property, int ste
 
 void QtSliderFactoryPrivate::slotSetValue(int value)
 {
-    QObject *object = q_ptr->sender();
-    const QMap<QSlider *, QtProperty *>::ConstIterator ecend = m_editorToProperty.constEnd();
-    for (QMap<QSlider *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend; ++itEditor ) {
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtIntPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
-    }
+    QSlider *editor = static_cast<QSlider *>(q_ptr->sender());
+    QtProperty *property = propertyForEditor(editor);
+    if (!property)
+        return;
+    setValue(property, value, editor->isSliderDown());
+}
+
+void QtSliderFactoryPrivate::slotEditorReleased()
+{
+    if (QtProperty *property = propertyForEditor(q_ptr->sender()))
+        commitPendingValue(property);
 }
 
 /*!
@@ -384,6 +810,7 @@ QtSliderFactory::QtSliderFactory(QObject *parent)
 {
     d_ptr = new QtSliderFactoryPrivate();
     d_ptr->q_ptr = this;
+    d_ptr->initializeCommitTimer(this);
 
 }
 
@@ -392,10 +819,59 @@ QtSliderFactory::QtSliderFactory(QObject *parent)
 */
 QtSliderFactory::~QtSliderFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
+/*!
+    Returns the policy used to write values from the sliders to the
+    property manager.
+
+    \sa setCommitPolicy()
+*/
+QtAbstractEditorFactoryBase::CommitPolicy QtSliderFactory::commitPolicy() const
+{
+    return d_ptr->m_commitPolicy;
+}
+
+/*!
+    Sets the commit \a policy of this factory. By default every change is
+    committed immediately.
+
+    With CommitOnRelease, values are held back while the slider handle
+    is being dragged and written when it is released; keyboard and page
+    steps are still committed immediately. Values that are pending when the
+    policy changes are written at once.
+
+    \sa commitPolicy(), setCommitInterval()
+*/
+void QtSliderFactory::setCommitPolicy(CommitPolicy policy)
+{
+    d_ptr->setCommitPolicy(policy);
+}
+
+/*!
+    Returns the minimum interval in milliseconds between two commits when
+    the commit policy is ThrottledCommit.
+
+    \sa setCommitInterval()
+*/
+int QtSliderFactory::commitInterval() const
+{
+    return d_ptr->m_commitTimer->interval();
+}
+
+/*!
+    Sets the minimum interval between two throttled commits to \a msec
+    milliseconds. The default is 50 milliseconds.
+
+    \sa commitInterval(), setCommitPolicy()
+*/
+void QtSliderFactory::setCommitInterval(int msec)
+{
+    d_ptr->m_commitTimer->setInterval(msec);
+}
+
 /*!
     \internal
 
@@ -403,14 +879,30 @@ QtSliderFactory::~QtSliderFactory()
 */
 void QtSliderFactory::connectPropertyManager(QtIntPropertyManager *manager)
 {
+    connect(manager, SIGNAL(propertyDestroyed(QtProperty *)),
+                this, SLOT(slotPropertyDestroyed(QtProperty *)));
     connect(manager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotPropertyChanged(QtProperty *, int)));
+    connect(manager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotPropertiesChanged(QList<QtProperty *>)));
     connect(manager, SIGNAL(rangeChanged(QtProperty *, int, int)),
                 this, SLOT(slotRangeChanged(QtProperty *, int, int)));
     connect(manager, SIGNAL(singleStepChanged(QtProperty *, int)),
                 this, SLOT(slotSingleStepChanged(QtProperty *, int)));
 }
 
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class. Keeps the
+    released \a editor for reuse by createEditor().
+*/
+void QtSliderFactory::releaseEditor(QWidget *editor)
+{
+    if (!d_ptr->releaseEditor(editor))
+        QtAbstractEditorFactoryBase::releaseEditor(editor);
+}
+
 /*!
     \internal
 
@@ -419,15 +911,20 @@ void QtSliderFactory::connectPropertyManager(QtIntPropertyManager *manager)
 QWidget *QtSliderFactory::createEditor(QtIntPropertyManager *manager, QtProperty *property,
         QWidget *parent)
 {
-    QSlider *editor = new QSlider(Qt::Horizontal, parent);
+    QSlider *editor = d_ptr->takeIdleEditor(parent);
+    if (!editor)
+        editor = new QSlider(Qt::Horizontal, parent);
     d_ptr->initializeEditor(property, editor);
+    editor->blockSignals(true);
     editor->setSingleStep(manager->singleStep(property));
     editor->setRange(manager->minimum(property), manager->maximum(property));
     editor->setValue(manager->value(property));
+    editor->blockSignals(false);
 
-    connect(editor, SIGNAL(valueChanged(int)), this, SLOT(slotSetValue(int)));
+    connect(editor, SIGNAL(valueChanged(int)), this, SLOT(slotSetValue(int)), Qt::UniqueConnection);
+    connect(editor, SIGNAL(sliderReleased()), this, SLOT(slotEditorReleased()), Qt::UniqueConnection);
     connect(editor, SIGNAL(destroyed(QObject *)),
-                this, SLOT(slotEditorDestroyed(QObject *)));
+                this, SLOT(slotEditorDestroyed(QObject *)), Qt::UniqueConnection);
     return editor;
 }
 
@@ -438,8 +935,13 @@ QWidget *QtSliderFactory::createEditor(QtIntPropertyManager *manager, QtProperty
 */
 void QtSliderFactory::disconnectPropertyManager(QtIntPropertyManager *manager)
 {
+    d_ptr->removePendingValues(manager);
+    disconnect(manager, SIGNAL(propertyDestroyed(QtProperty *)),
+                this, SLOT(slotPropertyDestroyed(QtProperty *)));
     disconnect(manager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotPropertyChanged(QtProperty *, int)));
+    disconnect(manager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotPropertiesChanged(QList<QtProperty *>)));
     disconnect(manager, SIGNAL(rangeChanged(QtProperty *, int, int)),
                 this, SLOT(slotRangeChanged(QtProperty *, int, int)));
     disconnect(manager, SIGNAL(singleStepChanged(QtProperty *, int)),
@@ -448,19 +950,24 @@ void QtSliderFactory::disconnectPropertyManager(QtIntPropertyManager *manager)
 
 // QtSliderFactory
 
-class QtScrollBarFactoryPrivate : public  EditorFactoryPrivate<QScrollBar>
+class QtScrollBarFactoryPrivate : public IntEditorFactoryPrivate<QScrollBar>
 {
     QtScrollBarFactory *q_ptr;
     Q_DECLARE_PUBLIC(QtScrollBarFactory)
 public:
     void slotPropertyChanged(QtProperty *property, int value);
+    void slotPropertiesChanged(const QList<QtProperty *> &properties);
     void slotRangeChanged(QtProperty *property, int min, int max);
     void slotSingleStepChanged(QtProperty *property, int step);
     void slotSetValue(int value);
+    void slotEditorReleased();
 };
 
 void QtScrollBarFactoryPrivate::slotPropertyChanged(QtProperty *property, int value)
 {
+    // The property changed after the pending value was edited, so the
+    // pending value is outdated.
+    m_pendingValues.remove(property);
     if (!m_createdEditors.contains(property))
         return;
 
@@ -473,6 +980,18 @@ void QtScrollBarFactoryPrivate::slotPropertyChanged(QtProperty *property, int va
     }
 }
 
+void QtScrollBarFactoryPrivate::slotPropertiesChanged(const QList<QtProperty *> &properties)
+{
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext()) {
+        QtProperty *property = itProperty.next();
+        if (!m_createdEditors.contains(property))
+            continue;
+        if (QtIntPropertyManager *manager = q_ptr->propertyManager(property))
+            slotPropertyChanged(property, manager->value(property));
+    }
+}
+
 void QtScrollBarFactoryPrivate::slotRangeChanged(QtProperty *property, int min, int max)
 {
     if (!m_createdEditors.contains(property))
@@ -507,17 +1026,17 @@ void QtScrollBarFactoryPrivate::slotSingleStepChanged(QtProperty *property, int
 
 void QtScrollBarFactoryPrivate::slotSetValue(int value)
 {
-    QObject *object = q_ptr->sender();
-    const QMap<QScrollBar *, QtProperty *>::ConstIterator ecend = m_editorToProperty.constEnd();
-    for (QMap<QScrollBar *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend; ++itEditor)
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtIntPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
+    QScrollBar *editor = static_cast<QScrollBar *>(q_ptr->sender());
+    QtProperty *property = propertyForEditor(editor);
+    if (!property)
+        return;
+    setValue(property, value, editor->isSliderDown());
+}
+
+void QtScrollBarFactoryPrivate::slotEditorReleased()
+{
+    if (QtProperty *property = propertyForEditor(q_ptr->sender()))
+        commitPendingValue(property);
 }
 
 /*!
@@ -537,6 +1056,7 @@ QtScrollBarFactory::QtScrollBarFactory(QObject *parent)
 {
     d_ptr = new QtScrollBarFactoryPrivate();
     d_ptr->q_ptr = this;
+    d_ptr->initializeCommitTimer(this);
 
 }
 
@@ -545,10 +1065,59 @@ QtScrollBarFactory::QtScrollBarFactory(QObject *parent)
 */
 QtScrollBarFactory::~QtScrollBarFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
+/*!
+    Returns the policy used to write values from the scroll bars to the
+    property manager.
+
+    \sa setCommitPolicy()
+*/
+QtAbstractEditorFactoryBase::CommitPolicy QtScrollBarFactory::commitPolicy() const
+{
+    return d_ptr->m_commitPolicy;
+}
+
+/*!
+    Sets the commit \a policy of this factory. By default every change is
+    committed immediately.
+
+    With CommitOnRelease, values are held back while the scroll bar handle
+    is being dragged and written when it is released; keyboard and page
+    steps are still committed immediately. Values that are pending when the
+    policy changes are written at once.
+
+    \sa commitPolicy(), setCommitInterval()
+*/
+void QtScrollBarFactory::setCommitPolicy(CommitPolicy policy)
+{
+    d_ptr->setCommitPolicy(policy);
+}
+
+/*!
+    Returns the minimum interval in milliseconds between two commits when
+    the commit policy is ThrottledCommit.
+
+    \sa setCommitInterval()
+*/
+int QtScrollBarFactory::commitInterval() const
+{
+    return d_ptr->m_commitTimer->interval();
+}
+
+/*!
+    Sets the minimum interval between two throttled commits to \a msec
+    milliseconds. The default is 50 milliseconds.
+
+    \sa commitInterval(), setCommitPolicy()
+*/
+void QtScrollBarFactory::setCommitInterval(int msec)
+{
+    d_ptr->m_commitTimer->setInterval(msec);
+}
+
 /*!
     \internal
 
@@ -556,14 +1125,30 @@ QtScrollBarFactory::~QtScrollBarFactory()
 */
 void QtScrollBarFactory::connectPropertyManager(QtIntPropertyManager *manager)
 {
+    connect(manager, SIGNAL(propertyDestroyed(QtProperty *)),
+                this, SLOT(slotPropertyDestroyed(QtProperty *)));
     connect(manager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotPropertyChanged(QtProperty *, int)));
+    connect(manager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotPropertiesChanged(QList<QtProperty *>)));
     connect(manager, SIGNAL(rangeChanged(QtProperty *, int, int)),
                 this, SLOT(slotRangeChanged(QtProperty *, int, int)));
     connect(manager, SIGNAL(singleStepChanged(QtProperty *, int)),
                 this, SLOT(slotSingleStepChanged(QtProperty *, int)));
 }
 
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class. Keeps the
+    released \a editor for reuse by createEditor().
+*/
+void QtScrollBarFactory::releaseEditor(QWidget *editor)
+{
+    if (!d_ptr->releaseEditor(editor))
+        QtAbstractEditorFactoryBase::releaseEditor(editor);
+}
+
 /*!
     \internal
 
@@ -572,14 +1157,20 @@ void QtScrollBarFactory::connectPropertyManager(QtIntPropertyManager *manager)
 QWidget *QtScrollBarFactory::createEditor(QtIntPropertyManager *manager, QtProperty *property,
         QWidget *parent)
 {
-    QScrollBar *editor = new QScrollBar(Qt::Horizontal, parent);
+    QScrollBar *editor = d_ptr->takeIdleEditor(parent);
+    if (!editor)
+        editor = new QScrollBar(Qt::Horizontal, parent);
     d_ptr->initializeEditor(property, editor);
+    editor->blockSignals(true);
     editor->setSingleStep(manager->singleStep(property));
     editor->setRange(manager->minimum(property), manager->maximum(property));
     editor->setValue(manager->value(property));
-    connect(editor, SIGNAL(valueChanged(int)), this, SLOT(slotSetValue(int)));
+    editor->blockSignals(false);
+
+    connect(editor, SIGNAL(valueChanged(int)), this, SLOT(slotSetValue(int)), Qt::UniqueConnection);
+    connect(editor, SIGNAL(sliderReleased()), this, SLOT(slotEditorReleased()), Qt::UniqueConnection);
     connect(editor, SIGNAL(destroyed(QObject *)),
-                this, SLOT(slotEditorDestroyed(QObject *)));
+                this, SLOT(slotEditorDestroyed(QObject *)), Qt::UniqueConnection);
     return editor;
 }
 
@@ -590,8 +1181,13 @@ QWidget *QtScrollBarFactory::createEditor(QtIntPropertyManager *manager, QtPrope
 */
 void QtScrollBarFactory::disconnectPropertyManager(QtIntPropertyManager *manager)
 {
+    d_ptr->removePendingValues(manager);
+    disconnect(manager, SIGNAL(propertyDestroyed(QtProperty *)),
+                this, SLOT(slotPropertyDestroyed(QtProperty *)));
     disconnect(manager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotPropertyChanged(QtProperty *, int)));
+    disconnect(manager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotPropertiesChanged(QList<QtProperty *>)));
     disconnect(manager, SIGNAL(rangeChanged(QtProperty *, int, int)),
                 this, SLOT(slotRangeChanged(QtProperty *, int, int)));
     disconnect(manager, SIGNAL(singleStepChanged(QtProperty *, int)),
@@ -607,8 +1203,43 @@ class QtCheckBoxFactoryPrivate : public EditorFactoryPrivate<QtBoolEdit>
 public:
     void slotPropertyChanged(QtProperty *property, bool value);
     void slotSetValue(bool value);
+    void slotAdaptedValueChanged(QtProperty *property);
+    void slotAdaptedValuesChanged(const QList<QtProperty *> &properties);
+
+    QtBoolEdit *createBoolEdit(QtProperty *property, QWidget *parent, bool value);
 };
 
+// Creates or reuses an editor for property, showing value
+QtBoolEdit *QtCheckBoxFactoryPrivate::createBoolEdit(QtProperty *property, QWidget *parent, bool value)
+{
+    QtBoolEdit *editor = createEditor(property, parent);
+    editor->blockSignals(true);
+    editor->setChecked(value);
+    editor->blockSignals(false);
+
+    QObject::connect(editor, SIGNAL(toggled(bool)), q_ptr, SLOT(slotSetValue(bool)), Qt::UniqueConnection);
+    QObject::connect(editor, SIGNAL(destroyed(QObject *)),
+                q_ptr, SLOT(slotEditorDestroyed(QObject *)), Qt::UniqueConnection);
+    return editor;
+}
+
+void QtCheckBoxFactoryPrivate::slotAdaptedValueChanged(QtProperty *property)
+{
+    if (m_createdEditors.contains(property))
+        slotPropertyChanged(property, static_cast<QtPropertyEditorAdapter *>(q_ptr->sender())->value(property).toBool());
+}
+
+void QtCheckBoxFactoryPrivate::slotAdaptedValuesChanged(const QList<QtProperty *> &properties)
+{
+    const QtPropertyEditorAdapter *adapter = static_cast<QtPropertyEditorAdapter *>(q_ptr->sender());
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext()) {
+        QtProperty *property = itProperty.next();
+        if (m_createdEditors.contains(property))
+            slotPropertyChanged(property, adapter->value(property).toBool());
+    }
+}
+
 void QtCheckBoxFactoryPrivate::slotPropertyChanged(QtProperty *property, bool value)
 {
     if (!m_createdEditors.contains(property))
@@ -625,18 +1256,13 @@ void QtCheckBoxFactoryPrivate::slotPropertyChanged(QtProperty *property, bool va
 
 void QtCheckBoxFactoryPrivate::slotSetValue(bool value)
 {
-    QObject *object = q_ptr->sender();
-
-    const QMap<QtBoolEdit *, QtProperty *>::ConstIterator ecend = m_editorToProperty.constEnd();
-    for (QMap<QtBoolEdit *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend;  ++itEditor)
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtBoolPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
+    QtProperty *property = propertyForEditor(q_ptr->sender());
+    if (!property)
+        return;
+    if (QtBoolPropertyManager *manager = q_ptr->propertyManager(property))
+        manager->setValue(property, value);
+    else if (QtPropertyEditorAdapter *adapter = QtPropertyEditorAdapter::adapter(property))
+        adapter->setValue(property, QVariant(value));
 }
 
 /*!
@@ -664,7 +1290,7 @@ QtCheckBoxFactory::QtCheckBoxFactory(QObject *parent)
 */
 QtCheckBoxFactory::~QtCheckBoxFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
@@ -679,6 +1305,18 @@ void QtCheckBoxFactory::connectPropertyManager(QtBoolPropertyManager *manager)
                 this, SLOT(slotPropertyChanged(QtProperty *, bool)));
 }
 
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class. Keeps the
+    released \a editor for reuse by createEditor().
+*/
+void QtCheckBoxFactory::releaseEditor(QWidget *editor)
+{
+    if (!d_ptr->releaseEditor(editor))
+        QtAbstractEditorFactoryBase::releaseEditor(editor);
+}
+
 /*!
     \internal
 
@@ -687,13 +1325,19 @@ void QtCheckBoxFactory::connectPropertyManager(QtBoolPropertyManager *manager)
 QWidget *QtCheckBoxFactory::createEditor(QtBoolPropertyManager *manager, QtProperty *property,
         QWidget *parent)
 {
-    QtBoolEdit *editor = d_ptr->createEditor(property, parent);
-    editor->setChecked(manager->value(property));
+    return d_ptr->createBoolEdit(property, parent, manager->value(property));
+}
 
-    connect(editor, SIGNAL(toggled(bool)), this, SLOT(slotSetValue(bool)));
-    connect(editor, SIGNAL(destroyed(QObject *)),
-                this, SLOT(slotEditorDestroyed(QObject *)));
-    return editor;
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class.
+*/
+QWidget *QtCheckBoxFactory::createAdaptedEditor(QtPropertyEditorAdapter *adapter, QtProperty *property,
+        QWidget *parent)
+{
+    connectAdapterValues(adapter, this);
+    return d_ptr->createBoolEdit(property, parent, adapter->value(property).toBool());
 }
 
 /*!
@@ -716,12 +1360,70 @@ class QtDoubleSpinBoxFactoryPrivate : public EditorFactoryPrivate<QDoubleSpinBox
 public:
 
     void slotPropertyChanged(QtProperty *property, double value);
+    void slotPropertiesChanged(const QList<QtProperty *> &properties);
     void slotRangeChanged(QtProperty *property, double min, double max);
     void slotSingleStepChanged(QtProperty *property, double step);
     void slotDecimalsChanged(QtProperty *property, int prec);
     void slotSetValue(double value);
+    void slotAdaptedValueChanged(QtProperty *property);
+    void slotAdaptedValuesChanged(const QList<QtProperty *> &properties);
+    void slotAdaptedAttributeChanged(QtProperty *property);
+
+    QDoubleSpinBox *createSpinBox(QtProperty *property, QWidget *parent);
+    void setupAdaptedEditor(QDoubleSpinBox *editor, const QtPropertyEditorAdapter *adapter,
+                const QtProperty *property);
 };
 
+// Creates or reuses an editor for property; the caller sets it up.
+QDoubleSpinBox *QtDoubleSpinBoxFactoryPrivate::createSpinBox(QtProperty *property, QWidget *parent)
+{
+    QDoubleSpinBox *editor = createEditor(property, parent);
+    editor->setKeyboardTracking(false);
+    QObject::connect(editor, SIGNAL(valueChanged(double)), q_ptr, SLOT(slotSetValue(double)), Qt::UniqueConnection);
+    QObject::connect(editor, SIGNAL(destroyed(QObject *)),
+                q_ptr, SLOT(slotEditorDestroyed(QObject *)), Qt::UniqueConnection);
+    return editor;
+}
+
+void QtDoubleSpinBoxFactoryPrivate::setupAdaptedEditor(QDoubleSpinBox *editor,
+            const QtPropertyEditorAdapter *adapter, const QtProperty *property)
+{
+    editor->blockSignals(true);
+    editor->setSingleStep(adapter->attributeValue(property, QLatin1String("singleStep")).toDouble());
+    editor->setDecimals(adapter->attributeValue(property, QLatin1String("decimals")).toInt());
+    editor->setRange(adapter->attributeValue(property, QLatin1String("minimum")).toDouble(),
+                adapter->attributeValue(property, QLatin1String("maximum")).toDouble());
+    editor->setValue(adapter->value(property).toDouble());
+    editor->blockSignals(false);
+}
+
+void QtDoubleSpinBoxFactoryPrivate::slotAdaptedValueChanged(QtProperty *property)
+{
+    if (m_createdEditors.contains(property))
+        slotPropertyChanged(property, static_cast<QtPropertyEditorAdapter *>(q_ptr->sender())->value(property).toDouble());
+}
+
+void QtDoubleSpinBoxFactoryPrivate::slotAdaptedValuesChanged(const QList<QtProperty *> &properties)
+{
+    const QtPropertyEditorAdapter *adapter = static_cast<QtPropertyEditorAdapter *>(q_ptr->sender());
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext()) {
+        QtProperty *property = itProperty.next();
+        if (m_createdEditors.contains(property))
+            slotPropertyChanged(property, adapter->value(property).toDouble());
+    }
+}
+
+void QtDoubleSpinBoxFactoryPrivate::slotAdaptedAttributeChanged(QtProperty *property)
+{
+    if (!m_createdEditors.contains(property))
+        return;
+    const QtPropertyEditorAdapter *adapter = static_cast<QtPropertyEditorAdapter *>(q_ptr->sender());
+    QListIterator<QDoubleSpinBox *> itEditor(m_createdEditors[property]);
+    while (itEditor.hasNext())
+        setupAdaptedEditor(itEditor.next(), adapter, property);
+}
+
 void QtDoubleSpinBoxFactoryPrivate::slotPropertyChanged(QtProperty *property, double value)
 {
     QList<QDoubleSpinBox *> editors = m_createdEditors[property];
@@ -736,6 +1438,18 @@ void QtDoubleSpinBoxFactoryPrivate::slotPropertyChanged(QtProperty *property, do
     }
 }
 
+void QtDoubleSpinBoxFactoryPrivate::slotPropertiesChanged(const QList<QtProperty *> &properties)
+{
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext()) {
+        QtProperty *property = itProperty.next();
+        if (!m_createdEditors.contains(property))
+            continue;
+        if (QtDoublePropertyManager *manager = q_ptr->propertyManager(property))
+            slotPropertyChanged(property, manager->value(property));
+    }
+}
+
 void QtDoubleSpinBoxFactoryPrivate::slotRangeChanged(QtProperty *property,
             double min, double max)
 {
@@ -798,18 +1512,13 @@ void QtDoubleSpinBoxFactoryPrivate::slotDecimalsChanged(QtProperty *property, in
 
 void QtDoubleSpinBoxFactoryPrivate::slotSetValue(double value)
 {
-    QObject *object = q_ptr->sender();
-    const QMap<QDoubleSpinBox *, QtProperty *>::ConstIterator itcend = m_editorToProperty.constEnd();
-    for (QMap<QDoubleSpinBox *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != itcend; ++itEditor) {
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtDoublePropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
-    }
+    QtProperty *property = propertyForEditor(q_ptr->sender());
+    if (!property)
+        return;
+    if (QtDoublePropertyManager *manager = q_ptr->propertyManager(property))
+        manager->setValue(property, value);
+    else if (QtPropertyEditorAdapter *adapter = QtPropertyEditorAdapter::adapter(property))
+        adapter->setValue(property, QVariant(value));
 }
 
 /*! \class QtDoubleSpinBoxFactory
@@ -836,7 +1545,7 @@ QtDoubleSpinBoxFactory::QtDoubleSpinBoxFactory(QObject *parent)
 */
 QtDoubleSpinBoxFactory::~QtDoubleSpinBoxFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
@@ -849,6 +1558,8 @@ void QtDoubleSpinBoxFactory::connectPropertyManager(QtDoublePropertyManager *man
 {
     connect(manager, SIGNAL(valueChanged(QtProperty *, double)),
                 this, SLOT(slotPropertyChanged(QtProperty *, double)));
+    connect(manager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotPropertiesChanged(QList<QtProperty *>)));
     connect(manager, SIGNAL(rangeChanged(QtProperty *, double, double)),
                 this, SLOT(slotRangeChanged(QtProperty *, double, double)));
     connect(manager, SIGNAL(singleStepChanged(QtProperty *, double)),
@@ -857,6 +1568,18 @@ void QtDoubleSpinBoxFactory::connectPropertyManager(QtDoublePropertyManager *man
                 this, SLOT(slotDecimalsChanged(QtProperty *, int)));
 }
 
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class. Keeps the
+    released \a editor for reuse by createEditor().
+*/
+void QtDoubleSpinBoxFactory::releaseEditor(QWidget *editor)
+{
+    if (!d_ptr->releaseEditor(editor))
+        QtAbstractEditorFactoryBase::releaseEditor(editor);
+}
+
 /*!
     \internal
 
@@ -865,16 +1588,29 @@ void QtDoubleSpinBoxFactory::connectPropertyManager(QtDoublePropertyManager *man
 QWidget *QtDoubleSpinBoxFactory::createEditor(QtDoublePropertyManager *manager,
         QtProperty *property, QWidget *parent)
 {
-    QDoubleSpinBox *editor = d_ptr->createEditor(property, parent);
+    QDoubleSpinBox *editor = d_ptr->createSpinBox(property, parent);
+    editor->blockSignals(true);
     editor->setSingleStep(manager->singleStep(property));
     editor->setDecimals(manager->decimals(property));
     editor->setRange(manager->minimum(property), manager->maximum(property));
     editor->setValue(manager->value(property));
-    editor->setKeyboardTracking(false);
+    editor->blockSignals(false);
+    return editor;
+}
 
-    connect(editor, SIGNAL(valueChanged(double)), this, SLOT(slotSetValue(double)));
-    connect(editor, SIGNAL(destroyed(QObject *)),
-                this, SLOT(slotEditorDestroyed(QObject *)));
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class.
+*/
+QWidget *QtDoubleSpinBoxFactory::createAdaptedEditor(QtPropertyEditorAdapter *adapter, QtProperty *property,
+        QWidget *parent)
+{
+    connectAdapterValues(adapter, this);
+    connect(adapter, SIGNAL(attributeChanged(QtProperty *)),
+                this, SLOT(slotAdaptedAttributeChanged(QtProperty *)), Qt::UniqueConnection);
+    QDoubleSpinBox *editor = d_ptr->createSpinBox(property, parent);
+    d_ptr->setupAdaptedEditor(editor, adapter, property);
     return editor;
 }
 
@@ -887,6 +1623,8 @@ void QtDoubleSpinBoxFactory::disconnectPropertyManager(QtDoublePropertyManager *
 {
     disconnect(manager, SIGNAL(valueChanged(QtProperty *, double)),
                 this, SLOT(slotPropertyChanged(QtProperty *, double)));
+    disconnect(manager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotPropertiesChanged(QList<QtProperty *>)));
     disconnect(manager, SIGNAL(rangeChanged(QtProperty *, double, double)),
                 this, SLOT(slotRangeChanged(QtProperty *, double, double)));
     disconnect(manager, SIGNAL(singleStepChanged(QtProperty *, double)),
@@ -905,7 +1643,34 @@ public:
 
     void slotPropertyChanged(QtProperty *property, const QString &value);
     void slotRegExpChanged(QtProperty *property, const QRegExp &regExp);
+    void slotRegularExpressionChanged(QtProperty *property, const QRegularExpression &regularExpression);
     void slotSetValue(const QString &value);
+    void slotAdaptedValueChanged(QtProperty *property);
+    void slotAdaptedValuesChanged(const QList<QtProperty *> &properties);
+    void slotAdaptedAttributeChanged(QtProperty *property);
+
+    void slotEditorDestroyed(QObject *object);
+
+    QLineEdit *createLineEdit(QtProperty *property, QWidget *parent);
+    void setValidator(QLineEdit *editor, const QRegExp &regExp, const QRegularExpression &regularExpression);
+    void setAdaptedValidator(QLineEdit *editor, const QtPropertyEditorAdapter *adapter,
+                const QtProperty *property);
+    void clearValidator(QLineEdit *editor);
+    void updateValidators(QtProperty *property);
+
+    // One validator per distinct pattern, owned by the factory and shared
+    // by the editors using it. It is deleted with its last editor.
+    typedef QPair<QString, int> ValidatorKey;
+    struct SharedValidator
+    {
+        SharedValidator() : validator(0), refCount(0) {}
+        QRegularExpressionValidator *validator;
+        int refCount;
+    };
+    QHash<ValidatorKey, SharedValidator> m_sharedValidators;
+    QHash<QLineEdit *, ValidatorKey> m_editorToValidatorKey;
+private:
+    void releaseSharedValidator(QLineEdit *editor);
 };
 
 void QtLineEditFactoryPrivate::slotPropertyChanged(QtProperty *property,
@@ -922,8 +1687,90 @@ void QtLineEditFactoryPrivate::slotPropertyChanged(QtProperty *property,
     }
 }
 
-void QtLineEditFactoryPrivate::slotRegExpChanged(QtProperty *property,
-            const QRegExp &regExp)
+// Creates or reuses an editor for property; the caller sets it up.
+QLineEdit *QtLineEditFactoryPrivate::createLineEdit(QtProperty *property, QWidget *parent)
+{
+    QLineEdit *editor = createEditor(property, parent);
+    QObject::connect(editor, SIGNAL(textEdited(const QString &)),
+                q_ptr, SLOT(slotSetValue(const QString &)), Qt::UniqueConnection);
+    QObject::connect(editor, SIGNAL(destroyed(QObject *)),
+                q_ptr, SLOT(slotEditorDestroyed(QObject *)), Qt::UniqueConnection);
+    return editor;
+}
+
+// Installs the validator for the property's current expressions. A set
+// QRegularExpression takes precedence over the QRegExp, as it does in
+// QtStringPropertyManager::setValue().
+void QtLineEditFactoryPrivate::setValidator(QLineEdit *editor, const QRegExp &regExp,
+            const QRegularExpression &regularExpression)
+{
+    const QValidator *oldValidator = editor->validator();
+    QValidator *newValidator = 0;
+    ValidatorKey key;
+    if (!regularExpression.pattern().isEmpty()) {
+        if (regularExpression.isValid()) {
+            key = ValidatorKey(regularExpression.pattern(), int(regularExpression.patternOptions()));
+            const QHash<QLineEdit *, ValidatorKey>::ConstIterator it = m_editorToValidatorKey.constFind(editor);
+            if (it != m_editorToValidatorKey.constEnd() && it.value() == key)
+                return;
+            SharedValidator &shared = m_sharedValidators[key];
+            if (!shared.validator)
+                shared.validator = new QRegularExpressionValidator(regularExpression, q_ptr);
+            shared.refCount++;
+            newValidator = shared.validator;
+        }
+    } else if (regExp.isValid()) {
+        newValidator = new QRegExpValidator(regExp, editor);
+    }
+    if (newValidator == oldValidator)
+        return;
+    editor->setValidator(newValidator);
+    releaseSharedValidator(editor);
+    if (!key.first.isEmpty())
+        m_editorToValidatorKey.insert(editor, key);
+    if (oldValidator && oldValidator->parent() == editor)
+        delete oldValidator;
+}
+
+void QtLineEditFactoryPrivate::setAdaptedValidator(QLineEdit *editor,
+            const QtPropertyEditorAdapter *adapter, const QtProperty *property)
+{
+    setValidator(editor, adapter->attributeValue(property, QLatin1String("regExp")).toRegExp(),
+                adapter->attributeValue(property, QLatin1String("regularExpression")).toRegularExpression());
+}
+
+// Removes the validator of an editor that is released for reuse.
+void QtLineEditFactoryPrivate::clearValidator(QLineEdit *editor)
+{
+    const QValidator *oldValidator = editor->validator();
+    editor->setValidator(0);
+    releaseSharedValidator(editor);
+    if (oldValidator && oldValidator->parent() == editor)
+        delete oldValidator;
+}
+
+// Drops the reference of editor to its shared validator, if it has one.
+// The editor must not use the validator any more.
+void QtLineEditFactoryPrivate::releaseSharedValidator(QLineEdit *editor)
+{
+    const QHash<QLineEdit *, ValidatorKey>::iterator it = m_editorToValidatorKey.find(editor);
+    if (it == m_editorToValidatorKey.end())
+        return;
+    const QHash<ValidatorKey, SharedValidator>::iterator itShared = m_sharedValidators.find(it.value());
+    m_editorToValidatorKey.erase(it);
+    if (itShared == m_sharedValidators.end() || --itShared.value().refCount > 0)
+        return;
+    delete itShared.value().validator;
+    m_sharedValidators.erase(itShared);
+}
+
+void QtLineEditFactoryPrivate::slotEditorDestroyed(QObject *object)
+{
+    releaseSharedValidator(static_cast<QLineEdit *>(object));
+    EditorFactoryPrivate<QLineEdit>::slotEditorDestroyed(object);
+}
+
+void QtLineEditFactoryPrivate::updateValidators(QtProperty *property)
 {
     if (!m_createdEditors.contains(property))
         return;
@@ -936,31 +1783,63 @@ void QtLineEditFactoryPrivate::slotRegExpChanged(QtProperty *property,
     while (itEditor.hasNext()) {
         QLineEdit *editor = itEditor.next();
         editor->blockSignals(true);
-        const QValidator *oldValidator = editor->validator();
-        QValidator *newValidator = 0;
-        if (regExp.isValid()) {
-            newValidator = new QRegExpValidator(regExp, editor);
-        }
-        editor->setValidator(newValidator);
-        if (oldValidator)
-            delete oldValidator;
+        setValidator(editor, manager->regExp(property), manager->regularExpression(property));
         editor->blockSignals(false);
     }
 }
 
+void QtLineEditFactoryPrivate::slotRegExpChanged(QtProperty *property,
+            const QRegExp &)
+{
+    updateValidators(property);
+}
+
+void QtLineEditFactoryPrivate::slotRegularExpressionChanged(QtProperty *property,
+            const QRegularExpression &)
+{
+    updateValidators(property);
+}
+
 void QtLineEditFactoryPrivate::slotSetValue(const QString &value)
 {
-    QObject *object = q_ptr->sender();
-    const QMap<QLineEdit *, QtProperty *>::ConstIterator ecend = m_editorToProperty.constEnd();
-    for (QMap<QLineEdit *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend; ++itEditor)
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtStringPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
+    QtProperty *property = propertyForEditor(q_ptr->sender());
+    if (!property)
+        return;
+    if (QtStringPropertyManager *manager = q_ptr->propertyManager(property))
+        manager->setValue(property, value);
+    else if (QtPropertyEditorAdapter *adapter = QtPropertyEditorAdapter::adapter(property))
+        adapter->setValue(property, QVariant(value));
+}
+
+void QtLineEditFactoryPrivate::slotAdaptedValueChanged(QtProperty *property)
+{
+    if (m_createdEditors.contains(property))
+        slotPropertyChanged(property, static_cast<QtPropertyEditorAdapter *>(q_ptr->sender())->value(property).toString());
+}
+
+void QtLineEditFactoryPrivate::slotAdaptedValuesChanged(const QList<QtProperty *> &properties)
+{
+    const QtPropertyEditorAdapter *adapter = static_cast<QtPropertyEditorAdapter *>(q_ptr->sender());
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext()) {
+        QtProperty *property = itProperty.next();
+        if (m_createdEditors.contains(property))
+            slotPropertyChanged(property, adapter->value(property).toString());
+    }
+}
+
+void QtLineEditFactoryPrivate::slotAdaptedAttributeChanged(QtProperty *property)
+{
+    if (!m_createdEditors.contains(property))
+        return;
+    const QtPropertyEditorAdapter *adapter = static_cast<QtPropertyEditorAdapter *>(q_ptr->sender());
+    QListIterator<QLineEdit *> itEditor(m_createdEditors[property]);
+    while (itEditor.hasNext()) {
+        QLineEdit *editor = itEditor.next();
+        editor->blockSignals(true);
+        setAdaptedValidator(editor, adapter, property);
+        editor->blockSignals(false);
+    }
 }
 
 /*!
@@ -988,7 +1867,7 @@ QtLineEditFactory::QtLineEditFactory(QObject *parent)
 */
 QtLineEditFactory::~QtLineEditFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
@@ -1003,6 +1882,22 @@ void QtLineEditFactory::connectPropertyManager(QtStringPropertyManager *manager)
                 this, SLOT(slotPropertyChanged(QtProperty *, const QString &)));
     connect(manager, SIGNAL(regExpChanged(QtProperty *, const QRegExp &)),
                 this, SLOT(slotRegExpChanged(QtProperty *, const QRegExp &)));
+    connect(manager, SIGNAL(regularExpressionChanged(QtProperty *, const QRegularExpression &)),
+                this, SLOT(slotRegularExpressionChanged(QtProperty *, const QRegularExpression &)));
+}
+
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class. Keeps the
+    released \a editor for reuse by createEditor().
+*/
+void QtLineEditFactory::releaseEditor(QWidget *editor)
+{
+    if (d_ptr->propertyForEditor(editor))
+        d_ptr->clearValidator(static_cast<QLineEdit *>(editor));
+    if (!d_ptr->releaseEditor(editor))
+        QtAbstractEditorFactoryBase::releaseEditor(editor);
 }
 
 /*!
@@ -1014,18 +1909,30 @@ QWidget *QtLineEditFactory::createEditor(QtStringPropertyManager *manager,
         QtProperty *property, QWidget *parent)
 {
 
-    QLineEdit *editor = d_ptr->createEditor(property, parent);
-    QRegExp regExp = manager->regExp(property);
-    if (regExp.isValid()) {
-        QValidator *validator = new QRegExpValidator(regExp, editor);
-        editor->setValidator(validator);
-    }
+    QLineEdit *editor = d_ptr->createLineEdit(property, parent);
+    editor->blockSignals(true);
+    d_ptr->setValidator(editor, manager->regExp(property), manager->regularExpression(property));
     editor->setText(manager->value(property));
+    editor->blockSignals(false);
+    return editor;
+}
 
-    connect(editor, SIGNAL(textEdited(const QString &)),
-                this, SLOT(slotSetValue(const QString &)));
-    connect(editor, SIGNAL(destroyed(QObject *)),
-                this, SLOT(slotEditorDestroyed(QObject *)));
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class.
+*/
+QWidget *QtLineEditFactory::createAdaptedEditor(QtPropertyEditorAdapter *adapter, QtProperty *property,
+        QWidget *parent)
+{
+    connectAdapterValues(adapter, this);
+    connect(adapter, SIGNAL(attributeChanged(QtProperty *)),
+                this, SLOT(slotAdaptedAttributeChanged(QtProperty *)), Qt::UniqueConnection);
+    QLineEdit *editor = d_ptr->createLineEdit(property, parent);
+    editor->blockSignals(true);
+    d_ptr->setAdaptedValidator(editor, adapter, property);
+    editor->setText(adapter->value(property).toString());
+    editor->blockSignals(false);
     return editor;
 }
 
@@ -1040,6 +1947,8 @@ void QtLineEditFactory::disconnectPropertyManager(QtStringPropertyManager *manag
                 this, SLOT(slotPropertyChanged(QtProperty *, const QString &)));
     disconnect(manager, SIGNAL(regExpChanged(QtProperty *, const QRegExp &)),
                 this, SLOT(slotRegExpChanged(QtProperty *, const QRegExp &)));
+    disconnect(manager, SIGNAL(regularExpressionChanged(QtProperty *, const QRegularExpression &)),
+                this, SLOT(slotRegularExpressionChanged(QtProperty *, const QRegularExpression &)));
 }
 
 // QtDateEditFactory
@@ -1090,17 +1999,13 @@ void QtDateEditFactoryPrivate::slotRangeChanged(QtProperty *property,
 
 void QtDateEditFactoryPrivate::slotSetValue(const QDate &value)
 {
-    QObject *object = q_ptr->sender();
-    const QMap<QDateEdit *, QtProperty *>::ConstIterator  ecend = m_editorToProperty.constEnd();
-    for (QMap<QDateEdit *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend; ++itEditor)
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtDatePropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
+    QtProperty *property = propertyForEditor(q_ptr->sender());
+    if (!property)
+        return;
+    QtDatePropertyManager *manager = q_ptr->propertyManager(property);
+    if (!manager)
+        return;
+    manager->setValue(property, value);
 }
 
 /*!
@@ -1128,7 +2033,7 @@ QtDateEditFactory::QtDateEditFactory(QObject *parent)
 */
 QtDateEditFactory::~QtDateEditFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
@@ -1205,17 +2110,13 @@ void QtTimeEditFactoryPrivate::slotPropertyChanged(QtProperty *property, const Q
 
 void QtTimeEditFactoryPrivate::slotSetValue(const QTime &value)
 {
-    QObject *object = q_ptr->sender();
-    const  QMap<QTimeEdit *, QtProperty *>::ConstIterator ecend = m_editorToProperty.constEnd();
-    for (QMap<QTimeEdit *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend; ++itEditor)
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtTimePropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
+    QtProperty *property = propertyForEditor(q_ptr->sender());
+    if (!property)
+        return;
+    QtTimePropertyManager *manager = q_ptr->propertyManager(property);
+    if (!manager)
+        return;
+    manager->setValue(property, value);
 }
 
 /*!
@@ -1243,7 +2144,7 @@ QtTimeEditFactory::QtTimeEditFactory(QObject *parent)
 */
 QtTimeEditFactory::~QtTimeEditFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
@@ -1317,17 +2218,13 @@ void QtDateTimeEditFactoryPrivate::slotPropertyChanged(QtProperty *property,
 
 void QtDateTimeEditFactoryPrivate::slotSetValue(const QDateTime &value)
 {
-    QObject *object = q_ptr->sender();
-    const  QMap<QDateTimeEdit *, QtProperty *>::ConstIterator ecend = m_editorToProperty.constEnd();
-    for (QMap<QDateTimeEdit *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend;  ++itEditor)
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtDateTimePropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
+    QtProperty *property = propertyForEditor(q_ptr->sender());
+    if (!property)
+        return;
+    QtDateTimePropertyManager *manager = q_ptr->propertyManager(property);
+    if (!manager)
+        return;
+    manager->setValue(property, value);
 }
 
 /*!
@@ -1355,7 +2252,7 @@ QtDateTimeEditFactory::QtDateTimeEditFactory(QObject *parent)
 */
 QtDateTimeEditFactory::~QtDateTimeEditFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
@@ -1428,17 +2325,13 @@ void QtKeySequenceEditorFactoryPrivate::slotPropertyChanged(QtProperty *property
 
 void QtKeySequenceEditorFactoryPrivate::slotSetValue(const QKeySequence &value)
 {
-    QObject *object = q_ptr->sender();
-    const  QMap<QtKeySequenceEdit *, QtProperty *>::ConstIterator ecend = m_editorToProperty.constEnd();
-    for (QMap<QtKeySequenceEdit *, QtProperty *>::ConstIterator itEditor =  m_editorToProperty.constBegin(); itEditor != ecend; ++itEditor)
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtKeySequencePropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
+    QtProperty *property = propertyForEditor(q_ptr->sender());
+    if (!property)
+        return;
+    QtKeySequencePropertyManager *manager = q_ptr->propertyManager(property);
+    if (!manager)
+        return;
+    manager->setValue(property, value);
 }
 
 /*!
@@ -1466,7 +2359,7 @@ QtKeySequenceEditorFactory::QtKeySequenceEditorFactory(QObject *parent)
 */
 QtKeySequenceEditorFactory::~QtKeySequenceEditorFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
@@ -1718,17 +2611,13 @@ void QtCharEditorFactoryPrivate::slotPropertyChanged(QtProperty *property,
 
 void QtCharEditorFactoryPrivate::slotSetValue(const QChar &value)
 {
-    QObject *object = q_ptr->sender();
-    const QMap<QtCharEdit *, QtProperty *>::ConstIterator ecend = m_editorToProperty.constEnd();
-    for (QMap<QtCharEdit *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend;  ++itEditor)
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtCharPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
+    QtProperty *property = propertyForEditor(q_ptr->sender());
+    if (!property)
+        return;
+    QtCharPropertyManager *manager = q_ptr->propertyManager(property);
+    if (!manager)
+        return;
+    manager->setValue(property, value);
 }
 
 /*!
@@ -1756,7 +2645,7 @@ QtCharEditorFactory::QtCharEditorFactory(QObject *parent)
 */
 QtCharEditorFactory::~QtCharEditorFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
@@ -1812,6 +2701,8 @@ public:
     void slotEnumNamesChanged(QtProperty *property, const QStringList &);
     void slotEnumIconsChanged(QtProperty *property, const QMap<int, QIcon> &);
     void slotSetValue(int value);
+
+    void updateModel(QtProperty *property);
 };
 
 void QtEnumEditorFactoryPrivate::slotPropertyChanged(QtProperty *property, int value)
@@ -1828,8 +2719,9 @@ void QtEnumEditorFactoryPrivate::slotPropertyChanged(QtProperty *property, int v
     }
 }
 
-void QtEnumEditorFactoryPrivate::slotEnumNamesChanged(QtProperty *property,
-                const QStringList &enumNames)
+// Editors of properties sharing an enum type share the manager's model
+// of it; a names or icons change moves the property to another model.
+void QtEnumEditorFactoryPrivate::updateModel(QtProperty *property)
 {
     if (!m_createdEditors.contains(property))
         return;
@@ -1838,58 +2730,39 @@ void QtEnumEditorFactoryPrivate::slotEnumNamesChanged(QtProperty *property,
     if (!manager)
         return;
 
-    QMap<int, QIcon> enumIcons = manager->enumIcons(property);
-
+    QAbstractItemModel *model = manager->enumModel(property);
     QListIterator<QComboBox *> itEditor(m_createdEditors[property]);
     while (itEditor.hasNext()) {
         QComboBox *editor = itEditor.next();
         editor->blockSignals(true);
-        editor->clear();
-        editor->addItems(enumNames);
-        const int nameCount = enumNames.count();
-        for (int i = 0; i < nameCount; i++)
-            editor->setItemIcon(i, enumIcons.value(i));
+        if (editor->model() != model)
+            editor->setModel(model);
         editor->setCurrentIndex(manager->value(property));
         editor->blockSignals(false);
     }
 }
 
-void QtEnumEditorFactoryPrivate::slotEnumIconsChanged(QtProperty *property,
-                const QMap<int, QIcon> &enumIcons)
+void QtEnumEditorFactoryPrivate::slotEnumNamesChanged(QtProperty *property,
+                const QStringList &)
 {
-    if (!m_createdEditors.contains(property))
-        return;
-
-    QtEnumPropertyManager *manager = q_ptr->propertyManager(property);
-    if (!manager)
-        return;
+    updateModel(property);
+}
 
-    const QStringList enumNames = manager->enumNames(property);
-    QListIterator<QComboBox *> itEditor(m_createdEditors[property]);
-    while (itEditor.hasNext()) {
-        QComboBox *editor = itEditor.next();
-        editor->blockSignals(true);
-        const int nameCount = enumNames.count();
-        for (int i = 0; i < nameCount; i++)
-            editor->setItemIcon(i, enumIcons.value(i));
-        editor->setCurrentIndex(manager->value(property));
-        editor->blockSignals(false);
-    }
+void QtEnumEditorFactoryPrivate::slotEnumIconsChanged(QtProperty *property,
+                const QMap<int, QIcon> &)
+{
+    updateModel(property);
 }
 
 void QtEnumEditorFactoryPrivate::slotSetValue(int value)
 {
-    QObject *object = q_ptr->sender();
-    const  QMap<QComboBox *, QtProperty *>::ConstIterator ecend = m_editorToProperty.constEnd();
-    for (QMap<QComboBox *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend; ++itEditor)
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtEnumPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
+    QtProperty *property = propertyForEditor(q_ptr->sender());
+    if (!property)
+        return;
+    QtEnumPropertyManager *manager = q_ptr->propertyManager(property);
+    if (!manager)
+        return;
+    manager->setValue(property, value);
 }
 
 /*!
@@ -1917,7 +2790,7 @@ QtEnumEditorFactory::QtEnumEditorFactory(QObject *parent)
 */
 QtEnumEditorFactory::~QtEnumEditorFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
@@ -1932,6 +2805,20 @@ void QtEnumEditorFactory::connectPropertyManager(QtEnumPropertyManager *manager)
                 this, SLOT(slotPropertyChanged(QtProperty *, int)));
     connect(manager, SIGNAL(enumNamesChanged(QtProperty *, const QStringList &)),
                 this, SLOT(slotEnumNamesChanged(QtProperty *, const QStringList &)));
+    connect(manager, SIGNAL(enumIconsChanged(QtProperty *, const QMap<int, QIcon> &)),
+                this, SLOT(slotEnumIconsChanged(QtProperty *, const QMap<int, QIcon> &)));
+}
+
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class. Keeps the
+    released \a editor for reuse by createEditor().
+*/
+void QtEnumEditorFactory::releaseEditor(QWidget *editor)
+{
+    if (!d_ptr->releaseEditor(editor))
+        QtAbstractEditorFactoryBase::releaseEditor(editor);
 }
 
 /*!
@@ -1943,20 +2830,17 @@ QWidget *QtEnumEditorFactory::createEditor(QtEnumPropertyManager *manager, QtPro
         QWidget *parent)
 {
     QComboBox *editor = d_ptr->createEditor(property, parent);
+    editor->blockSignals(true);
     editor->setSizeAdjustPolicy(QComboBox::AdjustToMinimumContentsLengthWithIcon);
     editor->setMinimumContentsLength(1);
     editor->view()->setTextElideMode(Qt::ElideRight);
-    QStringList enumNames = manager->enumNames(property);
-    editor->addItems(enumNames);
-    QMap<int, QIcon> enumIcons = manager->enumIcons(property);
-    const int enumNamesCount = enumNames.count();
-    for (int i = 0; i < enumNamesCount; i++)
-        editor->setItemIcon(i, enumIcons.value(i));
+    editor->setModel(manager->enumModel(property));
     editor->setCurrentIndex(manager->value(property));
+    editor->blockSignals(false);
 
-    connect(editor, SIGNAL(currentIndexChanged(int)), this, SLOT(slotSetValue(int)));
+    connect(editor, SIGNAL(currentIndexChanged(int)), this, SLOT(slotSetValue(int)), Qt::UniqueConnection);
     connect(editor, SIGNAL(destroyed(QObject *)),
-                this, SLOT(slotEditorDestroyed(QObject *)));
+                this, SLOT(slotEditorDestroyed(QObject *)), Qt::UniqueConnection);
     return editor;
 }
 
@@ -1971,6 +2855,8 @@ void QtEnumEditorFactory::disconnectPropertyManager(QtEnumPropertyManager *manag
                 this, SLOT(slotPropertyChanged(QtProperty *, int)));
     disconnect(manager, SIGNAL(enumNamesChanged(QtProperty *, const QStringList &)),
                 this, SLOT(slotEnumNamesChanged(QtProperty *, const QStringList &)));
+    disconnect(manager, SIGNAL(enumIconsChanged(QtProperty *, const QMap<int, QIcon> &)),
+                this, SLOT(slotEnumIconsChanged(QtProperty *, const QMap<int, QIcon> &)));
 }
 
 // QtCursorEditorFactory
@@ -1994,7 +2880,7 @@ public:
     QMap<QtProperty *, QtProperty *> m_propertyToEnum;
     QMap<QtProperty *, QtProperty *> m_enumToProperty;
     QMap<QtProperty *, QList<QWidget *> > m_enumToEditors;
-    QMap<QWidget *, QtProperty *> m_editorToEnum;
+    QHash<QWidget *, QtProperty *> m_editorToEnum;
     bool m_updatingEnum;
 };
 
@@ -2037,22 +2923,18 @@ void QtCursorEditorFactoryPrivate::slotEditorDestroyed(QObject *object)
     // remove from m_editorToEnum map;
     // remove from m_enumToEditors map;
     // if m_enumToEditors doesn't contains more editors delete enum property;
-    const  QMap<QWidget *, QtProperty *>::ConstIterator ecend = m_editorToEnum.constEnd();
-    for (QMap<QWidget *, QtProperty *>::ConstIterator itEditor = m_editorToEnum.constBegin(); itEditor != ecend; ++itEditor)
-        if (itEditor.key() == object) {
-            QWidget *editor = itEditor.key();
-            QtProperty *enumProp = itEditor.value();
-            m_editorToEnum.remove(editor);
-            m_enumToEditors[enumProp].removeAll(editor);
-            if (m_enumToEditors[enumProp].isEmpty()) {
-                m_enumToEditors.remove(enumProp);
-                QtProperty *property = m_enumToProperty.value(enumProp);
-                m_enumToProperty.remove(enumProp);
-                m_propertyToEnum.remove(property);
-                delete enumProp;
-            }
-            return;
-        }
+    QWidget *editor = static_cast<QWidget *>(object);
+    QtProperty *enumProp = m_editorToEnum.take(editor);
+    if (!enumProp)
+        return;
+    m_enumToEditors[enumProp].removeAll(editor);
+    if (m_enumToEditors[enumProp].isEmpty()) {
+        m_enumToEditors.remove(enumProp);
+        QtProperty *property = m_enumToProperty.value(enumProp);
+        m_enumToProperty.remove(enumProp);
+        m_propertyToEnum.remove(property);
+        delete enumProp;
+    }
 }
 
 /*!
@@ -2272,17 +3154,13 @@ void QtColorEditorFactoryPrivate::slotPropertyChanged(QtProperty *property,
 
 void QtColorEditorFactoryPrivate::slotSetValue(const QColor &value)
 {
-    QObject *object = q_ptr->sender();
-    const EditorToPropertyMap::ConstIterator ecend = m_editorToProperty.constEnd();
-    for (EditorToPropertyMap::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend; ++itEditor)
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtColorPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
+    QtProperty *property = propertyForEditor(q_ptr->sender());
+    if (!property)
+        return;
+    QtColorPropertyManager *manager = q_ptr->propertyManager(property);
+    if (!manager)
+        return;
+    manager->setValue(property, value);
 }
 
 /*!
@@ -2309,7 +3187,7 @@ QtColorEditorFactory::QtColorEditorFactory(QObject *parent) :
 */
 QtColorEditorFactory::~QtColorEditorFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
@@ -2494,17 +3372,13 @@ void QtFontEditorFactoryPrivate::slotPropertyChanged(QtProperty *property,
 
 void QtFontEditorFactoryPrivate::slotSetValue(const QFont &value)
 {
-    QObject *object = q_ptr->sender();
-    const EditorToPropertyMap::ConstIterator ecend = m_editorToProperty.constEnd();
-    for (EditorToPropertyMap::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend; ++itEditor)
-        if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtFontPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
-            return;
-        }
+    QtProperty *property = propertyForEditor(q_ptr->sender());
+    if (!property)
+        return;
+    QtFontPropertyManager *manager = q_ptr->propertyManager(property);
+    if (!manager)
+        return;
+    manager->setValue(property, value);
 }
 
 /*!
@@ -2531,7 +3405,7 @@ QtFontEditorFactory::QtFontEditorFactory(QObject *parent) :
 */
 QtFontEditorFactory::~QtFontEditorFactory()
 {
-    qDeleteAll(d_ptr->m_editorToProperty.keys());
+    d_ptr->deleteEditors();
     delete d_ptr;
 }
 
@@ -55,6 +55,15 @@ class QT_QTPROPERTYBROWSER_EXPORT QtSpinBoxFactory : public QtAbstractEditorFact
 public:
     QtSpinBoxFactory(QObject *parent = 0);
     ~QtSpinBoxFactory();
+
+    QWidget *createAdaptedEditor(QtPropertyEditorAdapter *adapter, QtProperty *property,
+                QWidget *parent);
+    void releaseEditor(QWidget *editor);
+
+    CommitPolicy commitPolicy() const;
+    void setCommitPolicy(CommitPolicy policy);
+    int commitInterval() const;
+    void setCommitInterval(int msec);
 protected:
     void connectPropertyManager(QtIntPropertyManager *manager);
     QWidget *createEditor(QtIntPropertyManager *manager, QtProperty *property,
@@ -65,10 +74,17 @@ private:
     Q_DECLARE_PRIVATE(QtSpinBoxFactory)
     Q_DISABLE_COPY(QtSpinBoxFactory)
     Q_PRIVATE_SLOT(d_func(), void slotPropertyChanged(QtProperty *, int))
+    Q_PRIVATE_SLOT(d_func(), void slotPropertiesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotRangeChanged(QtProperty *, int, int))
     Q_PRIVATE_SLOT(d_func(), void slotSingleStepChanged(QtProperty *, int))
     Q_PRIVATE_SLOT(d_func(), void slotSetValue(int))
     Q_PRIVATE_SLOT(d_func(), void slotEditorDestroyed(QObject *))
+    Q_PRIVATE_SLOT(d_func(), void slotEditorReleased())
+    Q_PRIVATE_SLOT(d_func(), void slotCommitPendingValues())
+    Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
+    Q_PRIVATE_SLOT(d_func(), void slotAdaptedValueChanged(QtProperty *))
+    Q_PRIVATE_SLOT(d_func(), void slotAdaptedValuesChanged(const QList<QtProperty *> &))
+    Q_PRIVATE_SLOT(d_func(), void slotAdaptedAttributeChanged(QtProperty *))
 };
 
 class QtSliderFactoryPrivate;
@@ -79,6 +95,13 @@ class QT_QTPROPERTYBROWSER_EXPORT QtSliderFactory : public QtAbstractEditorFacto
 public:
     QtSliderFactory(QObject *parent = 0);
     ~QtSliderFactory();
+
+    void releaseEditor(QWidget *editor);
+
+    CommitPolicy commitPolicy() const;
+    void setCommitPolicy(CommitPolicy policy);
+    int commitInterval() const;
+    void setCommitInterval(int msec);
 protected:
     void connectPropertyManager(QtIntPropertyManager *manager);
     QWidget *createEditor(QtIntPropertyManager *manager, QtProperty *property,
@@ -89,10 +112,14 @@ private:
     Q_DECLARE_PRIVATE(QtSliderFactory)
     Q_DISABLE_COPY(QtSliderFactory)
     Q_PRIVATE_SLOT(d_func(), void slotPropertyChanged(QtProperty *, int))
+    Q_PRIVATE_SLOT(d_func(), void slotPropertiesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotRangeChanged(QtProperty *, int, int))
     Q_PRIVATE_SLOT(d_func(), void slotSingleStepChanged(QtProperty *, int))
     Q_PRIVATE_SLOT(d_func(), void slotSetValue(int))
     Q_PRIVATE_SLOT(d_func(), void slotEditorDestroyed(QObject *))
+    Q_PRIVATE_SLOT(d_func(), void slotEditorReleased())
+    Q_PRIVATE_SLOT(d_func(), void slotCommitPendingValues())
+    Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
 };
 
 class QtScrollBarFactoryPrivate;
@@ -103,6 +130,13 @@ class QT_QTPROPERTYBROWSER_EXPORT QtScrollBarFactory : public QtAbstractEditorFa
 public:
     QtScrollBarFactory(QObject *parent = 0);
     ~QtScrollBarFactory();
+
+    void releaseEditor(QWidget *editor);
+
+    CommitPolicy commitPolicy() const;
+    void setCommitPolicy(CommitPolicy policy);
+    int commitInterval() const;
+    void setCommitInterval(int msec);
 protected:
     void connectPropertyManager(QtIntPropertyManager *manager);
     QWidget *createEditor(QtIntPropertyManager *manager, QtProperty *property,
@@ -113,10 +147,14 @@ private:
     Q_DECLARE_PRIVATE(QtScrollBarFactory)
     Q_DISABLE_COPY(QtScrollBarFactory)
     Q_PRIVATE_SLOT(d_func(), void slotPropertyChanged(QtProperty *, int))
+    Q_PRIVATE_SLOT(d_func(), void slotPropertiesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotRangeChanged(QtProperty *, int, int))
     Q_PRIVATE_SLOT(d_func(), void slotSingleStepChanged(QtProperty *, int))
     Q_PRIVATE_SLOT(d_func(), void slotSetValue(int))
     Q_PRIVATE_SLOT(d_func(), void slotEditorDestroyed(QObject *))
+    Q_PRIVATE_SLOT(d_func(), void slotEditorReleased())
+    Q_PRIVATE_SLOT(d_func(), void slotCommitPendingValues())
+    Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
 };
 
 class QtCheckBoxFactoryPrivate;
@@ -127,6 +165,10 @@ class QT_QTPROPERTYBROWSER_EXPORT QtCheckBoxFactory : public QtAbstractEditorFac
 public:
     QtCheckBoxFactory(QObject *parent = 0);
     ~QtCheckBoxFactory();
+
+    QWidget *createAdaptedEditor(QtPropertyEditorAdapter *adapter, QtProperty *property,
+                QWidget *parent);
+    void releaseEditor(QWidget *editor);
 protected:
     void connectPropertyManager(QtBoolPropertyManager *manager);
     QWidget *createEditor(QtBoolPropertyManager *manager, QtProperty *property,
@@ -139,6 +181,8 @@ private:
     Q_PRIVATE_SLOT(d_func(), void slotPropertyChanged(QtProperty *, bool))
     Q_PRIVATE_SLOT(d_func(), void slotSetValue(bool))
     Q_PRIVATE_SLOT(d_func(), void slotEditorDestroyed(QObject *))
+    Q_PRIVATE_SLOT(d_func(), void slotAdaptedValueChanged(QtProperty *))
+    Q_PRIVATE_SLOT(d_func(), void slotAdaptedValuesChanged(const QList<QtProperty *> &))
 };
 
 class QtDoubleSpinBoxFactoryPrivate;
@@ -149,6 +193,10 @@ class QT_QTPROPERTYBROWSER_EXPORT QtDoubleSpinBoxFactory : public QtAbstractEdit
 public:
     QtDoubleSpinBoxFactory(QObject *parent = 0);
     ~QtDoubleSpinBoxFactory();
+
+    QWidget *createAdaptedEditor(QtPropertyEditorAdapter *adapter, QtProperty *property,
+                QWidget *parent);
+    void releaseEditor(QWidget *editor);
 protected:
     void connectPropertyManager(QtDoublePropertyManager *manager);
     QWidget *createEditor(QtDoublePropertyManager *manager, QtProperty *property,
@@ -159,11 +207,15 @@ private:
     Q_DECLARE_PRIVATE(QtDoubleSpinBoxFactory)
     Q_DISABLE_COPY(QtDoubleSpinBoxFactory)
     Q_PRIVATE_SLOT(d_func(), void slotPropertyChanged(QtProperty *, double))
+    Q_PRIVATE_SLOT(d_func(), void slotPropertiesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotRangeChanged(QtProperty *, double, double))
     Q_PRIVATE_SLOT(d_func(), void slotSingleStepChanged(QtProperty *, double))
     Q_PRIVATE_SLOT(d_func(), void slotDecimalsChanged(QtProperty *, int))
     Q_PRIVATE_SLOT(d_func(), void slotSetValue(double))
     Q_PRIVATE_SLOT(d_func(), void slotEditorDestroyed(QObject *))
+    Q_PRIVATE_SLOT(d_func(), void slotAdaptedValueChanged(QtProperty *))
+    Q_PRIVATE_SLOT(d_func(), void slotAdaptedValuesChanged(const QList<QtProperty *> &))
+    Q_PRIVATE_SLOT(d_func(), void slotAdaptedAttributeChanged(QtProperty *))
 };
 
 class QtLineEditFactoryPrivate;
@@ -174,6 +226,10 @@ class QT_QTPROPERTYBROWSER_EXPORT QtLineEditFactory : public QtAbstractEditorFac
 public:
     QtLineEditFactory(QObject *parent = 0);
     ~QtLineEditFactory();
+
+    QWidget *createAdaptedEditor(QtPropertyEditorAdapter *adapter, QtProperty *property,
+                QWidget *parent);
+    void releaseEditor(QWidget *editor);
 protected:
     void connectPropertyManager(QtStringPropertyManager *manager);
     QWidget *createEditor(QtStringPropertyManager *manager, QtProperty *property,
@@ -185,8 +241,12 @@ private:
     Q_DISABLE_COPY(QtLineEditFactory)
     Q_PRIVATE_SLOT(d_func(), void slotPropertyChanged(QtProperty *, const QString &))
     Q_PRIVATE_SLOT(d_func(), void slotRegExpChanged(QtProperty *, const QRegExp &))
+    Q_PRIVATE_SLOT(d_func(), void slotRegularExpressionChanged(QtProperty *, const QRegularExpression &))
     Q_PRIVATE_SLOT(d_func(), void slotSetValue(const QString &))
     Q_PRIVATE_SLOT(d_func(), void slotEditorDestroyed(QObject *))
+    Q_PRIVATE_SLOT(d_func(), void slotAdaptedValueChanged(QtProperty *))
+    Q_PRIVATE_SLOT(d_func(), void slotAdaptedValuesChanged(const QList<QtProperty *> &))
+    Q_PRIVATE_SLOT(d_func(), void slotAdaptedAttributeChanged(QtProperty *))
 };
 
 class QtDateEditFactoryPrivate;
@@ -309,6 +369,8 @@ class QT_QTPROPERTYBROWSER_EXPORT QtEnumEditorFactory : public QtAbstractEditorF
 public:
     QtEnumEditorFactory(QObject *parent = 0);
     ~QtEnumEditorFactory();
+
+    void releaseEditor(QWidget *editor);
 protected:
     void connectPropertyManager(QtEnumPropertyManager *manager);
     QWidget *createEditor(QtEnumPropertyManager *manager, QtProperty *property,
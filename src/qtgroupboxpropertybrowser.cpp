@@ -39,10 +39,11 @@
 
 
 #include "qtgroupboxpropertybrowser.h"
+#include "qtpropertybrowserutils_p.h"
 #include <QtCore/QSet>
 #include <QGridLayout>
-#include <QLabel>
 #include <QGroupBox>
+#include <QFrame>
 #include <QtCore/QTimer>
 #include <QtCore/QMap>
 
@@ -55,12 +56,14 @@ class QtGroupBoxPropertyBrowserPrivate
     QtGroupBoxPropertyBrowser *q_ptr;
     Q_DECLARE_PUBLIC(QtGroupBoxPropertyBrowser)
 public:
+    QtGroupBoxPropertyBrowserPrivate() : m_mainLayout(0), m_updatePending(false) { }
 
     void init(QWidget *parent);
 
     void propertyInserted(QtBrowserItem *index, QtBrowserItem *afterIndex);
     void propertyRemoved(QtBrowserItem *index);
     void propertyChanged(QtBrowserItem *index);
+    void propertiesChanged(const QList<QtBrowserItem *> &indexes);
     QWidget *createEditor(QtProperty *property, QWidget *parent) const
         { return q_ptr->createEditor(property, parent); }
 
@@ -72,8 +75,8 @@ public:
         WidgetItem() : widget(0), label(0), widgetLabel(0),
                 groupBox(0), layout(0), line(0), parent(0) { }
         QWidget *widget; // can be null
-        QLabel *label;
-        QLabel *widgetLabel;
+        QtTextLayoutItem *label; // painted property name
+        QtTextLayoutItem *widgetLabel; // painted value if there is no widget
         QGroupBox *groupBox;
         QGridLayout *layout;
         QFrame *line;
@@ -83,8 +86,8 @@ public:
 private:
     void updateLater();
     void updateItem(WidgetItem *item);
-    void insertRow(QGridLayout *layout, int row) const;
-    void removeRow(QGridLayout *layout, int row) const;
+    void layoutLater(WidgetItem *parentItem);
+    void layoutChildren(WidgetItem *parentItem);
 
     bool hasHeader(WidgetItem *item) const;
 
@@ -94,12 +97,16 @@ private:
     QGridLayout *m_mainLayout;
     QList<WidgetItem *> m_children;
     QList<WidgetItem *> m_recreateQueue;
+    QSet<WidgetItem *> m_layoutQueue; // items whose layout needs a rebuild, 0 for the main layout
+    QSet<WidgetItem *> m_changeQueue; // items changed in a batch, refreshed by slotUpdate()
+    bool m_updatePending;
 };
 
 void QtGroupBoxPropertyBrowserPrivate::init(QWidget *parent)
 {
     m_mainLayout = new QGridLayout();
     parent->setLayout(m_mainLayout);
+    QtTextLayoutItem::installPainter(parent);
     QLayoutItem *item = new QSpacerItem(0, 0,
                 QSizePolicy::Fixed, QSizePolicy::Expanding);
     m_mainLayout->addItem(item, 0, 0);
@@ -118,56 +125,108 @@ void QtGroupBoxPropertyBrowserPrivate::slotEditorDestroyed()
 
 void QtGroupBoxPropertyBrowserPrivate::slotUpdate()
 {
+    m_updatePending = false;
+
     QListIterator<WidgetItem *> itItem(m_recreateQueue);
     while (itItem.hasNext()) {
         WidgetItem *item = itItem.next();
 
         WidgetItem *par = item->parent;
         QWidget *w = 0;
-        QGridLayout *l = 0;
-        int oldRow = -1;
-        if (!par) {
+        if (!par)
             w = q_ptr;
-            l = m_mainLayout;
-            oldRow = m_children.indexOf(item);
-        } else {
+        else
             w = par->groupBox;
-            l = par->layout;
-            oldRow = par->children.indexOf(item);
-            if (hasHeader(par))
-                oldRow += 2;
-        }
 
         if (item->widget) {
             item->widget->setParent(w);
-        } else if (item->widgetLabel) {
-            item->widgetLabel->setParent(w);
         } else {
-            item->widgetLabel = new QLabel(w);
-            item->widgetLabel->setSizePolicy(QSizePolicy(QSizePolicy::Ignored, QSizePolicy::Fixed));
-            item->widgetLabel->setTextFormat(Qt::PlainText);
+            delete item->widgetLabel;
+            item->widgetLabel = new QtTextLayoutItem(w, QSizePolicy::Ignored);
         }
-        int span = 1;
-        if (item->widget)
-            l->addWidget(item->widget, oldRow, 1, 1, 1);
-        else if (item->widgetLabel)
-            l->addWidget(item->widgetLabel, oldRow, 1, 1, 1);
-        else
-            span = 2;
-        item->label = new QLabel(w);
-        item->label->setSizePolicy(QSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed));
-        l->addWidget(item->label, oldRow, 0, 1, span);
+        item->label = new QtTextLayoutItem(w, QSizePolicy::Fixed);
+        m_layoutQueue.insert(par);
 
         updateItem(item);
     }
     m_recreateQueue.clear();
+
+    QSetIterator<WidgetItem *> itLayout(m_layoutQueue);
+    while (itLayout.hasNext())
+        layoutChildren(itLayout.next());
+    m_layoutQueue.clear();
+
+    QSetIterator<WidgetItem *> itChanged(m_changeQueue);
+    while (itChanged.hasNext())
+        updateItem(itChanged.next());
+    m_changeQueue.clear();
 }
 
 void QtGroupBoxPropertyBrowserPrivate::updateLater()
 {
+    if (m_updatePending)
+        return;
+    m_updatePending = true;
     QTimer::singleShot(0, q_ptr, SLOT(slotUpdate()));
 }
 
+void QtGroupBoxPropertyBrowserPrivate::layoutLater(WidgetItem *parentItem)
+{
+    m_layoutQueue.insert(parentItem);
+    updateLater();
+}
+
+// Rebuilds the grid of parentItem (or of the main layout) from its list of
+// children. Insertions and removals only queue the rebuild, so that inserting
+// many rows costs one pass over the layout instead of one shift per row.
+void QtGroupBoxPropertyBrowserPrivate::layoutChildren(WidgetItem *parentItem)
+{
+    QGridLayout *layout = parentItem ? parentItem->layout : m_mainLayout;
+    if (!layout)
+        return;
+
+    // Only the wrappers of widgets are owned by the layout; painted text
+    // items belong to their WidgetItem and are added again below.
+    QList<QLayoutItem *> spacers;
+    while (QLayoutItem *layoutItem = layout->takeAt(0)) {
+        if (layoutItem->spacerItem())
+            spacers.append(layoutItem);
+        else if (layoutItem->widget())
+            delete layoutItem;
+    }
+
+    int row = 0;
+    if (parentItem && hasHeader(parentItem)) {
+        layout->addWidget(parentItem->widget, 0, 0, 1, 2);
+        if (parentItem->line)
+            layout->addWidget(parentItem->line, 1, 0, 1, 2);
+        row = 2;
+    }
+
+    QListIterator<WidgetItem *> itChild(parentItem ? parentItem->children : m_children);
+    while (itChild.hasNext()) {
+        WidgetItem *item = itChild.next();
+        if (item->groupBox) {
+            layout->addWidget(item->groupBox, row, 0, 1, 2);
+        } else {
+            int span = 1;
+            if (item->widget)
+                layout->addWidget(item->widget, row, 1);
+            else if (item->widgetLabel)
+                layout->addItem(item->widgetLabel, row, 1);
+            else
+                span = 2;
+            if (item->label)
+                layout->addItem(item->label, row, 0, 1, span);
+        }
+        row++;
+    }
+
+    QListIterator<QLayoutItem *> itSpacer(spacers);
+    while (itSpacer.hasNext())
+        layout->addItem(itSpacer.next(), row++, 0);
+}
+
 void QtGroupBoxPropertyBrowserPrivate::propertyInserted(QtBrowserItem *index, QtBrowserItem *afterIndex)
 {
     WidgetItem *afterItem = m_indexToItem.value(afterIndex);
@@ -176,99 +235,67 @@ void QtGroupBoxPropertyBrowserPrivate::propertyInserted(QtBrowserItem *index, Qt
     WidgetItem *newItem = new WidgetItem();
     newItem->parent = parentItem;
 
-    QGridLayout *layout = 0;
     QWidget *parentWidget = 0;
-    int row = -1;
     if (!afterItem) {
-        row = 0;
         if (parentItem)
             parentItem->children.insert(0, newItem);
         else
             m_children.insert(0, newItem);
     } else {
-        if (parentItem) {
-            row = parentItem->children.indexOf(afterItem) + 1;
-            parentItem->children.insert(row, newItem);
-        } else {
-            row = m_children.indexOf(afterItem) + 1;
-            m_children.insert(row, newItem);
-        }
+        if (parentItem)
+            parentItem->children.insert(parentItem->children.indexOf(afterItem) + 1, newItem);
+        else
+            m_children.insert(m_children.indexOf(afterItem) + 1, newItem);
     }
-    if (parentItem && hasHeader(parentItem))
-        row += 2;
 
     if (!parentItem) {
-        layout = m_mainLayout;
-        parentWidget = q_ptr;;
+        parentWidget = q_ptr;
     } else {
         if (!parentItem->groupBox) {
             m_recreateQueue.removeAll(parentItem);
             WidgetItem *par = parentItem->parent;
             QWidget *w = 0;
             QGridLayout *l = 0;
-            int oldRow = -1;
             if (!par) {
                 w = q_ptr;
                 l = m_mainLayout;
-                oldRow = m_children.indexOf(parentItem);
             } else {
                 w = par->groupBox;
                 l = par->layout;
-                oldRow = par->children.indexOf(parentItem);
-                if (hasHeader(par))
-                    oldRow += 2;
             }
             parentItem->groupBox = new QGroupBox(w);
             parentItem->layout = new QGridLayout();
             parentItem->groupBox->setLayout(parentItem->layout);
-            if (parentItem->label) {
-                l->removeWidget(parentItem->label);
-                delete parentItem->label;
-                parentItem->label = 0;
-            }
+            QtTextLayoutItem::installPainter(parentItem->groupBox);
+            delete parentItem->label;
+            parentItem->label = 0;
             if (parentItem->widget) {
                 l->removeWidget(parentItem->widget);
                 parentItem->widget->setParent(parentItem->groupBox);
-                parentItem->layout->addWidget(parentItem->widget, 0, 0, 1, 2);
                 parentItem->line = new QFrame(parentItem->groupBox);
-            } else if (parentItem->widgetLabel) {
-                l->removeWidget(parentItem->widgetLabel);
+            } else {
                 delete parentItem->widgetLabel;
                 parentItem->widgetLabel = 0;
             }
             if (parentItem->line) {
                 parentItem->line->setFrameShape(QFrame::HLine);
                 parentItem->line->setFrameShadow(QFrame::Sunken);
-                parentItem->layout->addWidget(parentItem->line, 1, 0, 1, 2);
             }
-            l->addWidget(parentItem->groupBox, oldRow, 0, 1, 2);
+            layoutLater(par);
             updateItem(parentItem);
         }
-        layout = parentItem->layout;
         parentWidget = parentItem->groupBox;
     }
 
-    newItem->label = new QLabel(parentWidget);
-    newItem->label->setSizePolicy(QSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed));
+    newItem->label = new QtTextLayoutItem(parentWidget, QSizePolicy::Fixed);
     newItem->widget = createEditor(index->property(), parentWidget);
     if (!newItem->widget) {
-        newItem->widgetLabel = new QLabel(parentWidget);
-        newItem->widgetLabel->setSizePolicy(QSizePolicy(QSizePolicy::Ignored, QSizePolicy::Fixed));
-        newItem->widgetLabel->setTextFormat(Qt::PlainText);
+        newItem->widgetLabel = new QtTextLayoutItem(parentWidget, QSizePolicy::Ignored);
     } else {
         QObject::connect(newItem->widget, SIGNAL(destroyed()), q_ptr, SLOT(slotEditorDestroyed()));
         m_widgetToItem[newItem->widget] = newItem;
     }
-
-    insertRow(layout, row);
-    int span = 1;
-    if (newItem->widget)
-        layout->addWidget(newItem->widget, row, 1);
-    else if (newItem->widgetLabel)
-        layout->addWidget(newItem->widgetLabel, row, 1);
-    else
-        span = 2;
-    layout->addWidget(newItem->label, row, 0, 1, span);
+    layoutLater(parentItem);
 
     m_itemToIndex[newItem] = index;
     m_indexToItem[index] = newItem;
@@ -285,17 +312,10 @@ void QtGroupBoxPropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
 
     WidgetItem *parentItem = item->parent;
 
-    int row = -1;
-
-    if (parentItem) {
-        row = parentItem->children.indexOf(item);
-        parentItem->children.removeAt(row);
-        if (hasHeader(parentItem))
-            row += 2;
-    } else {
-        row = m_children.indexOf(item);
-        m_children.removeAt(row);
-    }
+    if (parentItem)
+        parentItem->children.removeAll(item);
+    else
+        m_children.removeAll(item);
 
     if (item->widget)
         delete item->widget;
@@ -303,95 +323,43 @@ void QtGroupBoxPropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
         delete item->label;
     if (item->widgetLabel)
         delete item->widgetLabel;
-    if (item->groupBox)
+    if (item->groupBox) {
+        QtTextLayoutItem::clearLayout(item->layout);
         delete item->groupBox;
+    }
 
-    if (!parentItem) {
-        removeRow(m_mainLayout, row);
-    } else if (parentItem->children.count() != 0) {
-        removeRow(parentItem->layout, row);
+    if (!parentItem || parentItem->children.count() != 0) {
+        layoutLater(parentItem);
     } else {
         WidgetItem *par = parentItem->parent;
-        QWidget *w = 0;
         QGridLayout *l = 0;
-        int oldRow = -1;
-        if (!par) {
-            w = q_ptr;
+        if (!par)
             l = m_mainLayout;
-            oldRow = m_children.indexOf(parentItem);
-        } else {
-            w = par->groupBox;
+        else
             l = par->layout;
-            oldRow = par->children.indexOf(parentItem);
-            if (hasHeader(par))
-                oldRow += 2;
-        }
 
         if (parentItem->widget) {
             parentItem->widget->hide();
             parentItem->widget->setParent(0);
-        } else if (parentItem->widgetLabel) {
-            parentItem->widgetLabel->hide();
-            parentItem->widgetLabel->setParent(0);
-        } else {
-            //parentItem->widgetLabel = new QLabel(w);
         }
         l->removeWidget(parentItem->groupBox);
+        QtTextLayoutItem::clearLayout(parentItem->layout);
         delete parentItem->groupBox;
         parentItem->groupBox = 0;
         parentItem->line = 0;
         parentItem->layout = 0;
+        m_layoutQueue.remove(parentItem);
         if (!m_recreateQueue.contains(parentItem))
             m_recreateQueue.append(parentItem);
-        updateLater();
+        layoutLater(par);
     }
     m_recreateQueue.removeAll(item);
+    m_layoutQueue.remove(item);
+    m_changeQueue.remove(item);
 
     delete item;
 }
 
-void QtGroupBoxPropertyBrowserPrivate::insertRow(QGridLayout *layout, int row) const
-{
-    QMap<QLayoutItem *, QRect> itemToPos;
-    int idx = 0;
-    while (idx < layout->count()) {
-        int r, c, rs, cs;
-        layout->getItemPosition(idx, &r, &c, &rs, &cs);
-        if (r >= row) {
-            itemToPos[layout->takeAt(idx)] = QRect(r + 1, c, rs, cs);
-        } else {
-            idx++;
-        }
-    }
-
-    const QMap<QLayoutItem *, QRect>::ConstIterator icend = itemToPos.constEnd();
-    for (QMap<QLayoutItem *, QRect>::ConstIterator it = itemToPos.constBegin(); it != icend; ++it) {
-        const QRect r = it.value();
-        layout->addItem(it.key(), r.x(), r.y(), r.width(), r.height());
-    }
-}
-
-void QtGroupBoxPropertyBrowserPrivate::removeRow(QGridLayout *layout, int row) const
-{
-    QMap<QLayoutItem *, QRect> itemToPos;
-    int idx = 0;
-    while (idx < layout->count()) {
-        int r, c, rs, cs;
-        layout->getItemPosition(idx, &r, &c, &rs, &cs);
-        if (r > row) {
-            itemToPos[layout->takeAt(idx)] = QRect(r - 1, c, rs, cs);
-        } else {
-            idx++;
-        }
-    }
-
-    const QMap<QLayoutItem *, QRect>::ConstIterator icend = itemToPos.constEnd();
-    for (QMap<QLayoutItem *, QRect>::ConstIterator it = itemToPos.constBegin(); it != icend; ++it) {
-        const QRect r = it.value();
-        layout->addItem(it.key(), r.x(), r.y(), r.width(), r.height());
-    }
-}
-
 bool QtGroupBoxPropertyBrowserPrivate::hasHeader(WidgetItem *item) const
 {
     if (item->widget)
@@ -406,6 +374,15 @@ void QtGroupBoxPropertyBrowserPrivate::propertyChanged(QtBrowserItem *index)
     updateItem(item);
 }
 
+// Items changed in a batch are refreshed together on the next update pass.
+void QtGroupBoxPropertyBrowserPrivate::propertiesChanged(const QList<QtBrowserItem *> &indexes)
+{
+    QListIterator<QtBrowserItem *> itIndex(indexes);
+    while (itIndex.hasNext())
+        m_changeQueue.insert(m_indexToItem.value(itIndex.next()));
+    updateLater();
+}
+
 void QtGroupBoxPropertyBrowserPrivate::updateItem(WidgetItem *item)
 {
     QtProperty *property = m_itemToIndex[item]->property();
@@ -420,9 +397,7 @@ void QtGroupBoxPropertyBrowserPrivate::updateItem(WidgetItem *item)
         item->groupBox->setEnabled(property->isEnabled());
     }
     if (item->label) {
-        QFont font = item->label->font();
-        font.setUnderline(property->isModified());
-        item->label->setFont(font);
+        item->label->setUnderline(property->isModified());
         item->label->setText(property->propertyName());
         item->label->setToolTip(property->toolTip());
         item->label->setStatusTip(property->statusTip());
@@ -430,9 +405,6 @@ void QtGroupBoxPropertyBrowserPrivate::updateItem(WidgetItem *item)
         item->label->setEnabled(property->isEnabled());
     }
     if (item->widgetLabel) {
-        QFont font = item->widgetLabel->font();
-        font.setUnderline(false);
-        item->widgetLabel->setFont(font);
         item->widgetLabel->setText(property->valueText());
         item->widgetLabel->setToolTip(property->valueText());
         item->widgetLabel->setEnabled(property->isEnabled());
@@ -499,9 +471,20 @@ QtGroupBoxPropertyBrowser::QtGroupBoxPropertyBrowser(QWidget *parent)
 */
 QtGroupBoxPropertyBrowser::~QtGroupBoxPropertyBrowser()
 {
-    const QMap<QtGroupBoxPropertyBrowserPrivate::WidgetItem *, QtBrowserItem *>::ConstIterator icend = d_ptr->m_itemToIndex.constEnd();
-    for (QMap<QtGroupBoxPropertyBrowserPrivate::WidgetItem *, QtBrowserItem *>::ConstIterator it = d_ptr->m_itemToIndex.constBegin(); it != icend; ++it)
+    // The text items belong to the widget items. Take them out of the
+    // layouts first, so that deleting the hosts does not delete them again.
+    typedef QMap<QtGroupBoxPropertyBrowserPrivate::WidgetItem *, QtBrowserItem *> ItemToIndexMap;
+    const ItemToIndexMap::ConstIterator icend = d_ptr->m_itemToIndex.constEnd();
+    QtTextLayoutItem::clearLayout(d_ptr->m_mainLayout);
+    for (ItemToIndexMap::ConstIterator it = d_ptr->m_itemToIndex.constBegin(); it != icend; ++it) {
+        if (it.key()->layout)
+            QtTextLayoutItem::clearLayout(it.key()->layout);
+    }
+    for (ItemToIndexMap::ConstIterator it = d_ptr->m_itemToIndex.constBegin(); it != icend; ++it) {
+        delete it.key()->label;
+        delete it.key()->widgetLabel;
         delete it.key();
+    }
     delete d_ptr;
 }
 
@@ -529,6 +512,14 @@ void QtGroupBoxPropertyBrowser::itemChanged(QtBrowserItem *item)
     d_ptr->propertyChanged(item);
 }
 
+/*!
+    \reimp
+*/
+void QtGroupBoxPropertyBrowser::itemsChanged(const QList<QtBrowserItem *> &items)
+{
+    d_ptr->propertiesChanged(items);
+}
+
 #if QT_VERSION >= 0x040400
 QT_END_NAMESPACE
 #endif
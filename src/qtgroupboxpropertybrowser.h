@@ -61,6 +61,7 @@ protected:
     virtual void itemInserted(QtBrowserItem *item, QtBrowserItem *afterItem);
     virtual void itemRemoved(QtBrowserItem *item);
     virtual void itemChanged(QtBrowserItem *item);
+    virtual void itemsChanged(const QList<QtBrowserItem *> &items);
 
 private:
 
@@ -41,7 +41,10 @@
 #include "qtpropertybrowser.h"
 #include <QtCore/QSet>
 #include <QtCore/QMap>
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
 #include <QtGui/QIcon>
+#include <QWidget>
 
 #if defined(Q_CC_MSVC)
 #    pragma warning(disable: 4786) /* MS VS 6: truncating debug info after 255 characters */
@@ -646,6 +649,17 @@ void QtAbstractPropertyManagerPrivate::propertyInserted(QtProperty *property,
     \sa QtAbstractPropertyBrowser::itemChanged()
 */
 
+/*!
+    \fn void QtAbstractPropertyManager::propertiesChanged(const QList<QtProperty *> &properties)
+
+    This signal is emitted when the data of several \a properties
+    changes in one batch, for example by
+    QtDoublePropertyManager::setValues(). It replaces the
+    propertyChanged() signal for each of the \a properties.
+
+    \sa propertyChanged()
+*/
+
 /*!
     \fn void QtAbstractPropertyManager::propertyRemoved(QtProperty *property, QtProperty *parent)
 
@@ -767,6 +781,32 @@ QString QtAbstractPropertyManager::valueText(const QtProperty *property) const
     return QString();
 }
 
+/*!
+    Returns whether the given \a property has subproperties that the
+    manager has not created yet.
+
+    The default implementation of this function returns false.
+
+    \sa createDeferredSubProperties(), QtAbstractPropertyBrowser::hasDeferredSubProperties()
+*/
+bool QtAbstractPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
+{
+    Q_UNUSED(property)
+    return false;
+}
+
+/*!
+    Creates the deferred subproperties of the given \a property.
+
+    The default implementation of this function does nothing.
+
+    \sa hasDeferredSubProperties(), QtAbstractPropertyBrowser::createDeferredSubProperties()
+*/
+void QtAbstractPropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    Q_UNUSED(property)
+}
+
 /*!
     Creates a property with the given \a name which then is owned by this manager.
 
@@ -893,6 +933,28 @@ void QtAbstractPropertyManager::uninitializeProperty(QtProperty *property)
     \sa QtAbstractPropertyManager, QtAbstractPropertyBrowser
 */
 
+/*!
+    \enum QtAbstractEditorFactoryBase::CommitPolicy
+
+    The commit policy specifies when a factory whose editors change
+    continuously (e.g. sliders being dragged) writes the edited value
+    back to the property manager.
+
+    \value ImmediateCommit Every change made in the editor is written
+    to the manager at once.
+
+    \value ThrottledCommit Changes are written at most once per commit
+    interval. The last value is always written when the interval
+    expires.
+
+    \value CommitOnRelease Changes are held back while the user is
+    still dragging or editing, and written when the slider is released
+    or, for spin boxes, when editingFinished() is emitted.
+
+    \sa QtSpinBoxFactory::setCommitPolicy(), QtSliderFactory::setCommitPolicy(),
+    QtScrollBarFactory::setCommitPolicy()
+*/
+
 /*!
     \fn virtual QWidget *QtAbstractEditorFactoryBase::createEditor(QtProperty *property,
         QWidget *parent) = 0
@@ -907,6 +969,42 @@ void QtAbstractPropertyManager::uninitializeProperty(QtProperty *property)
     \sa  QtAbstractEditorFactory::createEditor()
 */
 
+/*!
+    \internal
+
+    Creates an editing widget (with the given \a parent) for a \a
+    property whose manager is not known to this factory. The \a adapter
+    supplies the property's value and attributes and takes the edited
+    values. Editors created this way are released like any other.
+
+    The default implementation returns 0.
+*/
+QWidget *QtAbstractEditorFactoryBase::createAdaptedEditor(QtPropertyEditorAdapter *adapter,
+            QtProperty *property, QWidget *parent)
+{
+    Q_UNUSED(adapter)
+    Q_UNUSED(property)
+    Q_UNUSED(parent)
+    return 0;
+}
+
+/*!
+    Releases the given \a editor, which was created by this factory and
+    is no longer shown by the property browser that requested it.
+
+    The default implementation hides the editor and deletes it
+    later. Reimplement this function to keep the widget for reuse by a
+    subsequent createEditor() call; the editor must then no longer be
+    associated with its previous property.
+
+    \sa QtAbstractPropertyBrowser::releaseEditor()
+*/
+void QtAbstractEditorFactoryBase::releaseEditor(QWidget *editor)
+{
+    editor->hide();
+    editor->deleteLater();
+}
+
 /*!
     \fn QtAbstractEditorFactoryBase::QtAbstractEditorFactoryBase(QObject *parent = 0)
 
@@ -1270,6 +1368,8 @@ public:
     void slotPropertyRemoved(QtProperty *property, QtProperty *parentProperty);
     void slotPropertyDestroyed(QtProperty *property);
     void slotPropertyDataChanged(QtProperty *property);
+    void slotPropertiesDataChanged(const QList<QtProperty *> &properties);
+    void slotEditorDestroyed(QObject *object);
 
     QList<QtProperty *> m_subItems;
     QMap<QtAbstractPropertyManager *, QList<QtProperty *> > m_managerToProperties;
@@ -1279,11 +1379,17 @@ public:
     QList<QtBrowserItem *> m_topLevelIndexes;
     QMap<QtProperty *, QList<QtBrowserItem *> > m_propertyToIndexes;
 
+    // Factory of every editor handed out by createEditor(), so that
+    // releaseEditor() can give the editor back for reuse.
+    QHash<QWidget *, QPointer<QtAbstractEditorFactoryBase> > m_editorToFactory;
+
     QtBrowserItem *m_currentItem;
+    bool m_deferSubProperties;
 };
 
 QtAbstractPropertyBrowserPrivate::QtAbstractPropertyBrowserPrivate() :
-   m_currentItem(0)
+   m_currentItem(0),
+   m_deferSubProperties(false)
 {
 }
 
@@ -1313,6 +1419,8 @@ void QtAbstractPropertyBrowserPrivate::insertSubTree(QtProperty *property,
                 q_ptr, SLOT(slotPropertyDestroyed(QtProperty *)));
         q_ptr->connect(manager, SIGNAL(propertyChanged(QtProperty *)),
                 q_ptr, SLOT(slotPropertyDataChanged(QtProperty *)));
+        q_ptr->connect(manager, SIGNAL(propertiesChanged(QList<QtProperty *>)),
+                q_ptr, SLOT(slotPropertiesDataChanged(QList<QtProperty *>)));
     }
     m_managerToProperties[manager].append(property);
     m_propertyToParents[property].append(parentProperty);
@@ -1353,6 +1461,8 @@ void QtAbstractPropertyBrowserPrivate::removeSubTree(QtProperty *property,
                 q_ptr, SLOT(slotPropertyDestroyed(QtProperty *)));
         q_ptr->disconnect(manager, SIGNAL(propertyChanged(QtProperty *)),
                 q_ptr, SLOT(slotPropertyDataChanged(QtProperty *)));
+        q_ptr->disconnect(manager, SIGNAL(propertiesChanged(QList<QtProperty *>)),
+                q_ptr, SLOT(slotPropertiesDataChanged(QList<QtProperty *>)));
 
         m_managerToProperties.remove(manager);
     }
@@ -1406,6 +1516,12 @@ void QtAbstractPropertyBrowserPrivate::createBrowserIndexes(QtProperty *property
 QtBrowserItem *QtAbstractPropertyBrowserPrivate::createBrowserIndex(QtProperty *property,
         QtBrowserItem *parentIndex, QtBrowserItem *afterIndex)
 {
+    // Browsers which cannot expand on demand get all subproperties up
+    // front. The property is not connected yet, so the insertions are
+    // only picked up by the loop below.
+    if (!m_deferSubProperties && q_ptr->hasDeferredSubProperties(property))
+        q_ptr->createDeferredSubProperties(property);
+
     QtBrowserItem *newIndex = new QtBrowserItem(q_ptr, property, parentIndex);
     if (parentIndex) {
         parentIndex->d_ptr->addChild(newIndex, afterIndex);
@@ -1417,12 +1533,24 @@ QtBrowserItem *QtAbstractPropertyBrowserPrivate::createBrowserIndex(QtProperty *
 
     q_ptr->itemInserted(newIndex, afterIndex);
 
+    // itemInserted() may have created deferred subproperties; if the
+    // property is shown elsewhere in this browser already, those got
+    // their items through slotPropertyInserted().
+    const QList<QtBrowserItem *> insertedChildren = newIndex->children();
+
     QList<QtProperty *> subItems = property->subProperties();
     QListIterator<QtProperty *> itChild(subItems);
     QtBrowserItem *afterChild = 0;
     while (itChild.hasNext()) {
         QtProperty *child = itChild.next();
-        afterChild = createBrowserIndex(child, newIndex, afterChild);
+        QtBrowserItem *childIndex = 0;
+        QListIterator<QtBrowserItem *> itInserted(insertedChildren);
+        while (!childIndex && itInserted.hasNext()) {
+            QtBrowserItem *idx = itInserted.next();
+            if (idx->property() == child)
+                childIndex = idx;
+        }
+        afterChild = childIndex ? childIndex : createBrowserIndex(child, newIndex, afterChild);
     }
     return newIndex;
 }
@@ -1532,6 +1660,24 @@ void QtAbstractPropertyBrowserPrivate::slotPropertyDataChanged(QtProperty *prope
     //q_ptr->propertyChanged(property);
 }
 
+void QtAbstractPropertyBrowserPrivate::slotPropertiesDataChanged(const QList<QtProperty *> &properties)
+{
+    QList<QtBrowserItem *> items;
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext()) {
+        QtProperty *property = itProperty.next();
+        if (m_propertyToParents.contains(property))
+            items += m_propertyToIndexes.value(property);
+    }
+    if (!items.isEmpty())
+        q_ptr->itemsChanged(items);
+}
+
+void QtAbstractPropertyBrowserPrivate::slotEditorDestroyed(QObject *object)
+{
+    m_editorToFactory.remove(static_cast<QWidget *>(object));
+}
+
 /*!
     \class QtAbstractPropertyBrowser
 
@@ -1724,8 +1870,25 @@ void QtAbstractPropertyBrowserPrivate::slotPropertyDataChanged(QtProperty *prope
     the same property, this method will be called once for each
     occurrence (with a different item each time).
 
-    \sa QtProperty, items()
+    \sa QtProperty, items(), itemsChanged()
+*/
+
+/*!
+    This function is called when the data of several properties changes
+    in one batch, passing the \a items of the properties as parameter.
+
+    The default implementation calls itemChanged() for each item.
+    Reimplement it to refresh the property browser widget once for
+    the whole batch.
+
+    \sa itemChanged(), QtAbstractPropertyManager::propertiesChanged()
 */
+void QtAbstractPropertyBrowser::itemsChanged(const QList<QtBrowserItem *> &items)
+{
+    QListIterator<QtBrowserItem *> itItem(items);
+    while (itItem.hasNext())
+        itemChanged(itItem.next());
+}
 
 /*!
     Creates an abstract property browser with the given \a parent.
@@ -1930,6 +2093,46 @@ void QtAbstractPropertyBrowser::removeProperty(QtProperty *property)
     }
 }
 
+/*!
+    Sets whether the browser creates deferred subproperties itself, when
+    their parent property is expanded, to \a defer.
+
+    By default, the browser creates the deferred subproperties of every
+    property it shows when the property is inserted. Browsers that set
+    \a defer to true must call createDeferredSubProperties() when the
+    user expands a property with deferred subproperties.
+
+    \sa hasDeferredSubProperties()
+*/
+void QtAbstractPropertyBrowser::setDeferSubProperties(bool defer)
+{
+    d_ptr->m_deferSubProperties = defer;
+}
+
+/*!
+    Returns whether the manager of the given \a property has not
+    created all of its subproperties yet. Browsers show such a property
+    as expandable.
+
+    \sa setDeferSubProperties(), QtAbstractPropertyManager::hasDeferredSubProperties()
+*/
+bool QtAbstractPropertyBrowser::hasDeferredSubProperties(QtProperty *property) const
+{
+    return property->propertyManager()->hasDeferredSubProperties(property);
+}
+
+/*!
+    Asks the manager of the given \a property to create its deferred
+    subproperties. They are added as usual, so the browser is notified
+    of each of them through itemInserted().
+
+    \sa setDeferSubProperties(), QtAbstractPropertyManager::createDeferredSubProperties()
+*/
+void QtAbstractPropertyBrowser::createDeferredSubProperties(QtProperty *property)
+{
+    property->propertyManager()->createDeferredSubProperties(property);
+}
+
 /*!
     Creates an editing widget (with the given \a parent) for the given
     \a property according to the previously established associations
@@ -1961,7 +2164,42 @@ QWidget *QtAbstractPropertyBrowser::createEditor(QtProperty *property,
 
     if (!factory)
         return 0;
-    return factory->createEditor(property, parent);
+    QWidget *editor = factory->createEditor(property, parent);
+    if (editor && !d_ptr->m_editorToFactory.contains(editor)) {
+        d_ptr->m_editorToFactory.insert(editor, factory);
+        connect(editor, SIGNAL(destroyed(QObject *)), this, SLOT(slotEditorDestroyed(QObject *)));
+    }
+    return editor;
+}
+
+/*!
+    Releases the given \a editor, which was returned by createEditor()
+    and is no longer shown by this browser.
+
+    The editor is handed back to the factory that created it, which
+    may keep it and return it again from a later createEditor() call
+    for another property. Editors that were not created by a factory
+    (e.g. decorations added by a reimplemented createEditor()) are
+    hidden and deleted later.
+
+    Browsers that destroy and recreate editors frequently, for example
+    while scrolling, should call this function instead of deleting the
+    editors themselves.
+
+    \sa QtAbstractEditorFactoryBase::releaseEditor()
+*/
+void QtAbstractPropertyBrowser::releaseEditor(QWidget *editor)
+{
+    if (!editor)
+        return;
+    const QPointer<QtAbstractEditorFactoryBase> factory = d_ptr->m_editorToFactory.take(editor);
+    disconnect(editor, SIGNAL(destroyed(QObject *)), this, SLOT(slotEditorDestroyed(QObject *)));
+    if (factory) {
+        factory->releaseEditor(editor);
+        return;
+    }
+    editor->hide();
+    editor->deleteLater();
 }
 
 bool QtAbstractPropertyBrowser::addFactory(QtAbstractPropertyManager *abstractManager,
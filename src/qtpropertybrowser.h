@@ -67,6 +67,7 @@ QT_BEGIN_NAMESPACE
 
 class QtAbstractPropertyManager;
 class QtPropertyPrivate;
+class QtPropertyEditorAdapter;
 
 class QT_QTPROPERTYBROWSER_EXPORT QtProperty
 {
@@ -131,17 +132,22 @@ Q_SIGNALS:
     void propertyInserted(QtProperty *property,
                 QtProperty *parent, QtProperty *after);
     void propertyChanged(QtProperty *property);
+    void propertiesChanged(const QList<QtProperty *> &properties);
     void propertyRemoved(QtProperty *property, QtProperty *parent);
     void propertyDestroyed(QtProperty *property);
 protected:
     virtual bool hasValue(const QtProperty *property) const;
     virtual QIcon valueIcon(const QtProperty *property) const;
     virtual QString valueText(const QtProperty *property) const;
+    virtual bool hasDeferredSubProperties(const QtProperty *property) const;
+    virtual void createDeferredSubProperties(QtProperty *property);
     virtual void initializeProperty(QtProperty *property) = 0;
     virtual void uninitializeProperty(QtProperty *property);
     virtual QtProperty *createProperty();
 private:
     friend class QtProperty;
+    friend class QtAbstractPropertyBrowser;
+    friend class QtVariantPropertyManager;
     QtAbstractPropertyManagerPrivate *d_ptr;
     Q_DECLARE_PRIVATE(QtAbstractPropertyManager)
     Q_DISABLE_COPY(QtAbstractPropertyManager)
@@ -151,7 +157,17 @@ class QT_QTPROPERTYBROWSER_EXPORT QtAbstractEditorFactoryBase : public QObject
 {
     Q_OBJECT
 public:
+    enum CommitPolicy
+    {
+        ImmediateCommit,
+        ThrottledCommit,
+        CommitOnRelease
+    };
+
     virtual QWidget *createEditor(QtProperty *property, QWidget *parent) = 0;
+    virtual QWidget *createAdaptedEditor(QtPropertyEditorAdapter *adapter, QtProperty *property,
+                QWidget *parent);
+    virtual void releaseEditor(QWidget *editor);
 protected:
     explicit QtAbstractEditorFactoryBase(QObject *parent = 0)
         : QObject(parent) {}
@@ -309,8 +325,14 @@ protected:
     virtual void itemRemoved(QtBrowserItem *item) = 0;
     // can be tooltip, statustip, whatsthis, name, icon, text.
     virtual void itemChanged(QtBrowserItem *item) = 0;
+    virtual void itemsChanged(const QList<QtBrowserItem *> &items);
 
     virtual QWidget *createEditor(QtProperty *property, QWidget *parent);
+    void releaseEditor(QWidget *editor);
+
+    void setDeferSubProperties(bool defer);
+    bool hasDeferredSubProperties(QtProperty *property) const;
+    void createDeferredSubProperties(QtProperty *property);
 private:
 
     bool addFactory(QtAbstractPropertyManager *abstractManager,
@@ -325,6 +347,8 @@ private:
                             QtProperty *))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyDataChanged(QtProperty *))
+    Q_PRIVATE_SLOT(d_func(), void slotPropertiesDataChanged(const QList<QtProperty *> &))
+    Q_PRIVATE_SLOT(d_func(), void slotEditorDestroyed(QObject *))
 
 };
 
@@ -39,6 +39,7 @@
 
 
 #include "qtpropertybrowserutils_p.h"
+#include "qtpropertybrowser.h"
 #include <QApplication>
 #include <QPainter>
 #include <QHBoxLayout>
@@ -46,53 +47,91 @@
 #include <QCheckBox>
 #include <QLineEdit>
 #include <QMenu>
+#include <QStyle>
 #include <QStyleOption>
+#include <QLayout>
+#include <QPaintEvent>
+#include <QHelpEvent>
+#include <QStatusTipEvent>
+#include <QToolTip>
+#include <QWhatsThis>
+#include <QtCore/QCache>
+#include <QtCore/QHash>
+
+#include <algorithm>
 
 #if QT_VERSION >= 0x040400
 QT_BEGIN_NAMESPACE
 #endif
 
-QtCursorDatabase::QtCursorDatabase()
-{
-    appendCursor(Qt::ArrowCursor, QApplication::translate("QtCursorDatabase", "Arrow", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-arrow.png")));
-    appendCursor(Qt::UpArrowCursor, QApplication::translate("QtCursorDatabase", "Up Arrow", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-uparrow.png")));
-    appendCursor(Qt::CrossCursor, QApplication::translate("QtCursorDatabase", "Cross", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-cross.png")));
-    appendCursor(Qt::WaitCursor, QApplication::translate("QtCursorDatabase", "Wait", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-wait.png")));
-    appendCursor(Qt::IBeamCursor, QApplication::translate("QtCursorDatabase", "IBeam", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-ibeam.png")));
-    appendCursor(Qt::SizeVerCursor, QApplication::translate("QtCursorDatabase", "Size Vertical", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-sizev.png")));
-    appendCursor(Qt::SizeHorCursor, QApplication::translate("QtCursorDatabase", "Size Horizontal", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-sizeh.png")));
-    appendCursor(Qt::SizeFDiagCursor, QApplication::translate("QtCursorDatabase", "Size Backslash", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-sizef.png")));
-    appendCursor(Qt::SizeBDiagCursor, QApplication::translate("QtCursorDatabase", "Size Slash", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-sizeb.png")));
-    appendCursor(Qt::SizeAllCursor, QApplication::translate("QtCursorDatabase", "Size All", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-sizeall.png")));
-    appendCursor(Qt::BlankCursor, QApplication::translate("QtCursorDatabase", "Blank", 0), QIcon());
-    appendCursor(Qt::SplitVCursor, QApplication::translate("QtCursorDatabase", "Split Vertical", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-vsplit.png")));
-    appendCursor(Qt::SplitHCursor, QApplication::translate("QtCursorDatabase", "Split Horizontal", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-hsplit.png")));
-    appendCursor(Qt::PointingHandCursor, QApplication::translate("QtCursorDatabase", "Pointing Hand", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-hand.png")));
-    appendCursor(Qt::ForbiddenCursor, QApplication::translate("QtCursorDatabase", "Forbidden", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-forbidden.png")));
-    appendCursor(Qt::OpenHandCursor, QApplication::translate("QtCursorDatabase", "Open Hand", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-openhand.png")));
-    appendCursor(Qt::ClosedHandCursor, QApplication::translate("QtCursorDatabase", "Closed Hand", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-closedhand.png")));
-    appendCursor(Qt::WhatsThisCursor, QApplication::translate("QtCursorDatabase", "What's This", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-whatsthis.png")));
-    appendCursor(Qt::BusyCursor, QApplication::translate("QtCursorDatabase", "Busy", 0), QIcon(QLatin1String(":/trolltech/qtpropertybrowser/images/cursor-busy.png")));
-}
-
-void QtCursorDatabase::appendCursor(Qt::CursorShape shape, const QString &name, const QIcon &icon)
-{
-    if (m_cursorShapeToValue.contains(shape))
-        return;
-    int value = m_cursorNames.count();
-    m_cursorNames.append(name);
-    m_cursorIcons[value] = icon;
-    m_valueToCursorShape[value] = shape;
-    m_cursorShapeToValue[shape] = value;
+struct QtCursorEntry
+{
+    Qt::CursorShape shape;
+    const char *name;
+    const char *iconFileName;
+};
+
+static const QtCursorEntry cursorEntries[] = {
+    { Qt::ArrowCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Arrow"), ":/trolltech/qtpropertybrowser/images/cursor-arrow.png" },
+    { Qt::UpArrowCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Up Arrow"), ":/trolltech/qtpropertybrowser/images/cursor-uparrow.png" },
+    { Qt::CrossCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Cross"), ":/trolltech/qtpropertybrowser/images/cursor-cross.png" },
+    { Qt::WaitCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Wait"), ":/trolltech/qtpropertybrowser/images/cursor-wait.png" },
+    { Qt::IBeamCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "IBeam"), ":/trolltech/qtpropertybrowser/images/cursor-ibeam.png" },
+    { Qt::SizeVerCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Size Vertical"), ":/trolltech/qtpropertybrowser/images/cursor-sizev.png" },
+    { Qt::SizeHorCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Size Horizontal"), ":/trolltech/qtpropertybrowser/images/cursor-sizeh.png" },
+    { Qt::SizeFDiagCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Size Backslash"), ":/trolltech/qtpropertybrowser/images/cursor-sizef.png" },
+    { Qt::SizeBDiagCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Size Slash"), ":/trolltech/qtpropertybrowser/images/cursor-sizeb.png" },
+    { Qt::SizeAllCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Size All"), ":/trolltech/qtpropertybrowser/images/cursor-sizeall.png" },
+    { Qt::BlankCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Blank"), 0 },
+    { Qt::SplitVCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Split Vertical"), ":/trolltech/qtpropertybrowser/images/cursor-vsplit.png" },
+    { Qt::SplitHCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Split Horizontal"), ":/trolltech/qtpropertybrowser/images/cursor-hsplit.png" },
+    { Qt::PointingHandCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Pointing Hand"), ":/trolltech/qtpropertybrowser/images/cursor-hand.png" },
+    { Qt::ForbiddenCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Forbidden"), ":/trolltech/qtpropertybrowser/images/cursor-forbidden.png" },
+    { Qt::OpenHandCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Open Hand"), ":/trolltech/qtpropertybrowser/images/cursor-openhand.png" },
+    { Qt::ClosedHandCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Closed Hand"), ":/trolltech/qtpropertybrowser/images/cursor-closedhand.png" },
+    { Qt::WhatsThisCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "What's This"), ":/trolltech/qtpropertybrowser/images/cursor-whatsthis.png" },
+    { Qt::BusyCursor, QT_TRANSLATE_NOOP("QtCursorDatabase", "Busy"), ":/trolltech/qtpropertybrowser/images/cursor-busy.png" }
+};
+
+static const int cursorEntryCount = sizeof(cursorEntries) / sizeof(cursorEntries[0]);
+
+QtCursorDatabase::QtCursorDatabase() :
+    m_cursorIconsLoaded(false)
+{
+    for (int value = 0; value < cursorEntryCount; value++) {
+        m_valueToCursorShape[value] = cursorEntries[value].shape;
+        m_cursorShapeToValue[cursorEntries[value].shape] = value;
+    }
 }
 
 QStringList QtCursorDatabase::cursorShapeNames() const
 {
+    if (m_cursorNames.isEmpty()) {
+        for (int i = 0; i < cursorEntryCount; i++)
+            m_cursorNames.append(QApplication::translate("QtCursorDatabase", cursorEntries[i].name, 0));
+    }
     return m_cursorNames;
 }
 
+QIcon QtCursorDatabase::cursorIcon(int value) const
+{
+    if (value < 0 || value >= cursorEntryCount)
+        return QIcon();
+    QMap<int, QIcon>::ConstIterator it = m_cursorIcons.constFind(value);
+    if (it == m_cursorIcons.constEnd()) {
+        const char *fileName = cursorEntries[value].iconFileName;
+        it = m_cursorIcons.insert(value, fileName ? QIcon(QLatin1String(fileName)) : QIcon());
+    }
+    return it.value();
+}
+
 QMap<int, QIcon> QtCursorDatabase::cursorShapeIcons() const
 {
+    if (!m_cursorIconsLoaded) {
+        for (int i = 0; i < cursorEntryCount; i++)
+            cursorIcon(i);
+        m_cursorIconsLoaded = true;
+    }
     return m_cursorIcons;
 }
 
@@ -100,14 +139,13 @@ QString QtCursorDatabase::cursorToShapeName(const QCursor &cursor) const
 {
     int val = cursorToValue(cursor);
     if (val >= 0)
-        return m_cursorNames.at(val);
+        return cursorShapeNames().at(val);
     return QString();
 }
 
 QIcon QtCursorDatabase::cursorToShapeIcon(const QCursor &cursor) const
 {
-    int val = cursorToValue(cursor);
-    return m_cursorIcons.value(val);
+    return cursorIcon(cursorToValue(cursor));
 }
 
 int QtCursorDatabase::cursorToValue(const QCursor &cursor) const
@@ -129,7 +167,472 @@ QCursor QtCursorDatabase::valueToCursor(int value) const
 }
 #endif
 
-QPixmap QtPropertyBrowserUtils::brushValuePixmap(const QBrush &b)
+// Each segment of an item path is the property id, falling back to the
+// property name, so that a rebuilt tree maps onto the same paths.
+QString QtExpandStateStore::pathKey(QtBrowserItem *item)
+{
+    const QtProperty *property = item->property();
+    const QString id = property->propertyId();
+    return id.isEmpty() ? property->propertyName() : id;
+}
+
+QString QtExpandStateStore::itemPath(QtBrowserItem *item) const
+{
+    if (!item)
+        return QString();
+
+    QHash<QtBrowserItem *, QString>::ConstIterator it = m_itemToPath.constFind(item);
+    if (it != m_itemToPath.constEnd())
+        return it.value();
+
+    QString path = pathKey(item);
+    if (QtBrowserItem *parent = item->parent())
+        path = itemPath(parent) + QLatin1Char('/') + path;
+    m_itemToPath.insert(item, path);
+    return path;
+}
+
+bool QtExpandStateStore::isExpanded(QtBrowserItem *item, bool defaultValue) const
+{
+    if (m_pathToExpanded.isEmpty())
+        return defaultValue;
+    return m_pathToExpanded.value(itemPath(item), defaultValue);
+}
+
+void QtExpandStateStore::setExpanded(QtBrowserItem *item, bool expanded)
+{
+    if (!item)
+        return;
+    m_pathToExpanded.insert(itemPath(item), expanded);
+}
+
+void QtExpandStateStore::itemChanged(QtBrowserItem *item)
+{
+    if (!m_itemToPath.contains(item))
+        return;
+    const QString cachedPath = m_itemToPath.value(item);
+    QString path = pathKey(item);
+    if (QtBrowserItem *parent = item->parent())
+        path = itemPath(parent) + QLatin1Char('/') + path;
+    if (cachedPath != path)
+        invalidatePath(item);
+}
+
+void QtExpandStateStore::itemRemoved(QtBrowserItem *item)
+{
+    m_itemToPath.remove(item);
+}
+
+void QtExpandStateStore::invalidatePath(QtBrowserItem *item)
+{
+    if (!m_itemToPath.remove(item))
+        return;
+    QListIterator<QtBrowserItem *> itChild(item->children());
+    while (itChild.hasNext())
+        invalidatePath(itChild.next());
+}
+
+// Installed on the host of text layout items; paints the items and serves
+// their tool tips, status tips and "What's This?" texts. The items of the
+// host are kept ordered by their geometry, so that paint and help events
+// only visit the rows they hit. The host tracks the mouse only while one of
+// its items has a status tip to show. The painter is a child of its host and
+// is deleted with it.
+class QtTextItemPainter : public QObject
+{
+    Q_OBJECT
+public:
+    QtTextItemPainter(QWidget *host);
+    ~QtTextItemPainter();
+
+    static QtTextItemPainter *painter(const QWidget *host);
+
+    void addItem(QtTextLayoutItem *item);
+    void removeItem(QtTextLayoutItem *item);
+    void itemMoved() { m_sorted = false; }
+    void statusTipChanged(bool hasStatusTip);
+
+    bool eventFilter(QObject *object, QEvent *event);
+private:
+    typedef QList<QtTextLayoutItem *> ItemList;
+
+    ItemList::ConstIterator firstItemBelow(int y);
+    QtTextLayoutItem *itemAt(const QPoint &pos);
+
+    QWidget *m_host;
+    ItemList m_items; // ordered by the bottom of their geometry when m_sorted
+    bool m_sorted;
+    int m_statusTipCount;
+    bool m_trackingMouse;
+    QString m_statusTip;
+};
+
+static bool textItemLessThan(const QtTextLayoutItem *item1, const QtTextLayoutItem *item2)
+{
+    return item1->geometry().bottom() < item2->geometry().bottom();
+}
+
+static bool textItemAbove(const QtTextLayoutItem *item, int y)
+{
+    return item->geometry().bottom() < y;
+}
+
+QtTextItemPainter::QtTextItemPainter(QWidget *host)
+    : QObject(host), m_host(host), m_sorted(true), m_statusTipCount(0), m_trackingMouse(false)
+{
+    host->installEventFilter(this);
+}
+
+QtTextItemPainter::~QtTextItemPainter()
+{
+    QListIterator<QtTextLayoutItem *> itItem(m_items);
+    while (itItem.hasNext())
+        itItem.next()->m_painter = 0;
+}
+
+QtTextItemPainter *QtTextItemPainter::painter(const QWidget *host)
+{
+    return host->findChild<QtTextItemPainter *>(QString(), Qt::FindDirectChildrenOnly);
+}
+
+void QtTextItemPainter::addItem(QtTextLayoutItem *item)
+{
+    m_items.append(item);
+    m_sorted = false;
+    if (!item->statusTip().isEmpty())
+        statusTipChanged(true);
+}
+
+void QtTextItemPainter::removeItem(QtTextLayoutItem *item)
+{
+    if (!item->statusTip().isEmpty())
+        statusTipChanged(false);
+    if (!m_sorted) {
+        m_items.removeOne(item);
+        return;
+    }
+    const ItemList::ConstIterator cend = m_items.constEnd();
+    for (ItemList::ConstIterator it = firstItemBelow(item->geometry().bottom()); it != cend; ++it) {
+        if (*it == item) {
+            m_items.removeAt(it - m_items.constBegin());
+            return;
+        }
+    }
+}
+
+// Turns mouse tracking on for the first status tip and off again after
+// the last one, unless the host tracked the mouse already.
+void QtTextItemPainter::statusTipChanged(bool hasStatusTip)
+{
+    m_statusTipCount += hasStatusTip ? 1 : -1;
+    if (m_statusTipCount > 0) {
+        if (m_trackingMouse || m_host->hasMouseTracking())
+            return;
+        m_trackingMouse = true;
+        m_host->setMouseTracking(true);
+    } else if (m_trackingMouse) {
+        m_trackingMouse = false;
+        m_host->setMouseTracking(false);
+    }
+}
+
+QtTextItemPainter::ItemList::ConstIterator QtTextItemPainter::firstItemBelow(int y)
+{
+    if (!m_sorted) {
+        std::sort(m_items.begin(), m_items.end(), textItemLessThan);
+        m_sorted = true;
+    }
+    return std::lower_bound(m_items.constBegin(), m_items.constEnd(), y, textItemAbove);
+}
+
+// The rows of a grid do not overlap, so the first item whose top lies below
+// pos ends the search.
+QtTextLayoutItem *QtTextItemPainter::itemAt(const QPoint &pos)
+{
+    const ItemList::ConstIterator cend = m_items.constEnd();
+    for (ItemList::ConstIterator it = firstItemBelow(pos.y()); it != cend; ++it) {
+        const QRect geometry = (*it)->geometry();
+        if (geometry.top() > pos.y())
+            break;
+        if (geometry.contains(pos))
+            return *it;
+    }
+    return 0;
+}
+
+bool QtTextItemPainter::eventFilter(QObject *object, QEvent *event)
+{
+    if (object != m_host)
+        return false;
+    switch (event->type()) {
+    case QEvent::Paint: {
+        if (m_items.isEmpty())
+            break;
+        const QRect exposed = static_cast<QPaintEvent *>(event)->rect();
+        QPainter painter(m_host);
+        const ItemList::ConstIterator cend = m_items.constEnd();
+        for (ItemList::ConstIterator it = firstItemBelow(exposed.top()); it != cend; ++it) {
+            const QRect geometry = (*it)->geometry();
+            if (geometry.top() > exposed.bottom())
+                break;
+            if (geometry.intersects(exposed))
+                (*it)->paint(&painter);
+        }
+        break;
+    }
+    case QEvent::ToolTip: {
+        QHelpEvent *helpEvent = static_cast<QHelpEvent *>(event);
+        QtTextLayoutItem *item = itemAt(helpEvent->pos());
+        if (!item || item->toolTip().isEmpty())
+            break;
+        QToolTip::showText(helpEvent->globalPos(), item->toolTip(), m_host, item->geometry());
+        return true;
+    }
+    case QEvent::QueryWhatsThis:
+    case QEvent::WhatsThis: {
+        QHelpEvent *helpEvent = static_cast<QHelpEvent *>(event);
+        QtTextLayoutItem *item = itemAt(helpEvent->pos());
+        if (!item || item->whatsThis().isEmpty())
+            break;
+        if (event->type() == QEvent::WhatsThis)
+            QWhatsThis::showText(helpEvent->globalPos(), item->whatsThis(), m_host);
+        event->accept();
+        return true;
+    }
+    case QEvent::MouseMove:
+    case QEvent::Leave: {
+        QString statusTip;
+        if (event->type() == QEvent::MouseMove) {
+            if (QtTextLayoutItem *item = itemAt(static_cast<QMouseEvent *>(event)->pos()))
+                statusTip = item->statusTip();
+        }
+        if (statusTip != m_statusTip) {
+            m_statusTip = statusTip;
+            QStatusTipEvent tip(statusTip);
+            QApplication::sendEvent(m_host, &tip);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return false;
+}
+
+QtTextLayoutItem::QtTextLayoutItem(QWidget *host, QSizePolicy::Policy horizontalPolicy)
+    : m_host(host), m_painter(QtTextItemPainter::painter(host)),
+    m_horizontalPolicy(horizontalPolicy), m_underline(false), m_enabled(true)
+{
+    if (m_painter)
+        m_painter->addItem(this);
+}
+
+// Text items belong to the browser item that created them, never to the
+// layout: browsers take them out of a layout with clearLayout() before the
+// layout is deleted. The host is only touched while its painter, which is
+// deleted with the host's children, is still there.
+QtTextLayoutItem::~QtTextLayoutItem()
+{
+    if (!m_painter)
+        return;
+    m_painter->removeItem(this);
+    if (!m_host)
+        return;
+    if (QLayout *layout = m_host->layout())
+        layout->removeItem(this);
+    m_host->update(m_geometry);
+}
+
+void QtTextLayoutItem::installPainter(QWidget *host)
+{
+    if (!QtTextItemPainter::painter(host))
+        new QtTextItemPainter(host);
+}
+
+// Empties layout before it, or its host, is deleted. The wrappers of widgets
+// and the spacers are owned by the layout and deleted; text items are left
+// to their owners.
+void QtTextLayoutItem::clearLayout(QLayout *layout)
+{
+    for (int i = layout->count(); i > 0; i--) {
+        QLayoutItem *layoutItem = layout->takeAt(i - 1);
+        if (layoutItem->widget() || layoutItem->spacerItem())
+            delete layoutItem;
+    }
+}
+
+void QtTextLayoutItem::setStatusTip(const QString &statusTip)
+{
+    if (m_painter && m_statusTip.isEmpty() != statusTip.isEmpty())
+        m_painter->statusTipChanged(!statusTip.isEmpty());
+    m_statusTip = statusTip;
+}
+
+void QtTextLayoutItem::setText(const QString &text)
+{
+    if (m_text == text)
+        return;
+    m_text = text;
+    updateHost(m_horizontalPolicy != QSizePolicy::Ignored);
+}
+
+void QtTextLayoutItem::setUnderline(bool underline)
+{
+    if (m_underline == underline)
+        return;
+    m_underline = underline;
+    updateHost(true);
+}
+
+void QtTextLayoutItem::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled)
+        return;
+    m_enabled = enabled;
+    updateHost(false);
+}
+
+void QtTextLayoutItem::updateHost(bool relayout)
+{
+    if (!m_host)
+        return;
+    if (relayout)
+        invalidate();
+    if (relayout && m_host->layout())
+        m_host->layout()->invalidate();
+    m_host->update(m_geometry);
+}
+
+QFont QtTextLayoutItem::font() const
+{
+    QFont font = m_host ? m_host->font() : QFont();
+    font.setUnderline(m_underline);
+    return font;
+}
+
+QSize QtTextLayoutItem::textSize() const
+{
+    const QFontMetrics fm(font());
+    return QSize(fm.size(Qt::TextSingleLine, m_text).width(), fm.height());
+}
+
+// Mirrors the size hints of the QLabels the items replace: a name keeps
+// the width of its text, a value with an Ignored policy takes whatever
+// the value column leaves and elides the rest.
+QSize QtTextLayoutItem::sizeHint() const
+{
+    QSize size = textSize();
+    if (m_horizontalPolicy == QSizePolicy::Ignored)
+        size.setWidth(0);
+    return size;
+}
+
+QSize QtTextLayoutItem::minimumSize() const
+{
+    return sizeHint();
+}
+
+QSize QtTextLayoutItem::maximumSize() const
+{
+    QSize size = textSize();
+    if (m_horizontalPolicy != QSizePolicy::Fixed)
+        size.setWidth(QLAYOUTSIZE_MAX);
+    return size;
+}
+
+Qt::Orientations QtTextLayoutItem::expandingDirections() const
+{
+    if (m_horizontalPolicy & QSizePolicy::ExpandFlag)
+        return Qt::Horizontal;
+    return 0;
+}
+
+bool QtTextLayoutItem::isEmpty() const
+{
+    return false;
+}
+
+void QtTextLayoutItem::setGeometry(const QRect &rect)
+{
+    if (m_geometry == rect)
+        return;
+    if (m_painter)
+        m_painter->itemMoved();
+    if (m_host)
+        m_host->update(m_geometry);
+    m_geometry = rect;
+    if (m_host)
+        m_host->update(m_geometry);
+}
+
+void QtTextLayoutItem::paint(QPainter *painter) const
+{
+    if (!m_host || m_text.isEmpty())
+        return;
+
+    painter->save();
+    const QFont textFont = font();
+    painter->setFont(textFont);
+    const QFontMetrics fm(textFont);
+    const QString text = fm.elidedText(m_text, Qt::ElideRight, m_geometry.width());
+    m_host->style()->drawItemText(painter, m_geometry, Qt::AlignLeft | Qt::AlignVCenter,
+                m_host->palette(), m_enabled && m_host->isEnabled(), text, QPalette::WindowText);
+    painter->restore();
+}
+
+// Color swatches and font previews are shared by all managers and
+// editors. They are kept in a cache of the most recently used ones, so
+// that views showing many properties of the same few values do not
+// paint identical images over and over again.
+
+struct QtValueIcon
+{
+    QPixmap pixmap;
+    QIcon icon;
+};
+
+typedef QCache<QString, QtValueIcon> QtValueIconCache;
+
+Q_GLOBAL_STATIC_WITH_ARGS(QtValueIconCache, valueIconCache, (256))
+
+// Pixmaps must not outlive the application object.
+static void clearValueIconCache()
+{
+    valueIconCache()->clear();
+}
+
+// Returns the cache, registering its clean up on first use.
+static QtValueIconCache *valueIcons()
+{
+    static bool postRoutineAdded = false;
+    if (!postRoutineAdded) {
+        qAddPostRoutine(clearValueIconCache);
+        postRoutineAdded = true;
+    }
+    return valueIconCache();
+}
+
+template <class Value>
+static QtValueIcon cachedValueIcon(const QString &key, const Value &value, QPixmap (*createPixmap)(const Value &))
+{
+    QtValueIcon result;
+    if (key.isEmpty()) {
+        result.pixmap = createPixmap(value);
+        result.icon = QIcon(result.pixmap);
+        return result;
+    }
+
+    QtValueIconCache *cache = valueIcons();
+    if (const QtValueIcon *entry = cache->object(key))
+        return *entry;
+
+    result.pixmap = createPixmap(value);
+    result.icon = QIcon(result.pixmap);
+    cache->insert(key, new QtValueIcon(result));
+    return result;
+}
+
+static QPixmap createBrushValuePixmap(const QBrush &b)
 {
     QImage img(16, 16, QImage::Format_ARGB32_Premultiplied);
     img.fill(0);
@@ -149,9 +652,22 @@ QPixmap QtPropertyBrowserUtils::brushValuePixmap(const QBrush &b)
     return QPixmap::fromImage(img);
 }
 
+// Only solid brushes are cached; their swatch depends on the color alone.
+static QString brushValueKey(const QBrush &b)
+{
+    if (b.style() != Qt::SolidPattern)
+        return QString();
+    return QLatin1String("brush:") + QString::number(b.color().rgba(), 16);
+}
+
+QPixmap QtPropertyBrowserUtils::brushValuePixmap(const QBrush &b)
+{
+    return cachedValueIcon(brushValueKey(b), b, createBrushValuePixmap).pixmap;
+}
+
 QIcon QtPropertyBrowserUtils::brushValueIcon(const QBrush &b)
 {
-    return QIcon(brushValuePixmap(b));
+    return cachedValueIcon(brushValueKey(b), b, createBrushValuePixmap).icon;
 }
 
 QString QtPropertyBrowserUtils::colorValueText(const QColor &c)
@@ -163,25 +679,84 @@ QString QtPropertyBrowserUtils::colorValueText(const QColor &c)
                                   .arg(QString::number(c.alpha()));
 }
 
-QPixmap QtPropertyBrowserUtils::fontValuePixmap(const QFont &font)
+// Return an icon containing a check box indicator
+static QIcon drawCheckBox(bool value)
+{
+    QStyleOptionButton opt;
+    opt.state |= value ? QStyle::State_On : QStyle::State_Off;
+    opt.state |= QStyle::State_Enabled;
+    const QStyle *style = QApplication::style();
+    // Figure out size of an indicator and make sure it is not scaled down in a list view item
+    // by making the pixmap as big as a list view icon and centering the indicator in it.
+    // (if it is smaller, it can't be helped)
+    const int indicatorWidth = style->pixelMetric(QStyle::PM_IndicatorWidth, &opt);
+    const int indicatorHeight = style->pixelMetric(QStyle::PM_IndicatorHeight, &opt);
+    const int listViewIconSize = indicatorWidth;
+    const int pixmapWidth = indicatorWidth;
+    const int pixmapHeight = qMax(indicatorHeight, listViewIconSize);
+
+    opt.rect = QRect(0, 0, indicatorWidth, indicatorHeight);
+    QPixmap pixmap = QPixmap(pixmapWidth, pixmapHeight);
+    pixmap.fill(Qt::transparent);
+    {
+        // Center?
+        const int xoff = (pixmapWidth  > indicatorWidth)  ? (pixmapWidth  - indicatorWidth)  / 2 : 0;
+        const int yoff = (pixmapHeight > indicatorHeight) ? (pixmapHeight - indicatorHeight) / 2 : 0;
+        QPainter painter(&pixmap);
+        painter.translate(xoff, yoff);
+        QCheckBox cb;
+        style->drawPrimitive(QStyle::PE_IndicatorCheckBox, &opt, &painter, &cb);
+    }
+    return QIcon(pixmap);
+}
+
+QIcon QtPropertyBrowserUtils::boolValueIcon(bool b)
+{
+    static const QIcon checkedIcon = drawCheckBox(true);
+    static const QIcon uncheckedIcon = drawCheckBox(false);
+    return b ? checkedIcon : uncheckedIcon;
+}
+
+QString QtPropertyBrowserUtils::boolValueText(bool b)
+{
+    return b ? QApplication::translate("QtBoolPropertyManager", "True", 0)
+             : QApplication::translate("QtBoolPropertyManager", "False", 0);
+}
+
+static QFont previewFont(const QFont &font)
 {
     QFont f = font;
+    f.setPointSize(13);
+    return f;
+}
+
+static QPixmap createFontValuePixmap(const QFont &font)
+{
     QImage img(16, 16, QImage::Format_ARGB32_Premultiplied);
     img.fill(0);
     QPainter p(&img);
     p.setRenderHint(QPainter::TextAntialiasing, true);
     p.setRenderHint(QPainter::Antialiasing, true);
-    f.setPointSize(13);
-    p.setFont(f);
+    p.setFont(previewFont(font));
     QTextOption t;
     t.setAlignment(Qt::AlignCenter);
     p.drawText(QRect(0, 0, 16, 16), QString(QLatin1Char('A')), t);
     return QPixmap::fromImage(img);
 }
 
+static QString fontValueKey(const QFont &font)
+{
+    return QLatin1String("font:") + previewFont(font).key();
+}
+
+QPixmap QtPropertyBrowserUtils::fontValuePixmap(const QFont &font)
+{
+    return cachedValueIcon(fontValueKey(font), font, createFontValuePixmap).pixmap;
+}
+
 QIcon QtPropertyBrowserUtils::fontValueIcon(const QFont &f)
 {
-    return QIcon(fontValuePixmap(f));
+    return cachedValueIcon(fontValueKey(f), f, createFontValuePixmap).icon;
 }
 
 QString QtPropertyBrowserUtils::fontValueText(const QFont &f)
@@ -192,6 +767,12 @@ QString QtPropertyBrowserUtils::fontValueText(const QFont &f)
 }
 
 
+// Returns the adapter of the manager of property, or 0 if it has none
+QtPropertyEditorAdapter *QtPropertyEditorAdapter::adapter(const QtProperty *property)
+{
+    return property->propertyManager()->findChild<QtPropertyEditorAdapter *>(QString(), Qt::FindDirectChildrenOnly);
+}
+
 QtBoolEdit::QtBoolEdit(QWidget *parent) :
     QWidget(parent),
     m_checkBox(new QCheckBox(this)),
@@ -430,3 +1011,5 @@ bool QtKeySequenceEdit::event(QEvent *e)
 #if QT_VERSION >= 0x040400
 QT_END_NAMESPACE
 #endif
+
+#include "qtpropertybrowserutils.moc"
@@ -53,9 +53,13 @@
 #define QTPROPERTYBROWSERUTILS_H
 
 #include <QtCore/QMap>
+#include <QtCore/QHash>
 #include <QtGui/QIcon>
 #include <QWidget>
+#include <QLayoutItem>
+#include <QtCore/QPointer>
 #include <QtCore/QStringList>
+#include <QtCore/QVariant>
 
 #if QT_VERSION >= 0x040400
 QT_BEGIN_NAMESPACE
@@ -64,6 +68,8 @@ QT_BEGIN_NAMESPACE
 class QMouseEvent;
 class QCheckBox;
 class QLineEdit;
+class QtBrowserItem;
+class QtProperty;
 
 class QtCursorDatabase
 {
@@ -79,19 +85,104 @@ public:
     QCursor valueToCursor(int value) const;
 #endif
 private:
-    void appendCursor(Qt::CursorShape shape, const QString &name, const QIcon &icon);
-    QStringList m_cursorNames;
-    QMap<int, QIcon> m_cursorIcons;
+    QIcon cursorIcon(int value) const;
+
+    // Names are translated and icons are read from the resources only
+    // when they are first asked for.
+    mutable QStringList m_cursorNames;
+    mutable QMap<int, QIcon> m_cursorIcons;
+    mutable bool m_cursorIconsLoaded;
     QMap<int, Qt::CursorShape> m_valueToCursorShape;
     QMap<Qt::CursorShape, int> m_cursorShapeToValue;
 };
 
+class QtExpandStateStore
+{
+public:
+    QString itemPath(QtBrowserItem *item) const;
+    bool isExpanded(QtBrowserItem *item, bool defaultValue) const;
+    void setExpanded(QtBrowserItem *item, bool expanded);
+    void itemChanged(QtBrowserItem *item);
+    void itemRemoved(QtBrowserItem *item);
+
+    QHash<QString, bool> state() const { return m_pathToExpanded; }
+    void setState(const QHash<QString, bool> &state) { m_pathToExpanded = state; }
+    void clear() { m_pathToExpanded.clear(); }
+private:
+    static QString pathKey(QtBrowserItem *item);
+    void invalidatePath(QtBrowserItem *item);
+
+    mutable QHash<QtBrowserItem *, QString> m_itemToPath;
+    QHash<QString, bool> m_pathToExpanded;
+};
+
+class QtTextItemPainter;
+
+// A line of text placed by the layout of its host widget and painted by
+// the host, for names and read-only values that do not need a QLabel.
+// Call installPainter() on every host before creating its items; the host
+// paints its items and shows their tool tips. An item is owned by whoever
+// created it: call clearLayout() before deleting a layout or a host that
+// may still hold text items.
+class QtTextLayoutItem : public QLayoutItem
+{
+public:
+    QtTextLayoutItem(QWidget *host, QSizePolicy::Policy horizontalPolicy);
+    ~QtTextLayoutItem();
+
+    static void installPainter(QWidget *host);
+    static void clearLayout(QLayout *layout);
+
+    QWidget *host() const { return m_host; }
+
+    QString text() const { return m_text; }
+    void setText(const QString &text);
+    void setUnderline(bool underline);
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+    QString toolTip() const { return m_toolTip; }
+    void setToolTip(const QString &toolTip) { m_toolTip = toolTip; }
+    QString statusTip() const { return m_statusTip; }
+    void setStatusTip(const QString &statusTip);
+    QString whatsThis() const { return m_whatsThis; }
+    void setWhatsThis(const QString &whatsThis) { m_whatsThis = whatsThis; }
+
+    QSize sizeHint() const;
+    QSize minimumSize() const;
+    QSize maximumSize() const;
+    Qt::Orientations expandingDirections() const;
+    bool isEmpty() const;
+    void setGeometry(const QRect &rect);
+    QRect geometry() const { return m_geometry; }
+
+    void paint(QPainter *painter) const;
+private:
+    QFont font() const;
+    QSize textSize() const;
+    void updateHost(bool relayout);
+
+    QPointer<QWidget> m_host;
+    QtTextItemPainter *m_painter; // reset when the host is deleted
+    QSizePolicy::Policy m_horizontalPolicy;
+    QString m_text;
+    QString m_toolTip;
+    QString m_statusTip;
+    QString m_whatsThis;
+    QRect m_geometry;
+    bool m_underline;
+    bool m_enabled;
+
+    friend class QtTextItemPainter;
+};
+
 class QtPropertyBrowserUtils
 {
 public:
     static QPixmap brushValuePixmap(const QBrush &b);
     static QIcon brushValueIcon(const QBrush &b);
     static QString colorValueText(const QColor &c);
+    static QIcon boolValueIcon(bool b);
+    static QString boolValueText(bool b);
     static QPixmap fontValuePixmap(const QFont &f);
     static QIcon fontValueIcon(const QFont &f);
     static QString fontValueText(const QFont &f);
@@ -125,6 +216,29 @@ private:
     bool m_textVisible;
 };
 
+// Lets an editor factory edit properties whose manager it does not know,
+// such as the thin properties of QtVariantPropertyManager. The adapter is a
+// child of that manager; it hands out the values and attributes, named as
+// QtVariantPropertyManager names them, and takes the values entered in the
+// editors. Its signals tell the factory when to read them again.
+class QtPropertyEditorAdapter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QtPropertyEditorAdapter(QObject *manager) : QObject(manager) {}
+
+    static QtPropertyEditorAdapter *adapter(const QtProperty *property);
+
+    virtual QVariant value(const QtProperty *property) const = 0;
+    virtual QVariant attributeValue(const QtProperty *property, const QString &attribute) const = 0;
+    virtual void setValue(QtProperty *property, const QVariant &value) = 0;
+
+Q_SIGNALS:
+    void valueChanged(QtProperty *property);
+    void valuesChanged(const QList<QtProperty *> &properties);
+    void attributeChanged(QtProperty *property);
+};
+
 class QtKeySequenceEdit : public QWidget
 {
     Q_OBJECT
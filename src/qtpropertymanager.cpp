@@ -43,9 +43,19 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QLocale>
 #include <QtCore/QMap>
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+#include <QtCore/QSharedData>
 #include <QtCore/QTimer>
 #include <QtCore/QMetaEnum>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEvent>
+#include <QtCore/QPointer>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
 #include <QIcon>
+#include <QStandardItemModel>
 #include <QFontDatabase>
 #include <QStyleOption>
 #include <QStyle>
@@ -383,6 +393,326 @@ static void setMaximumValue(PropertyManager *manager, PropertyManagerPrivate *ma
             property, &PropertyManagerPrivate::Data::maximumValue, &PropertyManagerPrivate::Data::setMaximumValue, maxVal, setSubPropertyRange);
 }
 
+// Maps the properties of a manager onto dense slots, so that the manager
+// can keep each attribute in a contiguous array indexed by slot. Removing
+// a property moves the last slot into the freed one; the arrays follow
+// with removeSlotValue().
+class QtPropertySlotMap
+{
+public:
+    int slotOf(const QtProperty *property) const { return m_propertyToSlot.value(property, -1); }
+    int count() const { return m_properties.count(); }
+    const QtProperty *property(int slot) const { return m_properties.at(slot); }
+
+    int insert(const QtProperty *property)
+    {
+        const int slot = m_properties.count();
+        m_properties.append(property);
+        m_propertyToSlot.insert(property, slot);
+        return slot;
+    }
+
+    int remove(const QtProperty *property)
+    {
+        const QHash<const QtProperty *, int>::iterator it = m_propertyToSlot.find(property);
+        if (it == m_propertyToSlot.end())
+            return -1;
+        const int slot = it.value();
+        m_propertyToSlot.erase(it);
+        const QtProperty *last = m_properties.last();
+        m_properties.removeLast();
+        if (slot < m_properties.count()) {
+            m_properties[slot] = last;
+            m_propertyToSlot[last] = slot;
+        }
+        return slot;
+    }
+private:
+    QHash<const QtProperty *, int> m_propertyToSlot;
+    QVector<const QtProperty *> m_properties;
+};
+
+template <class Value>
+static void removeSlotValue(QVector<Value> &values, int slot)
+{
+    values[slot] = values.last();
+    values.removeLast();
+}
+
+// The subproperties of composite properties such as points and
+// rectangles. The components live in the composite's value; the
+// subproperties only exist while a browser shows them, so only the
+// composites that have been expanded have entries.
+class QtSubPropertyMap
+{
+public:
+    bool contains(const QtProperty *property) const { return m_subProperties.contains(property); }
+
+    QVector<QtProperty *> subProperties(const QtProperty *property) const { return m_subProperties.value(property); }
+
+    QtProperty *subProperty(const QtProperty *property, int index) const
+    {
+        const QHash<const QtProperty *, QVector<QtProperty *> >::ConstIterator it = m_subProperties.constFind(property);
+        if (it == m_subProperties.constEnd())
+            return 0;
+        return it.value().at(index);
+    }
+
+    // Returns the composite of subProperty and stores the component
+    // index in index, or returns 0.
+    QtProperty *parentProperty(const QtProperty *subProperty, int *index) const
+    {
+        const QHash<const QtProperty *, QPair<QtProperty *, int> >::ConstIterator it = m_parents.constFind(subProperty);
+        if (it == m_parents.constEnd())
+            return 0;
+        *index = it.value().second;
+        return it.value().first;
+    }
+
+    void insert(QtProperty *property, const QVector<QtProperty *> &subProperties)
+    {
+        m_subProperties.insert(property, subProperties);
+        const int count = subProperties.count();
+        for (int i = 0; i < count; i++)
+            m_parents.insert(subProperties.at(i), qMakePair(property, i));
+    }
+
+    void subPropertyDestroyed(const QtProperty *subProperty)
+    {
+        const QPair<QtProperty *, int> parent = m_parents.take(subProperty);
+        if (parent.first)
+            m_subProperties[parent.first][parent.second] = 0;
+    }
+
+    // Deletes the subproperties of property.
+    void remove(const QtProperty *property)
+    {
+        const QVector<QtProperty *> subProperties = m_subProperties.take(property);
+        const int count = subProperties.count();
+        for (int i = 0; i < count; i++) {
+            if (QtProperty *subProperty = subProperties.at(i)) {
+                m_parents.remove(subProperty);
+                delete subProperty;
+            }
+        }
+    }
+private:
+    QHash<const QtProperty *, QVector<QtProperty *> > m_subProperties;
+    QHash<const QtProperty *, QPair<QtProperty *, int> > m_parents;
+};
+
+// Counts the language changes of the application. One instance filters
+// the application object, which QCoreApplication::installTranslator()
+// sends LanguageChange to; the filter is installed on first use, so that
+// the application may be created after the first manager.
+class QtLanguageChangeWatcher : public QObject
+{
+public:
+    QtLanguageChangeWatcher() : m_generation(0) {}
+
+    int generation();
+
+    bool eventFilter(QObject *watched, QEvent *event);
+
+private:
+    QPointer<QCoreApplication> m_application;
+    int m_generation;
+};
+
+int QtLanguageChangeWatcher::generation()
+{
+    QCoreApplication *application = QCoreApplication::instance();
+    if (application != m_application) {
+        m_application = application;
+        if (application)
+            application->installEventFilter(this);
+    }
+    return m_generation;
+}
+
+bool QtLanguageChangeWatcher::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::LanguageChange)
+        ++m_generation;
+    return QObject::eventFilter(watched, event);
+}
+
+Q_GLOBAL_STATIC(QtLanguageChangeWatcher, languageChangeWatcher)
+
+// Memoizes the value texts of a manager's properties, so that a browser
+// asking for the text of the cell and of its tool tip on each update
+// only formats a value once per change. The text of a property is
+// dropped whenever the manager reports the property as changed, and all
+// texts are dropped after the application's language changed, since
+// they are translated.
+class QtValueTextCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QtValueTextCache(QtAbstractPropertyManager *manager);
+
+    bool find(const QtProperty *property, QString *text) const;
+    QString insert(const QtProperty *property, const QString &text);
+
+public Q_SLOTS:
+    void invalidate(QtProperty *property);
+    void invalidateProperties(const QList<QtProperty *> &properties);
+
+private:
+    mutable QHash<const QtProperty *, QString> m_texts;
+    mutable int m_generation;
+};
+
+QtValueTextCache::QtValueTextCache(QtAbstractPropertyManager *manager) :
+    QObject(manager),
+    m_generation(languageChangeWatcher()->generation())
+{
+    connect(manager, SIGNAL(propertyChanged(QtProperty *)),
+                this, SLOT(invalidate(QtProperty *)));
+    connect(manager, SIGNAL(propertiesChanged(QList<QtProperty *>)),
+                this, SLOT(invalidateProperties(QList<QtProperty *>)));
+    connect(manager, SIGNAL(propertyDestroyed(QtProperty *)),
+                this, SLOT(invalidate(QtProperty *)));
+}
+
+bool QtValueTextCache::find(const QtProperty *property, QString *text) const
+{
+    const int generation = languageChangeWatcher()->generation();
+    if (generation != m_generation) {
+        m_texts.clear();
+        m_generation = generation;
+        return false;
+    }
+    const QHash<const QtProperty *, QString>::const_iterator it = m_texts.constFind(property);
+    if (it == m_texts.constEnd())
+        return false;
+    *text = it.value();
+    return true;
+}
+
+QString QtValueTextCache::insert(const QtProperty *property, const QString &text)
+{
+    m_texts.insert(property, text);
+    return text;
+}
+
+void QtValueTextCache::invalidate(QtProperty *property)
+{
+    m_texts.remove(property);
+}
+
+void QtValueTextCache::invalidateProperties(const QList<QtProperty *> &properties)
+{
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext())
+        m_texts.remove(itProperty.next());
+}
+
+template <class Value, class PropertyManagerPrivate>
+static Value getSlotData(const PropertyManagerPrivate *managerPrivate,
+            QVector<Value> PropertyManagerPrivate::*data,
+            const QtProperty *property, const Value &defaultValue)
+{
+    const int slot = managerPrivate->m_slots.slotOf(property);
+    if (slot < 0)
+        return defaultValue;
+    return (managerPrivate->*data).at(slot);
+}
+
+template <class Value, class PropertyManagerPrivate, class PropertyManager>
+static void setSlotValueInRange(PropertyManager *manager, PropertyManagerPrivate *managerPrivate,
+            QtProperty *property, Value val)
+{
+    const int slot = managerPrivate->m_slots.slotOf(property);
+    if (slot < 0)
+        return;
+
+    const Value oldVal = managerPrivate->m_val.at(slot);
+    const Value newVal = qBound(managerPrivate->m_minVal.at(slot), val, managerPrivate->m_maxVal.at(slot));
+    if (newVal == oldVal)
+        return;
+
+    managerPrivate->m_val[slot] = newVal;
+
+    emit manager->propertyChanged(property);
+    emit manager->valueChanged(property, newVal);
+}
+
+// Clamps all values against the ranges of their slots in one pass over
+// the slot arrays and reports the properties that changed with a single
+// valuesChanged() and propertiesChanged() pair.
+template <class Value, class PropertyManagerPrivate, class PropertyManager>
+static void setSlotValuesInRange(PropertyManager *manager, PropertyManagerPrivate *managerPrivate,
+            const QList<QtProperty *> &properties, const QVector<Value> &values)
+{
+    const int count = qMin(properties.count(), values.count());
+    QVector<int> slotIndexes(count);
+    for (int i = 0; i < count; ++i)
+        slotIndexes[i] = managerPrivate->m_slots.slotOf(properties.at(i));
+
+    const Value *minVal = managerPrivate->m_minVal.constData();
+    const Value *maxVal = managerPrivate->m_maxVal.constData();
+    Value *val = managerPrivate->m_val.data();
+    QList<QtProperty *> changed;
+    for (int i = 0; i < count; ++i) {
+        const int slot = slotIndexes.at(i);
+        if (slot < 0)
+            continue;
+        const Value newVal = qBound(minVal[slot], values.at(i), maxVal[slot]);
+        if (newVal == val[slot])
+            continue;
+        val[slot] = newVal;
+        changed.append(properties.at(i));
+    }
+
+    if (changed.isEmpty())
+        return;
+
+    emit manager->propertiesChanged(changed);
+    emit manager->valuesChanged(changed);
+}
+
+// Lets a composite manager follow batched changes of its subproperties
+// through its per-property slot.
+template <class PropertyManagerPrivate, class SubManager, class Value>
+static void forwardValuesChanged(PropertyManagerPrivate *managerPrivate, const SubManager *subManager,
+            void (PropertyManagerPrivate::*slotValueChanged)(QtProperty *, Value),
+            const QList<QtProperty *> &properties)
+{
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext()) {
+        QtProperty *property = itProperty.next();
+        (managerPrivate->*slotValueChanged)(property, subManager->value(property));
+    }
+}
+
+// Expects minVal <= maxVal.
+template <class Value, class PropertyManagerPrivate, class PropertyManager>
+static void setSlotRange(PropertyManager *manager, PropertyManagerPrivate *managerPrivate,
+            QtProperty *property, Value minVal, Value maxVal)
+{
+    const int slot = managerPrivate->m_slots.slotOf(property);
+    if (slot < 0)
+        return;
+
+    if (managerPrivate->m_minVal.at(slot) == minVal && managerPrivate->m_maxVal.at(slot) == maxVal)
+        return;
+
+    const Value oldVal = managerPrivate->m_val.at(slot);
+    const Value newVal = qBound(minVal, oldVal, maxVal);
+    managerPrivate->m_minVal[slot] = minVal;
+    managerPrivate->m_maxVal[slot] = maxVal;
+    managerPrivate->m_val[slot] = newVal;
+
+    emit manager->rangeChanged(property, minVal, maxVal);
+
+    if (newVal == oldVal)
+        return;
+
+    emit manager->propertyChanged(property);
+    emit manager->valueChanged(property, newVal);
+}
+
 class QtMetaEnumWrapper : public QObject
 {
     Q_OBJECT
@@ -393,14 +723,18 @@ private:
     QtMetaEnumWrapper(QObject *parent) : QObject(parent) {}
 };
 
+// The tables are built on first use: the policy names when a size
+// policy property is created, the language list when a locale property
+// is created, and the sorted country table of a language only when a
+// locale of that language is shown.
 class QtMetaEnumProvider
 {
 public:
     QtMetaEnumProvider();
 
-    QStringList policyEnumNames() const { return m_policyEnumNames; }
-    QStringList languageEnumNames() const { return m_languageEnumNames; }
-    QStringList countryEnumNames(QLocale::Language language) const { return m_countryEnumNames.value(language); }
+    QStringList policyEnumNames() const;
+    QStringList languageEnumNames() const;
+    QStringList countryEnumNames(QLocale::Language language) const;
 
     QSizePolicy::Policy indexToSizePolicy(int index) const;
     int sizePolicyToIndex(QSizePolicy::Policy policy) const;
@@ -409,15 +743,23 @@ public:
     void localeToIndex(QLocale::Language language, QLocale::Country country, int *languageIndex, int *countryIndex) const;
 
 private:
-    void initLocale();
-
-    QStringList m_policyEnumNames;
-    QStringList m_languageEnumNames;
-    QMap<QLocale::Language, QStringList> m_countryEnumNames;
-    QMap<int, QLocale::Language> m_indexToLanguage;
-    QMap<QLocale::Language, int> m_languageToIndex;
-    QMap<int, QMap<int, QLocale::Country> > m_indexToCountry;
-    QMap<QLocale::Language, QMap<QLocale::Country, int> > m_countryToIndex;
+    struct LanguageEntry
+    {
+        QLocale::Language language;
+        QList<QLocale::Country> countries;
+        QStringList countryNames;
+        QMap<QLocale::Country, int> countryToIndex;
+        bool countriesSorted;
+    };
+
+    void initLanguages() const;
+    const LanguageEntry &countryTable(int languageIndex) const;
+
+    mutable QStringList m_policyEnumNames;
+    mutable bool m_languagesInitialized;
+    mutable QStringList m_languageEnumNames;
+    mutable QVector<LanguageEntry> m_languages;
+    mutable QMap<QLocale::Language, int> m_languageToIndex;
     QMetaEnum m_policyEnum;
 };
 
@@ -449,8 +791,12 @@ static QList<QLocale::Country> sortCountries(const QList<QLocale::Country> &coun
     return nameToCountry.values();
 }
 
-void QtMetaEnumProvider::initLocale()
+void QtMetaEnumProvider::initLanguages() const
 {
+    if (m_languagesInitialized)
+        return;
+    m_languagesInitialized = true;
+
     QMultiMap<QString, QLocale::Language> nameToLanguage;
     QLocale::Language language = QLocale::C;
     while (language <= QLocale::LastLanguage) {
@@ -478,38 +824,69 @@ void QtMetaEnumProvider::initLocale()
             countries << system.country();
 
         if (!countries.isEmpty() && !m_languageToIndex.contains(language)) {
-            countries = sortCountries(countries);
-            int langIdx = m_languageEnumNames.count();
-            m_indexToLanguage[langIdx] = language;
-            m_languageToIndex[language] = langIdx;
-            QStringList countryNames;
-            QListIterator<QLocale::Country> it(countries);
-            int countryIdx = 0;
-            while (it.hasNext()) {
-                QLocale::Country country = it.next();
-                countryNames << QLocale::countryToString(country);
-                m_indexToCountry[langIdx][countryIdx] = country;
-                m_countryToIndex[language][country] = countryIdx;
-                ++countryIdx;
-            }
+            // The countries are sorted by name in countryTable().
+            LanguageEntry entry;
+            entry.language = language;
+            entry.countries = countries;
+            entry.countriesSorted = false;
+            m_languageToIndex[language] = m_languages.count();
+            m_languages.append(entry);
             m_languageEnumNames << QLocale::languageToString(language);
-            m_countryEnumNames[language] = countryNames;
         }
     }
 }
 
-QtMetaEnumProvider::QtMetaEnumProvider()
+const QtMetaEnumProvider::LanguageEntry &QtMetaEnumProvider::countryTable(int languageIndex) const
+{
+    LanguageEntry &entry = m_languages[languageIndex];
+    if (!entry.countriesSorted) {
+        entry.countries = sortCountries(entry.countries);
+        int countryIdx = 0;
+        QListIterator<QLocale::Country> it(entry.countries);
+        while (it.hasNext()) {
+            QLocale::Country country = it.next();
+            entry.countryNames << QLocale::countryToString(country);
+            entry.countryToIndex[country] = countryIdx;
+            ++countryIdx;
+        }
+        entry.countriesSorted = true;
+    }
+    return entry;
+}
+
+QtMetaEnumProvider::QtMetaEnumProvider() :
+    m_languagesInitialized(false)
 {
     QMetaProperty p;
 
     p = QtMetaEnumWrapper::staticMetaObject.property(
                 QtMetaEnumWrapper::staticMetaObject.propertyOffset() + 0);
     m_policyEnum = p.enumerator();
-    const int keyCount = m_policyEnum.keyCount();
-    for (int i = 0; i < keyCount; i++)
-        m_policyEnumNames << QLatin1String(m_policyEnum.key(i));
+}
 
-    initLocale();
+QStringList QtMetaEnumProvider::policyEnumNames() const
+{
+    if (m_policyEnumNames.isEmpty()) {
+        const int keyCount = m_policyEnum.keyCount();
+        for (int i = 0; i < keyCount; i++)
+            m_policyEnumNames << QLatin1String(m_policyEnum.key(i));
+    }
+    return m_policyEnumNames;
+}
+
+QStringList QtMetaEnumProvider::languageEnumNames() const
+{
+    initLanguages();
+    return m_languageEnumNames;
+}
+
+QStringList QtMetaEnumProvider::countryEnumNames(QLocale::Language language) const
+{
+    initLanguages();
+    const int languageIndex = m_languageToIndex.value(language, -1);
+    if (languageIndex < 0)
+        return QStringList();
+    return countryTable(languageIndex).countryNames;
 }
 
 QSizePolicy::Policy QtMetaEnumProvider::indexToSizePolicy(int index) const
@@ -528,12 +905,16 @@ int QtMetaEnumProvider::sizePolicyToIndex(QSizePolicy::Policy policy) const
 
 void QtMetaEnumProvider::indexToLocale(int languageIndex, int countryIndex, QLocale::Language *language, QLocale::Country *country) const
 {
+    initLanguages();
     QLocale::Language l = QLocale::C;
     QLocale::Country c = QLocale::AnyCountry;
-    if (m_indexToLanguage.contains(languageIndex)) {
-        l = m_indexToLanguage[languageIndex];
-        if (m_indexToCountry.contains(languageIndex) && m_indexToCountry[languageIndex].contains(countryIndex))
-            c = m_indexToCountry[languageIndex][countryIndex];
+    if (languageIndex >= 0 && languageIndex < m_languages.count()) {
+        l = m_languages.at(languageIndex).language;
+        if (country) {
+            const LanguageEntry &entry = countryTable(languageIndex);
+            if (countryIndex >= 0 && countryIndex < entry.countries.count())
+                c = entry.countries.at(countryIndex);
+        }
     }
     if (language)
         *language = l;
@@ -543,13 +924,11 @@ void QtMetaEnumProvider::indexToLocale(int languageIndex, int countryIndex, QLoc
 
 void QtMetaEnumProvider::localeToIndex(QLocale::Language language, QLocale::Country country, int *languageIndex, int *countryIndex) const
 {
-    int l = -1;
+    initLanguages();
+    int l = m_languageToIndex.value(language, -1);
     int c = -1;
-    if (m_languageToIndex.contains(language)) {
-        l = m_languageToIndex[language];
-        if (m_countryToIndex.contains(language) && m_countryToIndex[language].contains(country))
-            c = m_countryToIndex[language][country];
-    }
+    if (l >= 0)
+        c = countryTable(l).countryToIndex.value(country, -1);
 
     if (languageIndex)
         *languageIndex = l;
@@ -621,21 +1000,13 @@ class QtIntPropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtIntPropertyManager)
 public:
 
-    struct Data
-    {
-        Data() : val(0), minVal(-INT_MAX), maxVal(INT_MAX), singleStep(1) {}
-        int val;
-        int minVal;
-        int maxVal;
-        int singleStep;
-        int minimumValue() const { return minVal; }
-        int maximumValue() const { return maxVal; }
-        void setMinimumValue(int newMinVal) { setSimpleMinimumData(this, newMinVal); }
-        void setMaximumValue(int newMaxVal) { setSimpleMaximumData(this, newMaxVal); }
-    };
+    QtValueTextCache *m_valueTexts;
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
-    PropertyValueMap m_values;
+    QtPropertySlotMap m_slots;
+    QVector<int> m_val;
+    QVector<int> m_minVal;
+    QVector<int> m_maxVal;
+    QVector<int> m_singleStep;
 };
 
 /*!
@@ -670,6 +1041,15 @@ public:
     \sa setValue()
 */
 
+/*!
+    \fn void QtIntPropertyManager::valuesChanged(const QList<QtProperty *> &properties)
+
+    This signal is emitted once by setValues() for all \a properties
+    whose value changed, instead of valueChanged() for each of them.
+
+    \sa setValues()
+*/
+
 /*!
     \fn void QtIntPropertyManager::rangeChanged(QtProperty *property, int minimum, int maximum)
 
@@ -698,6 +1078,7 @@ QtIntPropertyManager::QtIntPropertyManager(QObject *parent)
 {
     d_ptr = new QtIntPropertyManagerPrivate;
     d_ptr->q_ptr = this;
+    d_ptr->m_valueTexts = new QtValueTextCache(this);
 }
 
 /*!
@@ -719,7 +1100,7 @@ QtIntPropertyManager::~QtIntPropertyManager()
 */
 int QtIntPropertyManager::value(const QtProperty *property) const
 {
-    return getValue<int>(d_ptr->m_values, property, 0);
+    return getSlotData<int>(d_ptr, &QtIntPropertyManagerPrivate::m_val, property, 0);
 }
 
 /*!
@@ -729,7 +1110,7 @@ int QtIntPropertyManager::value(const QtProperty *property) const
 */
 int QtIntPropertyManager::minimum(const QtProperty *property) const
 {
-    return getMinimum<int>(d_ptr->m_values, property, 0);
+    return getSlotData<int>(d_ptr, &QtIntPropertyManagerPrivate::m_minVal, property, 0);
 }
 
 /*!
@@ -739,7 +1120,7 @@ int QtIntPropertyManager::minimum(const QtProperty *property) const
 */
 int QtIntPropertyManager::maximum(const QtProperty *property) const
 {
-    return getMaximum<int>(d_ptr->m_values, property, 0);
+    return getSlotData<int>(d_ptr, &QtIntPropertyManagerPrivate::m_maxVal, property, 0);
 }
 
 /*!
@@ -751,7 +1132,7 @@ int QtIntPropertyManager::maximum(const QtProperty *property) const
 */
 int QtIntPropertyManager::singleStep(const QtProperty *property) const
 {
-    return getData<int>(d_ptr->m_values, &QtIntPropertyManagerPrivate::Data::singleStep, property, 0);
+    return getSlotData<int>(d_ptr, &QtIntPropertyManagerPrivate::m_singleStep, property, 0);
 }
 
 /*!
@@ -759,10 +1140,13 @@ int QtIntPropertyManager::singleStep(const QtProperty *property) const
 */
 QString QtIntPropertyManager::valueText(const QtProperty *property) const
 {
-    const QtIntPropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
-    if (it == d_ptr->m_values.constEnd())
+    QString text;
+    if (d_ptr->m_valueTexts->find(property, &text))
+        return text;
+    const int slot = d_ptr->m_slots.slotOf(property);
+    if (slot < 0)
         return QString();
-    return QString::number(it.value().val);
+    return d_ptr->m_valueTexts->insert(property, QString::number(d_ptr->m_val.at(slot)));
 }
 
 /*!
@@ -778,11 +1162,21 @@ QString QtIntPropertyManager::valueText(const QtProperty *property) const
 */
 void QtIntPropertyManager::setValue(QtProperty *property, int val)
 {
-    void (QtIntPropertyManagerPrivate::*setSubPropertyValue)(QtProperty *, int) = 0;
-    setValueInRange<int, QtIntPropertyManagerPrivate, QtIntPropertyManager, int>(this, d_ptr,
-                &QtIntPropertyManager::propertyChanged,
-                &QtIntPropertyManager::valueChanged,
-                property, val, setSubPropertyValue);
+    setSlotValueInRange<int>(this, d_ptr, property, val);
+}
+
+/*!
+    Sets the values of the given \a properties to the corresponding
+    entries of \a values, adjusting each value to its property's range.
+
+    Unlike setValue(), the properties whose value changed are reported
+    with a single valuesChanged() and propertiesChanged() signal.
+
+    \sa setValue(), valuesChanged()
+*/
+void QtIntPropertyManager::setValues(const QList<QtProperty *> &properties, const QVector<int> &values)
+{
+    setSlotValuesInRange<int>(this, d_ptr, properties, values);
 }
 
 /*!
@@ -796,11 +1190,7 @@ void QtIntPropertyManager::setValue(QtProperty *property, int val)
 */
 void QtIntPropertyManager::setMinimum(QtProperty *property, int minVal)
 {
-    setMinimumValue<int, QtIntPropertyManagerPrivate, QtIntPropertyManager, int, QtIntPropertyManagerPrivate::Data>(this, d_ptr,
-                &QtIntPropertyManager::propertyChanged,
-                &QtIntPropertyManager::valueChanged,
-                &QtIntPropertyManager::rangeChanged,
-                property, minVal);
+    setSlotRange<int>(this, d_ptr, property, minVal, qMax(maximum(property), minVal));
 }
 
 /*!
@@ -814,11 +1204,7 @@ void QtIntPropertyManager::setMinimum(QtProperty *property, int minVal)
 */
 void QtIntPropertyManager::setMaximum(QtProperty *property, int maxVal)
 {
-    setMaximumValue<int, QtIntPropertyManagerPrivate, QtIntPropertyManager, int, QtIntPropertyManagerPrivate::Data>(this, d_ptr,
-                &QtIntPropertyManager::propertyChanged,
-                &QtIntPropertyManager::valueChanged,
-                &QtIntPropertyManager::rangeChanged,
-                property, maxVal);
+    setSlotRange<int>(this, d_ptr, property, qMin(minimum(property), maxVal), maxVal);
 }
 
 /*!
@@ -837,12 +1223,8 @@ void QtIntPropertyManager::setMaximum(QtProperty *property, int maxVal)
 */
 void QtIntPropertyManager::setRange(QtProperty *property, int minVal, int maxVal)
 {
-    void (QtIntPropertyManagerPrivate::*setSubPropertyRange)(QtProperty *, int, int, int) = 0;
-    setBorderValues<int, QtIntPropertyManagerPrivate, QtIntPropertyManager, int>(this, d_ptr,
-                &QtIntPropertyManager::propertyChanged,
-                &QtIntPropertyManager::valueChanged,
-                &QtIntPropertyManager::rangeChanged,
-                property, minVal, maxVal, setSubPropertyRange);
+    orderBorders(minVal, maxVal);
+    setSlotRange<int>(this, d_ptr, property, minVal, maxVal);
 }
 
 /*!
@@ -854,23 +1236,19 @@ void QtIntPropertyManager::setRange(QtProperty *property, int minVal, int maxVal
 */
 void QtIntPropertyManager::setSingleStep(QtProperty *property, int step)
 {
-    const QtIntPropertyManagerPrivate::PropertyValueMap::iterator it = d_ptr->m_values.find(property);
-    if (it == d_ptr->m_values.end())
+    const int slot = d_ptr->m_slots.slotOf(property);
+    if (slot < 0)
         return;
 
-    QtIntPropertyManagerPrivate::Data data = it.value();
-
     if (step < 0)
         step = 0;
 
-    if (data.singleStep == step)
+    if (d_ptr->m_singleStep.at(slot) == step)
         return;
 
-    data.singleStep = step;
-
-    it.value() = data;
+    d_ptr->m_singleStep[slot] = step;
 
-    emit singleStepChanged(property, data.singleStep);
+    emit singleStepChanged(property, step);
 }
 
 /*!
@@ -878,7 +1256,11 @@ void QtIntPropertyManager::setSingleStep(QtProperty *property, int step)
 */
 void QtIntPropertyManager::initializeProperty(QtProperty *property)
 {
-    d_ptr->m_values[property] = QtIntPropertyManagerPrivate::Data();
+    d_ptr->m_slots.insert(property);
+    d_ptr->m_val.append(0);
+    d_ptr->m_minVal.append(-INT_MAX);
+    d_ptr->m_maxVal.append(INT_MAX);
+    d_ptr->m_singleStep.append(1);
 }
 
 /*!
@@ -886,7 +1268,13 @@ void QtIntPropertyManager::initializeProperty(QtProperty *property)
 */
 void QtIntPropertyManager::uninitializeProperty(QtProperty *property)
 {
-    d_ptr->m_values.remove(property);
+    const int slot = d_ptr->m_slots.remove(property);
+    if (slot < 0)
+        return;
+    removeSlotValue(d_ptr->m_val, slot);
+    removeSlotValue(d_ptr->m_minVal, slot);
+    removeSlotValue(d_ptr->m_maxVal, slot);
+    removeSlotValue(d_ptr->m_singleStep, slot);
 }
 
 // QtDoublePropertyManager
@@ -897,22 +1285,14 @@ class QtDoublePropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtDoublePropertyManager)
 public:
 
-    struct Data
-    {
-        Data() : val(0), minVal(-INT_MAX), maxVal(INT_MAX), singleStep(1), decimals(2) {}
-        double val;
-        double minVal;
-        double maxVal;
-        double singleStep;
-        int decimals;
-        double minimumValue() const { return minVal; }
-        double maximumValue() const { return maxVal; }
-        void setMinimumValue(double newMinVal) { setSimpleMinimumData(this, newMinVal); }
-        void setMaximumValue(double newMaxVal) { setSimpleMaximumData(this, newMaxVal); }
-    };
+    QtValueTextCache *m_valueTexts;
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
-    PropertyValueMap m_values;
+    QtPropertySlotMap m_slots;
+    QVector<double> m_val;
+    QVector<double> m_minVal;
+    QVector<double> m_maxVal;
+    QVector<double> m_singleStep;
+    QVector<int> m_decimals;
 };
 
 /*!
@@ -948,6 +1328,15 @@ public:
     \sa setValue()
 */
 
+/*!
+    \fn void QtDoublePropertyManager::valuesChanged(const QList<QtProperty *> &properties)
+
+    This signal is emitted once by setValues() for all \a properties
+    whose value changed, instead of valueChanged() for each of them.
+
+    \sa setValues()
+*/
+
 /*!
     \fn void QtDoublePropertyManager::rangeChanged(QtProperty *property, double minimum, double maximum)
 
@@ -986,6 +1375,7 @@ QtDoublePropertyManager::QtDoublePropertyManager(QObject *parent)
 {
     d_ptr = new QtDoublePropertyManagerPrivate;
     d_ptr->q_ptr = this;
+    d_ptr->m_valueTexts = new QtValueTextCache(this);
 }
 
 /*!
@@ -1007,7 +1397,7 @@ QtDoublePropertyManager::~QtDoublePropertyManager()
 */
 double QtDoublePropertyManager::value(const QtProperty *property) const
 {
-    return getValue<double>(d_ptr->m_values, property, 0.0);
+    return getSlotData<double>(d_ptr, &QtDoublePropertyManagerPrivate::m_val, property, 0.0);
 }
 
 /*!
@@ -1017,7 +1407,7 @@ double QtDoublePropertyManager::value(const QtProperty *property) const
 */
 double QtDoublePropertyManager::minimum(const QtProperty *property) const
 {
-    return getMinimum<double>(d_ptr->m_values, property, 0.0);
+    return getSlotData<double>(d_ptr, &QtDoublePropertyManagerPrivate::m_minVal, property, 0.0);
 }
 
 /*!
@@ -1027,7 +1417,7 @@ double QtDoublePropertyManager::minimum(const QtProperty *property) const
 */
 double QtDoublePropertyManager::maximum(const QtProperty *property) const
 {
-    return getMaximum<double>(d_ptr->m_values, property, 0.0);
+    return getSlotData<double>(d_ptr, &QtDoublePropertyManagerPrivate::m_maxVal, property, 0.0);
 }
 
 /*!
@@ -1039,7 +1429,7 @@ double QtDoublePropertyManager::maximum(const QtProperty *property) const
 */
 double QtDoublePropertyManager::singleStep(const QtProperty *property) const
 {
-    return getData<double>(d_ptr->m_values, &QtDoublePropertyManagerPrivate::Data::singleStep, property, 0);
+    return getSlotData<double>(d_ptr, &QtDoublePropertyManagerPrivate::m_singleStep, property, 0.0);
 }
 
 /*!
@@ -1049,7 +1439,7 @@ double QtDoublePropertyManager::singleStep(const QtProperty *property) const
 */
 int QtDoublePropertyManager::decimals(const QtProperty *property) const
 {
-    return getData<int>(d_ptr->m_values, &QtDoublePropertyManagerPrivate::Data::decimals, property, 0);
+    return getSlotData<int>(d_ptr, &QtDoublePropertyManagerPrivate::m_decimals, property, 0);
 }
 
 /*!
@@ -1057,10 +1447,13 @@ int QtDoublePropertyManager::decimals(const QtProperty *property) const
 */
 QString QtDoublePropertyManager::valueText(const QtProperty *property) const
 {
-    const QtDoublePropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
-    if (it == d_ptr->m_values.constEnd())
+    QString text;
+    if (d_ptr->m_valueTexts->find(property, &text))
+        return text;
+    const int slot = d_ptr->m_slots.slotOf(property);
+    if (slot < 0)
         return QString();
-    return QString::number(it.value().val, 'f', it.value().decimals);
+    return d_ptr->m_valueTexts->insert(property, QString::number(d_ptr->m_val.at(slot), 'f', d_ptr->m_decimals.at(slot)));
 }
 
 /*!
@@ -1076,11 +1469,21 @@ QString QtDoublePropertyManager::valueText(const QtProperty *property) const
 */
 void QtDoublePropertyManager::setValue(QtProperty *property, double val)
 {
-    void (QtDoublePropertyManagerPrivate::*setSubPropertyValue)(QtProperty *, double) = 0;
-    setValueInRange<double, QtDoublePropertyManagerPrivate, QtDoublePropertyManager, double>(this, d_ptr,
-                &QtDoublePropertyManager::propertyChanged,
-                &QtDoublePropertyManager::valueChanged,
-                property, val, setSubPropertyValue);
+    setSlotValueInRange<double>(this, d_ptr, property, val);
+}
+
+/*!
+    Sets the values of the given \a properties to the corresponding
+    entries of \a values, adjusting each value to its property's range.
+
+    Unlike setValue(), the properties whose value changed are reported
+    with a single valuesChanged() and propertiesChanged() signal.
+
+    \sa setValue(), valuesChanged()
+*/
+void QtDoublePropertyManager::setValues(const QList<QtProperty *> &properties, const QVector<double> &values)
+{
+    setSlotValuesInRange<double>(this, d_ptr, properties, values);
 }
 
 /*!
@@ -1092,23 +1495,19 @@ void QtDoublePropertyManager::setValue(QtProperty *property, double val)
 */
 void QtDoublePropertyManager::setSingleStep(QtProperty *property, double step)
 {
-    const QtDoublePropertyManagerPrivate::PropertyValueMap::iterator it = d_ptr->m_values.find(property);
-    if (it == d_ptr->m_values.end())
+    const int slot = d_ptr->m_slots.slotOf(property);
+    if (slot < 0)
         return;
 
-    QtDoublePropertyManagerPrivate::Data data = it.value();
-
     if (step < 0)
         step = 0;
 
-    if (data.singleStep == step)
+    if (d_ptr->m_singleStep.at(slot) == step)
         return;
 
-    data.singleStep = step;
-
-    it.value() = data;
+    d_ptr->m_singleStep[slot] = step;
 
-    emit singleStepChanged(property, data.singleStep);
+    emit singleStepChanged(property, step);
 }
 
 /*!
@@ -1122,25 +1521,22 @@ void QtDoublePropertyManager::setSingleStep(QtProperty *property, double step)
 */
 void QtDoublePropertyManager::setDecimals(QtProperty *property, int prec)
 {
-    const QtDoublePropertyManagerPrivate::PropertyValueMap::iterator it = d_ptr->m_values.find(property);
-    if (it == d_ptr->m_values.end())
+    const int slot = d_ptr->m_slots.slotOf(property);
+    if (slot < 0)
         return;
 
-    QtDoublePropertyManagerPrivate::Data data = it.value();
-
     if (prec > 13)
         prec = 13;
     else if (prec < 0)
         prec = 0;
 
-    if (data.decimals == prec)
+    if (d_ptr->m_decimals.at(slot) == prec)
         return;
 
-    data.decimals = prec;
+    d_ptr->m_decimals[slot] = prec;
 
-    it.value() = data;
-
-    emit decimalsChanged(property, data.decimals);
+    emit propertyChanged(property);
+    emit decimalsChanged(property, prec);
 }
 
 /*!
@@ -1154,11 +1550,7 @@ void QtDoublePropertyManager::setDecimals(QtProperty *property, int prec)
 */
 void QtDoublePropertyManager::setMinimum(QtProperty *property, double minVal)
 {
-    setMinimumValue<double, QtDoublePropertyManagerPrivate, QtDoublePropertyManager, double, QtDoublePropertyManagerPrivate::Data>(this, d_ptr,
-                &QtDoublePropertyManager::propertyChanged,
-                &QtDoublePropertyManager::valueChanged,
-                &QtDoublePropertyManager::rangeChanged,
-                property, minVal);
+    setSlotRange<double>(this, d_ptr, property, minVal, qMax(maximum(property), minVal));
 }
 
 /*!
@@ -1172,11 +1564,7 @@ void QtDoublePropertyManager::setMinimum(QtProperty *property, double minVal)
 */
 void QtDoublePropertyManager::setMaximum(QtProperty *property, double maxVal)
 {
-    setMaximumValue<double, QtDoublePropertyManagerPrivate, QtDoublePropertyManager, double, QtDoublePropertyManagerPrivate::Data>(this, d_ptr,
-                &QtDoublePropertyManager::propertyChanged,
-                &QtDoublePropertyManager::valueChanged,
-                &QtDoublePropertyManager::rangeChanged,
-                property, maxVal);
+    setSlotRange<double>(this, d_ptr, property, qMin(minimum(property), maxVal), maxVal);
 }
 
 /*!
@@ -1195,12 +1583,8 @@ void QtDoublePropertyManager::setMaximum(QtProperty *property, double maxVal)
 */
 void QtDoublePropertyManager::setRange(QtProperty *property, double minVal, double maxVal)
 {
-    void (QtDoublePropertyManagerPrivate::*setSubPropertyRange)(QtProperty *, double, double, double) = 0;
-    setBorderValues<double, QtDoublePropertyManagerPrivate, QtDoublePropertyManager, double>(this, d_ptr,
-                &QtDoublePropertyManager::propertyChanged,
-                &QtDoublePropertyManager::valueChanged,
-                &QtDoublePropertyManager::rangeChanged,
-                property, minVal, maxVal, setSubPropertyRange);
+    orderBorders(minVal, maxVal);
+    setSlotRange<double>(this, d_ptr, property, minVal, maxVal);
 }
 
 /*!
@@ -1208,7 +1592,12 @@ void QtDoublePropertyManager::setRange(QtProperty *property, double minVal, doub
 */
 void QtDoublePropertyManager::initializeProperty(QtProperty *property)
 {
-    d_ptr->m_values[property] = QtDoublePropertyManagerPrivate::Data();
+    d_ptr->m_slots.insert(property);
+    d_ptr->m_val.append(0);
+    d_ptr->m_minVal.append(-INT_MAX);
+    d_ptr->m_maxVal.append(INT_MAX);
+    d_ptr->m_singleStep.append(1);
+    d_ptr->m_decimals.append(2);
 }
 
 /*!
@@ -1216,7 +1605,14 @@ void QtDoublePropertyManager::initializeProperty(QtProperty *property)
 */
 void QtDoublePropertyManager::uninitializeProperty(QtProperty *property)
 {
-    d_ptr->m_values.remove(property);
+    const int slot = d_ptr->m_slots.remove(property);
+    if (slot < 0)
+        return;
+    removeSlotValue(d_ptr->m_val, slot);
+    removeSlotValue(d_ptr->m_minVal, slot);
+    removeSlotValue(d_ptr->m_maxVal, slot);
+    removeSlotValue(d_ptr->m_singleStep, slot);
+    removeSlotValue(d_ptr->m_decimals, slot);
 }
 
 // QtStringPropertyManager
@@ -1234,12 +1630,68 @@ public:
         }
         QString val;
         QRegExp regExp;
+        // Copies of the compiled expressions in m_sharedExpressions;
+        // the pattern is empty if no regular expression is set.
+        QRegularExpression regularExpression;
+        QRegularExpression anchoredExpression;
     };
 
+    void acquireExpression(Data &data, const QRegularExpression &regularExpression);
+    void releaseExpression(Data &data);
+
     typedef QMap<const QtProperty *, Data> PropertyValueMap;
     QMap<const QtProperty *, Data> m_values;
+
+    // Properties with the same pattern and options share one compiled
+    // (and, where available, JIT-optimized) expression.
+    struct SharedExpression
+    {
+        QRegularExpression expression;
+        QRegularExpression anchoredExpression;
+        int refCount;
+    };
+    typedef QPair<QString, int> ExpressionKey;
+    QHash<ExpressionKey, SharedExpression> m_sharedExpressions;
 };
 
+void QtStringPropertyManagerPrivate::acquireExpression(Data &data, const QRegularExpression &regularExpression)
+{
+    if (regularExpression.pattern().isEmpty())
+        return;
+
+    const ExpressionKey key(regularExpression.pattern(), int(regularExpression.patternOptions()));
+    QHash<ExpressionKey, SharedExpression>::iterator it = m_sharedExpressions.find(key);
+    if (it == m_sharedExpressions.end()) {
+        SharedExpression shared;
+        shared.expression = regularExpression;
+        // Same as QRegularExpression::anchoredPattern() in Qt 5.12.
+        shared.anchoredExpression = QRegularExpression(QLatin1String("\\A(?:") + regularExpression.pattern()
+                    + QLatin1String(")\\z"), regularExpression.patternOptions());
+#if QT_VERSION >= 0x050400
+        shared.expression.optimize();
+        shared.anchoredExpression.optimize();
+#endif
+        shared.refCount = 0;
+        it = m_sharedExpressions.insert(key, shared);
+    }
+    ++it.value().refCount;
+    data.regularExpression = it.value().expression;
+    data.anchoredExpression = it.value().anchoredExpression;
+}
+
+void QtStringPropertyManagerPrivate::releaseExpression(Data &data)
+{
+    if (data.regularExpression.pattern().isEmpty())
+        return;
+
+    const ExpressionKey key(data.regularExpression.pattern(), int(data.regularExpression.patternOptions()));
+    data.regularExpression = QRegularExpression();
+    data.anchoredExpression = QRegularExpression();
+    QHash<ExpressionKey, SharedExpression>::iterator it = m_sharedExpressions.find(key);
+    if (it != m_sharedExpressions.end() && --it.value().refCount == 0)
+        m_sharedExpressions.erase(it);
+}
+
 /*!
     \class QtStringPropertyManager
 
@@ -1251,11 +1703,16 @@ public:
     The current value can be checked against a regular expression. To
     set the regular expression use the setRegExp() slot, use the
     regExp() function to retrieve the currently set expression.
+    Alternatively, a QRegularExpression can be set using the
+    setRegularExpression() slot; while its pattern is not empty it is
+    used instead of the QRegExp. Properties with the same pattern share
+    one compiled expression.
 
     In addition, QtStringPropertyManager provides the valueChanged() signal
     which is emitted whenever a property created by this manager
-    changes, and the regExpChanged() signal which is emitted whenever
-    such a property changes its currently set regular expression.
+    changes, and the regExpChanged() and regularExpressionChanged()
+    signals which are emitted whenever such a property changes its
+    currently set regular expression.
 
     \sa QtAbstractPropertyManager, QtLineEditFactory
 */
@@ -1280,6 +1737,16 @@ public:
     \sa setRegExp()
 */
 
+/*!
+    \fn void QtStringPropertyManager::regularExpressionChanged(QtProperty *property, const QRegularExpression &regularExpression)
+
+    This signal is emitted whenever a property created by this manager
+    changes its currently set QRegularExpression, passing a pointer to
+    the \a property and the new \a regularExpression as parameters.
+
+    \sa setRegularExpression()
+*/
+
 /*!
     Creates a manager with the given \a parent.
 */
@@ -1325,6 +1792,21 @@ QRegExp QtStringPropertyManager::regExp(const QtProperty *property) const
     return getData<QRegExp>(d_ptr->m_values, &QtStringPropertyManagerPrivate::Data::regExp, property, QRegExp());
 }
 
+/*!
+    Returns the given \a property's currently set QRegularExpression.
+
+    If the given \a property is not managed by this manager, or no
+    regular expression is set, this function returns an expression
+    with an empty pattern.
+
+    \sa setRegularExpression()
+*/
+QRegularExpression QtStringPropertyManager::regularExpression(const QtProperty *property) const
+{
+    return getData<QRegularExpression>(d_ptr->m_values, &QtStringPropertyManagerPrivate::Data::regularExpression,
+                property, QRegularExpression());
+}
+
 /*!
     \reimp
 */
@@ -1357,8 +1839,12 @@ void QtStringPropertyManager::setValue(QtProperty *property, const QString &val)
     if (data.val == val)
         return;
 
-    if (data.regExp.isValid() && !data.regExp.exactMatch(val))
+    if (!data.regularExpression.pattern().isEmpty()) {
+        if (data.anchoredExpression.isValid() && !data.anchoredExpression.match(val).hasMatch())
+            return;
+    } else if (data.regExp.isValid() && !data.regExp.exactMatch(val)) {
         return;
+    }
 
     data.val = val;
 
@@ -1391,6 +1877,30 @@ void QtStringPropertyManager::setRegExp(QtProperty *property, const QRegExp &reg
     emit regExpChanged(property, data.regExp);
 }
 
+/*!
+    Sets the QRegularExpression of the given \a property to \a
+    regularExpression. The whole value has to match it; an expression
+    with an empty pattern unsets it, so that the regExp() is used again.
+
+    \sa regularExpression(), setValue(), regularExpressionChanged()
+*/
+void QtStringPropertyManager::setRegularExpression(QtProperty *property, const QRegularExpression &regularExpression)
+{
+    const QtStringPropertyManagerPrivate::PropertyValueMap::iterator it = d_ptr->m_values.find(property);
+    if (it == d_ptr->m_values.end())
+        return;
+
+    QtStringPropertyManagerPrivate::Data &data = it.value();
+
+    if (data.regularExpression == regularExpression)
+        return;
+
+    d_ptr->releaseExpression(data);
+    d_ptr->acquireExpression(data, regularExpression);
+
+    emit regularExpressionChanged(property, data.regularExpression);
+}
+
 /*!
     \reimp
 */
@@ -1404,7 +1914,11 @@ void QtStringPropertyManager::initializeProperty(QtProperty *property)
 */
 void QtStringPropertyManager::uninitializeProperty(QtProperty *property)
 {
-    d_ptr->m_values.remove(property);
+    const QtStringPropertyManagerPrivate::PropertyValueMap::iterator it = d_ptr->m_values.find(property);
+    if (it == d_ptr->m_values.end())
+        return;
+    d_ptr->releaseExpression(it.value());
+    d_ptr->m_values.erase(it);
 }
 
 // QtBoolPropertyManager
@@ -1415,7 +1929,8 @@ class QtBoolPropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtBoolPropertyManager)
 public:
 
-    QMap<const QtProperty *, bool> m_values;
+    QtPropertySlotMap m_slots;
+    QVector<bool> m_val;
 };
 
 /*!
@@ -1470,7 +1985,7 @@ QtBoolPropertyManager::~QtBoolPropertyManager()
 */
 bool QtBoolPropertyManager::value(const QtProperty *property) const
 {
-    return d_ptr->m_values.value(property, false);
+    return getSlotData<bool>(d_ptr, &QtBoolPropertyManagerPrivate::m_val, property, false);
 }
 
 /*!
@@ -1478,44 +1993,11 @@ bool QtBoolPropertyManager::value(const QtProperty *property) const
 */
 QString QtBoolPropertyManager::valueText(const QtProperty *property) const
 {
-    const QMap<const QtProperty *, bool>::const_iterator it = d_ptr->m_values.constFind(property);
-    if (it == d_ptr->m_values.constEnd())
+    const int slot = d_ptr->m_slots.slotOf(property);
+    if (slot < 0)
         return QString();
 
-    static const QString trueText = tr("True");
-    static const QString falseText = tr("False");
-    return it.value() ? trueText : falseText;
-}
-
-// Return an icon containing a check box indicator
-static QIcon drawCheckBox(bool value)
-{
-    QStyleOptionButton opt;
-    opt.state |= value ? QStyle::State_On : QStyle::State_Off;
-    opt.state |= QStyle::State_Enabled;
-    const QStyle *style = QApplication::style();
-    // Figure out size of an indicator and make sure it is not scaled down in a list view item
-    // by making the pixmap as big as a list view icon and centering the indicator in it.
-    // (if it is smaller, it can't be helped)
-    const int indicatorWidth = style->pixelMetric(QStyle::PM_IndicatorWidth, &opt);
-    const int indicatorHeight = style->pixelMetric(QStyle::PM_IndicatorHeight, &opt);
-    const int listViewIconSize = indicatorWidth;
-    const int pixmapWidth = indicatorWidth;
-    const int pixmapHeight = qMax(indicatorHeight, listViewIconSize);
-
-    opt.rect = QRect(0, 0, indicatorWidth, indicatorHeight);
-    QPixmap pixmap = QPixmap(pixmapWidth, pixmapHeight);
-    pixmap.fill(Qt::transparent);
-    {
-        // Center?
-        const int xoff = (pixmapWidth  > indicatorWidth)  ? (pixmapWidth  - indicatorWidth)  / 2 : 0;
-        const int yoff = (pixmapHeight > indicatorHeight) ? (pixmapHeight - indicatorHeight) / 2 : 0;
-        QPainter painter(&pixmap);
-        painter.translate(xoff, yoff);
-        QCheckBox cb;
-        style->drawPrimitive(QStyle::PE_IndicatorCheckBox, &opt, &painter, &cb);
-    }
-    return QIcon(pixmap);
+    return QtPropertyBrowserUtils::boolValueText(d_ptr->m_val.at(slot));
 }
 
 /*!
@@ -1523,13 +2005,11 @@ static QIcon drawCheckBox(bool value)
 */
 QIcon QtBoolPropertyManager::valueIcon(const QtProperty *property) const
 {
-    const QMap<const QtProperty *, bool>::const_iterator it = d_ptr->m_values.constFind(property);
-    if (it == d_ptr->m_values.constEnd())
+    const int slot = d_ptr->m_slots.slotOf(property);
+    if (slot < 0)
         return QIcon();
 
-    static const QIcon checkedIcon = drawCheckBox(true);
-    static const QIcon uncheckedIcon = drawCheckBox(false);
-    return it.value() ? checkedIcon : uncheckedIcon;
+    return QtPropertyBrowserUtils::boolValueIcon(d_ptr->m_val.at(slot));
 }
 
 /*!
@@ -1541,10 +2021,17 @@ QIcon QtBoolPropertyManager::valueIcon(const QtProperty *property) const
 */
 void QtBoolPropertyManager::setValue(QtProperty *property, bool val)
 {
-    setSimpleValue<bool, bool, QtBoolPropertyManager>(d_ptr->m_values, this,
-                &QtBoolPropertyManager::propertyChanged,
-                &QtBoolPropertyManager::valueChanged,
-                property, val);
+    const int slot = d_ptr->m_slots.slotOf(property);
+    if (slot < 0)
+        return;
+
+    if (d_ptr->m_val.at(slot) == val)
+        return;
+
+    d_ptr->m_val[slot] = val;
+
+    emit propertyChanged(property);
+    emit valueChanged(property, val);
 }
 
 /*!
@@ -1552,7 +2039,8 @@ void QtBoolPropertyManager::setValue(QtProperty *property, bool val)
 */
 void QtBoolPropertyManager::initializeProperty(QtProperty *property)
 {
-    d_ptr->m_values[property] = false;
+    d_ptr->m_slots.insert(property);
+    d_ptr->m_val.append(false);
 }
 
 /*!
@@ -1560,7 +2048,10 @@ void QtBoolPropertyManager::initializeProperty(QtProperty *property)
 */
 void QtBoolPropertyManager::uninitializeProperty(QtProperty *property)
 {
-    d_ptr->m_values.remove(property);
+    const int slot = d_ptr->m_slots.remove(property);
+    if (slot < 0)
+        return;
+    removeSlotValue(d_ptr->m_val, slot);
 }
 
 // QtDatePropertyManager
@@ -1571,6 +2062,8 @@ class QtDatePropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtDatePropertyManager)
 public:
 
+    QtValueTextCache *m_valueTexts;
+
     struct Data
     {
         Data() : val(QDate::currentDate()), minVal(QDate(1752, 9, 14)),
@@ -1640,6 +2133,7 @@ QtDatePropertyManager::QtDatePropertyManager(QObject *parent)
 {
     d_ptr = new QtDatePropertyManagerPrivate;
     d_ptr->q_ptr = this;
+    d_ptr->m_valueTexts = new QtValueTextCache(this);
 
     QLocale loc;
     d_ptr->m_format = loc.dateFormat(QLocale::ShortFormat);
@@ -1692,10 +2186,13 @@ QDate QtDatePropertyManager::maximum(const QtProperty *property) const
 */
 QString QtDatePropertyManager::valueText(const QtProperty *property) const
 {
+    QString text;
+    if (d_ptr->m_valueTexts->find(property, &text))
+        return text;
     const QtDatePropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
     if (it == d_ptr->m_values.constEnd())
         return QString();
-    return it.value().val.toString(d_ptr->m_format);
+    return d_ptr->m_valueTexts->insert(property, it.value().val.toString(d_ptr->m_format));
 }
 
 /*!
@@ -1803,6 +2300,8 @@ class QtTimePropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtTimePropertyManager)
 public:
 
+    QtValueTextCache *m_valueTexts;
+
     QString m_format;
 
     typedef QMap<const QtProperty *, QTime> PropertyValueMap;
@@ -1842,6 +2341,7 @@ QtTimePropertyManager::QtTimePropertyManager(QObject *parent)
 {
     d_ptr = new QtTimePropertyManagerPrivate;
     d_ptr->q_ptr = this;
+    d_ptr->m_valueTexts = new QtValueTextCache(this);
 
     QLocale loc;
     d_ptr->m_format = loc.timeFormat(QLocale::ShortFormat);
@@ -1874,10 +2374,13 @@ QTime QtTimePropertyManager::value(const QtProperty *property) const
 */
 QString QtTimePropertyManager::valueText(const QtProperty *property) const
 {
-   const QtTimePropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
+    QString text;
+    if (d_ptr->m_valueTexts->find(property, &text))
+        return text;
+    const QtTimePropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
     if (it == d_ptr->m_values.constEnd())
         return QString();
-    return it.value().toString(d_ptr->m_format);
+    return d_ptr->m_valueTexts->insert(property, it.value().toString(d_ptr->m_format));
 }
 
 /*!
@@ -1919,6 +2422,8 @@ class QtDateTimePropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtDateTimePropertyManager)
 public:
 
+    QtValueTextCache *m_valueTexts;
+
     QString m_format;
 
     typedef QMap<const QtProperty *, QDateTime> PropertyValueMap;
@@ -1954,6 +2459,7 @@ QtDateTimePropertyManager::QtDateTimePropertyManager(QObject *parent)
 {
     d_ptr = new QtDateTimePropertyManagerPrivate;
     d_ptr->q_ptr = this;
+    d_ptr->m_valueTexts = new QtValueTextCache(this);
 
     QLocale loc;
     d_ptr->m_format = loc.dateFormat(QLocale::ShortFormat);
@@ -1988,10 +2494,13 @@ QDateTime QtDateTimePropertyManager::value(const QtProperty *property) const
 */
 QString QtDateTimePropertyManager::valueText(const QtProperty *property) const
 {
-   const QtDateTimePropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
+    QString text;
+    if (d_ptr->m_valueTexts->find(property, &text))
+        return text;
+    const QtDateTimePropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
     if (it == d_ptr->m_values.constEnd())
         return QString();
-    return it.value().toString(d_ptr->m_format);
+    return d_ptr->m_valueTexts->insert(property, it.value().toString(d_ptr->m_format));
 }
 
 /*!
@@ -2501,43 +3010,41 @@ class QtPointPropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtPointPropertyManager)
 public:
 
+    QtValueTextCache *m_valueTexts;
+
     void slotIntChanged(QtProperty *property, int value);
+    void slotIntValuesChanged(const QList<QtProperty *> &properties)
+        { forwardValuesChanged(this, m_intPropertyManager, &QtPointPropertyManagerPrivate::slotIntChanged, properties); }
     void slotPropertyDestroyed(QtProperty *property);
 
+    enum { XProperty, YProperty };
+
     typedef QMap<const QtProperty *, QPoint> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtIntPropertyManager *m_intPropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToX;
-    QMap<const QtProperty *, QtProperty *> m_propertyToY;
-
-    QMap<const QtProperty *, QtProperty *> m_xToProperty;
-    QMap<const QtProperty *, QtProperty *> m_yToProperty;
+    QtSubPropertyMap m_subProperties;
 };
 
 void QtPointPropertyManagerPrivate::slotIntChanged(QtProperty *property, int value)
 {
-    if (QtProperty *xprop = m_xToProperty.value(property, 0)) {
-        QPoint p = m_values[xprop];
+    int index;
+    QtProperty *prop = m_subProperties.parentProperty(property, &index);
+    if (!prop)
+        return;
+
+    QPoint p = m_values[prop];
+    if (index == XProperty)
         p.setX(value);
-        q_ptr->setValue(xprop, p);
-    } else if (QtProperty *yprop = m_yToProperty.value(property, 0)) {
-        QPoint p = m_values[yprop];
+    else
         p.setY(value);
-        q_ptr->setValue(yprop, p);
-    }
+    q_ptr->setValue(prop, p);
 }
 
 void QtPointPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
 {
-    if (QtProperty *pointProp = m_xToProperty.value(property, 0)) {
-        m_propertyToX[pointProp] = 0;
-        m_xToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_yToProperty.value(property, 0)) {
-        m_propertyToY[pointProp] = 0;
-        m_yToProperty.remove(property);
-    }
+    m_subProperties.subPropertyDestroyed(property);
 }
 
 /*! \class QtPointPropertyManager
@@ -2552,7 +3059,8 @@ void QtPointPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
     manager can be retrieved using the subIntPropertyManager() function. In
     order to provide editing widgets for the subproperties in a
     property browser widget, this manager must be associated with an
-    editor factory.
+    editor factory. The subproperties are deferred until a property
+    browser expands the point property.
 
     In addition, QtPointPropertyManager provides the valueChanged() signal which
     is emitted whenever a property created by this manager changes.
@@ -2578,10 +3086,13 @@ QtPointPropertyManager::QtPointPropertyManager(QObject *parent)
 {
     d_ptr = new QtPointPropertyManagerPrivate;
     d_ptr->q_ptr = this;
+    d_ptr->m_valueTexts = new QtValueTextCache(this);
 
     d_ptr->m_intPropertyManager = new QtIntPropertyManager(this);
     connect(d_ptr->m_intPropertyManager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotIntChanged(QtProperty *, int)));
+    connect(d_ptr->m_intPropertyManager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotIntValuesChanged(QList<QtProperty *>)));
     connect(d_ptr->m_intPropertyManager, SIGNAL(propertyDestroyed(QtProperty *)),
                 this, SLOT(slotPropertyDestroyed(QtProperty *)));
 }
@@ -2628,12 +3139,15 @@ QPoint QtPointPropertyManager::value(const QtProperty *property) const
 */
 QString QtPointPropertyManager::valueText(const QtProperty *property) const
 {
+    QString text;
+    if (d_ptr->m_valueTexts->find(property, &text))
+        return text;
     const QtPointPropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
     if (it == d_ptr->m_values.constEnd())
         return QString();
     const QPoint v = it.value();
-    return QString(tr("(%1, %2)").arg(QString::number(v.x()))
-                                 .arg(QString::number(v.y())));
+    return d_ptr->m_valueTexts->insert(property, QString(tr("(%1, %2)").arg(QString::number(v.x()))
+                                 .arg(QString::number(v.y()))));
 }
 
 /*!
@@ -2654,8 +3168,8 @@ void QtPointPropertyManager::setValue(QtProperty *property, const QPoint &val)
         return;
 
     it.value() = val;
-    d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToX[property], val.x());
-    d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToY[property], val.y());
+    d_ptr->m_intPropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtPointPropertyManagerPrivate::XProperty), val.x());
+    d_ptr->m_intPropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtPointPropertyManagerPrivate::YProperty), val.y());
 
     emit propertyChanged(property);
     emit valueChanged(property, val);
@@ -2667,42 +3181,49 @@ void QtPointPropertyManager::setValue(QtProperty *property, const QPoint &val)
 void QtPointPropertyManager::initializeProperty(QtProperty *property)
 {
     d_ptr->m_values[property] = QPoint(0, 0);
+}
 
-    QtProperty *xProp = d_ptr->m_intPropertyManager->addProperty();
-    xProp->setPropertyName(tr("X"));
-    d_ptr->m_intPropertyManager->setValue(xProp, 0);
-    d_ptr->m_propertyToX[property] = xProp;
-    d_ptr->m_xToProperty[xProp] = property;
-    property->addSubProperty(xProp);
+/*!
+    \reimp
+*/
+void QtPointPropertyManager::uninitializeProperty(QtProperty *property)
+{
+    d_ptr->m_subProperties.remove(property);
 
-    QtProperty *yProp = d_ptr->m_intPropertyManager->addProperty();
-    yProp->setPropertyName(tr("Y"));
-    d_ptr->m_intPropertyManager->setValue(yProp, 0);
-    d_ptr->m_propertyToY[property] = yProp;
-    d_ptr->m_yToProperty[yProp] = property;
-    property->addSubProperty(yProp);
+    d_ptr->m_values.remove(property);
 }
 
 /*!
     \reimp
 */
-void QtPointPropertyManager::uninitializeProperty(QtProperty *property)
+bool QtPointPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
 {
-    QtProperty *xProp = d_ptr->m_propertyToX[property];
-    if (xProp) {
-        d_ptr->m_xToProperty.remove(xProp);
-        delete xProp;
-    }
-    d_ptr->m_propertyToX.remove(property);
+    return d_ptr->m_values.contains(property) && !d_ptr->m_subProperties.contains(property);
+}
 
-    QtProperty *yProp = d_ptr->m_propertyToY[property];
-    if (yProp) {
-        d_ptr->m_yToProperty.remove(yProp);
-        delete yProp;
-    }
-    d_ptr->m_propertyToY.remove(property);
+/*!
+    \reimp
 
-    d_ptr->m_values.remove(property);
+    Creates the \e x and \e y subproperties of the given \a property.
+*/
+void QtPointPropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    if (!hasDeferredSubProperties(property))
+        return;
+
+    const QPoint val = d_ptr->m_values.value(property);
+
+    QtProperty *xProp = d_ptr->m_intPropertyManager->addProperty();
+    xProp->setPropertyName(tr("X"));
+    d_ptr->m_intPropertyManager->setValue(xProp, val.x());
+
+    QtProperty *yProp = d_ptr->m_intPropertyManager->addProperty();
+    yProp->setPropertyName(tr("Y"));
+    d_ptr->m_intPropertyManager->setValue(yProp, val.y());
+
+    d_ptr->m_subProperties.insert(property, QVector<QtProperty *>() << xProp << yProp);
+    property->addSubProperty(xProp);
+    property->addSubProperty(yProp);
 }
 
 // QtPointFPropertyManager
@@ -2713,6 +3234,8 @@ class QtPointFPropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtPointFPropertyManager)
 public:
 
+    QtValueTextCache *m_valueTexts;
+
     struct Data
     {
         Data() : decimals(2) {}
@@ -2721,27 +3244,32 @@ public:
     };
 
     void slotDoubleChanged(QtProperty *property, double value);
+    void slotDoubleValuesChanged(const QList<QtProperty *> &properties)
+        { forwardValuesChanged(this, m_doublePropertyManager, &QtPointFPropertyManagerPrivate::slotDoubleChanged, properties); }
     void slotPropertyDestroyed(QtProperty *property);
 
+    enum { XProperty, YProperty };
+
     typedef QMap<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtDoublePropertyManager *m_doublePropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToX;
-    QMap<const QtProperty *, QtProperty *> m_propertyToY;
-
-    QMap<const QtProperty *, QtProperty *> m_xToProperty;
-    QMap<const QtProperty *, QtProperty *> m_yToProperty;
+    QtSubPropertyMap m_subProperties;
 };
 
 void QtPointFPropertyManagerPrivate::slotDoubleChanged(QtProperty *property, double value)
 {
-    if (QtProperty *prop = m_xToProperty.value(property, 0)) {
+    int index;
+    QtProperty *prop = m_subProperties.parentProperty(property, &index);
+    if (!prop)
+        return;
+
+    if (index == XProperty) {
         QPointF p = m_values[prop].val;
         p.setX(value);
         q_ptr->setValue(prop, p);
-    } else if (QtProperty *prop = m_yToProperty.value(property, 0)) {
+    } else if (index == YProperty) {
         QPointF p = m_values[prop].val;
         p.setY(value);
         q_ptr->setValue(prop, p);
@@ -2750,13 +3278,7 @@ void QtPointFPropertyManagerPrivate::slotDoubleChanged(QtProperty *property, dou
 
 void QtPointFPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
 {
-    if (QtProperty *pointProp  = m_xToProperty.value(property, 0)) {
-        m_propertyToX[pointProp] = 0;
-        m_xToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_yToProperty.value(property, 0)) {
-        m_propertyToY[pointProp] = 0;
-        m_yToProperty.remove(property);
-    }
+    m_subProperties.subPropertyDestroyed(property);
 }
 
 /*! \class QtPointFPropertyManager
@@ -2771,7 +3293,8 @@ void QtPointFPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
     manager can be retrieved using the subDoublePropertyManager() function. In
     order to provide editing widgets for the subproperties in a
     property browser widget, this manager must be associated with an
-    editor factory.
+    editor factory. The subproperties are deferred until a property
+    browser expands the point property.
 
     In addition, QtPointFPropertyManager provides the valueChanged() signal which
     is emitted whenever a property created by this manager changes.
@@ -2807,10 +3330,13 @@ QtPointFPropertyManager::QtPointFPropertyManager(QObject *parent)
 {
     d_ptr = new QtPointFPropertyManagerPrivate;
     d_ptr->q_ptr = this;
+    d_ptr->m_valueTexts = new QtValueTextCache(this);
 
     d_ptr->m_doublePropertyManager = new QtDoublePropertyManager(this);
     connect(d_ptr->m_doublePropertyManager, SIGNAL(valueChanged(QtProperty *, double)),
                 this, SLOT(slotDoubleChanged(QtProperty *, double)));
+    connect(d_ptr->m_doublePropertyManager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotDoubleValuesChanged(QList<QtProperty *>)));
     connect(d_ptr->m_doublePropertyManager, SIGNAL(propertyDestroyed(QtProperty *)),
                 this, SLOT(slotPropertyDestroyed(QtProperty *)));
 }
@@ -2867,13 +3393,16 @@ int QtPointFPropertyManager::decimals(const QtProperty *property) const
 */
 QString QtPointFPropertyManager::valueText(const QtProperty *property) const
 {
+    QString text;
+    if (d_ptr->m_valueTexts->find(property, &text))
+        return text;
     const QtPointFPropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
     if (it == d_ptr->m_values.constEnd())
         return QString();
     const QPointF v = it.value().val;
     const int dec =  it.value().decimals;
-    return QString(tr("(%1, %2)").arg(QString::number(v.x(), 'f', dec))
-                                 .arg(QString::number(v.y(), 'f', dec)));
+    return d_ptr->m_valueTexts->insert(property, QString(tr("(%1, %2)").arg(QString::number(v.x(), 'f', dec))
+                                 .arg(QString::number(v.y(), 'f', dec))));
 }
 
 /*!
@@ -2894,8 +3423,8 @@ void QtPointFPropertyManager::setValue(QtProperty *property, const QPointF &val)
         return;
 
     it.value().val = val;
-    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_propertyToX[property], val.x());
-    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_propertyToY[property], val.y());
+    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtPointFPropertyManagerPrivate::XProperty), val.x());
+    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtPointFPropertyManagerPrivate::YProperty), val.y());
 
     emit propertyChanged(property);
     emit valueChanged(property, val);
@@ -2927,58 +3456,66 @@ void QtPointFPropertyManager::setDecimals(QtProperty *property, int prec)
         return;
 
     data.decimals = prec;
-    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_propertyToX[property], prec);
-    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_propertyToY[property], prec);
+    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_subProperties.subProperty(property, QtPointFPropertyManagerPrivate::XProperty), prec);
+    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_subProperties.subProperty(property, QtPointFPropertyManagerPrivate::YProperty), prec);
 
     it.value() = data;
 
+    emit propertyChanged(property);
     emit decimalsChanged(property, data.decimals);
 }
 
 /*!
     \reimp
 */
-void QtPointFPropertyManager::initializeProperty(QtProperty *property)
+void QtPointFPropertyManager::initializeProperty(QtProperty *property)
+{
+    d_ptr->m_values[property] = QtPointFPropertyManagerPrivate::Data();
+}
+
+/*!
+    \reimp
+*/
+void QtPointFPropertyManager::uninitializeProperty(QtProperty *property)
+{
+    d_ptr->m_subProperties.remove(property);
+
+    d_ptr->m_values.remove(property);
+}
+
+/*!
+    \reimp
+*/
+bool QtPointFPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
 {
-    d_ptr->m_values[property] = QtPointFPropertyManagerPrivate::Data();
-
-    QtProperty *xProp = d_ptr->m_doublePropertyManager->addProperty();
-    xProp->setPropertyName(tr("X"));
-    d_ptr->m_doublePropertyManager->setDecimals(xProp, decimals(property));
-    d_ptr->m_doublePropertyManager->setValue(xProp, 0);
-    d_ptr->m_propertyToX[property] = xProp;
-    d_ptr->m_xToProperty[xProp] = property;
-    property->addSubProperty(xProp);
-
-    QtProperty *yProp = d_ptr->m_doublePropertyManager->addProperty();
-    yProp->setPropertyName(tr("Y"));
-    d_ptr->m_doublePropertyManager->setDecimals(yProp, decimals(property));
-    d_ptr->m_doublePropertyManager->setValue(yProp, 0);
-    d_ptr->m_propertyToY[property] = yProp;
-    d_ptr->m_yToProperty[yProp] = property;
-    property->addSubProperty(yProp);
+    return d_ptr->m_values.contains(property) && !d_ptr->m_subProperties.contains(property);
 }
 
 /*!
     \reimp
+
+    Creates the \e x and \e y subproperties of the given \a property.
 */
-void QtPointFPropertyManager::uninitializeProperty(QtProperty *property)
+void QtPointFPropertyManager::createDeferredSubProperties(QtProperty *property)
 {
-    QtProperty *xProp = d_ptr->m_propertyToX[property];
-    if (xProp) {
-        d_ptr->m_xToProperty.remove(xProp);
-        delete xProp;
-    }
-    d_ptr->m_propertyToX.remove(property);
+    if (!hasDeferredSubProperties(property))
+        return;
 
-    QtProperty *yProp = d_ptr->m_propertyToY[property];
-    if (yProp) {
-        d_ptr->m_yToProperty.remove(yProp);
-        delete yProp;
-    }
-    d_ptr->m_propertyToY.remove(property);
+    const QtPointFPropertyManagerPrivate::Data data = d_ptr->m_values.value(property);
 
-    d_ptr->m_values.remove(property);
+    QtProperty *xProp = d_ptr->m_doublePropertyManager->addProperty();
+    xProp->setPropertyName(tr("X"));
+    d_ptr->m_doublePropertyManager->setDecimals(xProp, data.decimals);
+    d_ptr->m_doublePropertyManager->setValue(xProp, data.val.x());
+
+    QtProperty *yProp = d_ptr->m_doublePropertyManager->addProperty();
+    yProp->setPropertyName(tr("Y"));
+    d_ptr->m_doublePropertyManager->setDecimals(yProp, data.decimals);
+    d_ptr->m_doublePropertyManager->setValue(yProp, data.val.y());
+
+    d_ptr->m_subProperties.insert(property, QVector<QtProperty *>() << xProp << yProp);
+    property->addSubProperty(xProp);
+    property->addSubProperty(yProp);
 }
 
 // QtSizePropertyManager
@@ -2990,6 +3527,8 @@ class QtSizePropertyManagerPrivate
 public:
 
     void slotIntChanged(QtProperty *property, int value);
+    void slotIntValuesChanged(const QList<QtProperty *> &properties)
+        { forwardValuesChanged(this, m_intPropertyManager, &QtSizePropertyManagerPrivate::slotIntChanged, properties); }
     void slotPropertyDestroyed(QtProperty *property);
     void setValue(QtProperty *property, const QSize &val);
     void setRange(QtProperty *property,
@@ -3007,25 +3546,28 @@ public:
         void setMaximumValue(const QSize &newMaxVal) { setSizeMaximumData(this, newMaxVal); }
     };
 
+    enum { WidthProperty, HeightProperty };
+
     typedef QMap<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtIntPropertyManager *m_intPropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToW;
-    QMap<const QtProperty *, QtProperty *> m_propertyToH;
-
-    QMap<const QtProperty *, QtProperty *> m_wToProperty;
-    QMap<const QtProperty *, QtProperty *> m_hToProperty;
+    QtSubPropertyMap m_subProperties;
 };
 
 void QtSizePropertyManagerPrivate::slotIntChanged(QtProperty *property, int value)
 {
-    if (QtProperty *prop = m_wToProperty.value(property, 0)) {
+    int index;
+    QtProperty *prop = m_subProperties.parentProperty(property, &index);
+    if (!prop)
+        return;
+
+    if (index == WidthProperty) {
         QSize s = m_values[prop].val;
         s.setWidth(value);
         q_ptr->setValue(prop, s);
-    } else if (QtProperty *prop = m_hToProperty.value(property, 0)) {
+    } else if (index == HeightProperty) {
         QSize s = m_values[prop].val;
         s.setHeight(value);
         q_ptr->setValue(prop, s);
@@ -3034,26 +3576,20 @@ void QtSizePropertyManagerPrivate::slotIntChanged(QtProperty *property, int valu
 
 void QtSizePropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
 {
-    if (QtProperty *pointProp = m_wToProperty.value(property, 0)) {
-        m_propertyToW[pointProp] = 0;
-        m_wToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_hToProperty.value(property, 0)) {
-        m_propertyToH[pointProp] = 0;
-        m_hToProperty.remove(property);
-    }
+    m_subProperties.subPropertyDestroyed(property);
 }
 
 void QtSizePropertyManagerPrivate::setValue(QtProperty *property, const QSize &val)
 {
-    m_intPropertyManager->setValue(m_propertyToW.value(property), val.width());
-    m_intPropertyManager->setValue(m_propertyToH.value(property), val.height());
+    m_intPropertyManager->setValue(m_subProperties.subProperty(property, WidthProperty), val.width());
+    m_intPropertyManager->setValue(m_subProperties.subProperty(property, HeightProperty), val.height());
 }
 
 void QtSizePropertyManagerPrivate::setRange(QtProperty *property,
                 const QSize &minVal, const QSize &maxVal, const QSize &val)
 {
-    QtProperty *wProperty = m_propertyToW.value(property);
-    QtProperty *hProperty = m_propertyToH.value(property);
+    QtProperty *wProperty = m_subProperties.subProperty(property, WidthProperty);
+    QtProperty *hProperty = m_subProperties.subProperty(property, HeightProperty);
     m_intPropertyManager->setRange(wProperty, minVal.width(), maxVal.width());
     m_intPropertyManager->setValue(wProperty, val.width());
     m_intPropertyManager->setRange(hProperty, minVal.height(), maxVal.height());
@@ -3073,7 +3609,8 @@ void QtSizePropertyManagerPrivate::setRange(QtProperty *property,
     manager can be retrieved using the subIntPropertyManager() function. In
     order to provide editing widgets for the subproperties in a
     property browser widget, this manager must be associated with an
-    editor factory.
+    editor factory. The subproperties are deferred until a property
+    browser expands the size property.
 
     A size property also has a range of valid values defined by a
     minimum size and a maximum size. These sizes can be retrieved
@@ -3121,6 +3658,8 @@ QtSizePropertyManager::QtSizePropertyManager(QObject *parent)
     d_ptr->m_intPropertyManager = new QtIntPropertyManager(this);
     connect(d_ptr->m_intPropertyManager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotIntChanged(QtProperty *, int)));
+    connect(d_ptr->m_intPropertyManager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotIntValuesChanged(QList<QtProperty *>)));
     connect(d_ptr->m_intPropertyManager, SIGNAL(propertyDestroyed(QtProperty *)),
                 this, SLOT(slotPropertyDestroyed(QtProperty *)));
 }
@@ -3285,44 +3824,51 @@ void QtSizePropertyManager::setRange(QtProperty *property, const QSize &minVal,
 void QtSizePropertyManager::initializeProperty(QtProperty *property)
 {
     d_ptr->m_values[property] = QtSizePropertyManagerPrivate::Data();
+}
 
-    QtProperty *wProp = d_ptr->m_intPropertyManager->addProperty();
-    wProp->setPropertyName(tr("Width"));
-    d_ptr->m_intPropertyManager->setValue(wProp, 0);
-    d_ptr->m_intPropertyManager->setMinimum(wProp, 0);
-    d_ptr->m_propertyToW[property] = wProp;
-    d_ptr->m_wToProperty[wProp] = property;
-    property->addSubProperty(wProp);
+/*!
+    \reimp
+*/
+void QtSizePropertyManager::uninitializeProperty(QtProperty *property)
+{
+    d_ptr->m_subProperties.remove(property);
 
-    QtProperty *hProp = d_ptr->m_intPropertyManager->addProperty();
-    hProp->setPropertyName(tr("Height"));
-    d_ptr->m_intPropertyManager->setValue(hProp, 0);
-    d_ptr->m_intPropertyManager->setMinimum(hProp, 0);
-    d_ptr->m_propertyToH[property] = hProp;
-    d_ptr->m_hToProperty[hProp] = property;
-    property->addSubProperty(hProp);
+    d_ptr->m_values.remove(property);
 }
 
 /*!
     \reimp
 */
-void QtSizePropertyManager::uninitializeProperty(QtProperty *property)
+bool QtSizePropertyManager::hasDeferredSubProperties(const QtProperty *property) const
 {
-    QtProperty *wProp = d_ptr->m_propertyToW[property];
-    if (wProp) {
-        d_ptr->m_wToProperty.remove(wProp);
-        delete wProp;
-    }
-    d_ptr->m_propertyToW.remove(property);
+    return d_ptr->m_values.contains(property) && !d_ptr->m_subProperties.contains(property);
+}
 
-    QtProperty *hProp = d_ptr->m_propertyToH[property];
-    if (hProp) {
-        d_ptr->m_hToProperty.remove(hProp);
-        delete hProp;
-    }
-    d_ptr->m_propertyToH.remove(property);
+/*!
+    \reimp
 
-    d_ptr->m_values.remove(property);
+    Creates the \e width and \e height subproperties of the given \a property.
+*/
+void QtSizePropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    if (!hasDeferredSubProperties(property))
+        return;
+
+    const QtSizePropertyManagerPrivate::Data data = d_ptr->m_values.value(property);
+
+    QtProperty *wProp = d_ptr->m_intPropertyManager->addProperty();
+    wProp->setPropertyName(tr("Width"));
+    d_ptr->m_intPropertyManager->setRange(wProp, data.minVal.width(), data.maxVal.width());
+    d_ptr->m_intPropertyManager->setValue(wProp, data.val.width());
+
+    QtProperty *hProp = d_ptr->m_intPropertyManager->addProperty();
+    hProp->setPropertyName(tr("Height"));
+    d_ptr->m_intPropertyManager->setRange(hProp, data.minVal.height(), data.maxVal.height());
+    d_ptr->m_intPropertyManager->setValue(hProp, data.val.height());
+
+    d_ptr->m_subProperties.insert(property, QVector<QtProperty *>() << wProp << hProp);
+    property->addSubProperty(wProp);
+    property->addSubProperty(hProp);
 }
 
 // QtSizeFPropertyManager
@@ -3334,6 +3880,8 @@ class QtSizeFPropertyManagerPrivate
 public:
 
     void slotDoubleChanged(QtProperty *property, double value);
+    void slotDoubleValuesChanged(const QList<QtProperty *> &properties)
+        { forwardValuesChanged(this, m_doublePropertyManager, &QtSizeFPropertyManagerPrivate::slotDoubleChanged, properties); }
     void slotPropertyDestroyed(QtProperty *property);
     void setValue(QtProperty *property, const QSizeF &val);
     void setRange(QtProperty *property,
@@ -3352,25 +3900,28 @@ public:
         void setMaximumValue(const QSizeF &newMaxVal) { setSizeMaximumData(this, newMaxVal); }
     };
 
+    enum { WidthProperty, HeightProperty };
+
     typedef QMap<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtDoublePropertyManager *m_doublePropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToW;
-    QMap<const QtProperty *, QtProperty *> m_propertyToH;
-
-    QMap<const QtProperty *, QtProperty *> m_wToProperty;
-    QMap<const QtProperty *, QtProperty *> m_hToProperty;
+    QtSubPropertyMap m_subProperties;
 };
 
 void QtSizeFPropertyManagerPrivate::slotDoubleChanged(QtProperty *property, double value)
 {
-    if (QtProperty *prop = m_wToProperty.value(property, 0)) {
+    int index;
+    QtProperty *prop = m_subProperties.parentProperty(property, &index);
+    if (!prop)
+        return;
+
+    if (index == WidthProperty) {
         QSizeF s = m_values[prop].val;
         s.setWidth(value);
         q_ptr->setValue(prop, s);
-    } else if (QtProperty *prop = m_hToProperty.value(property, 0)) {
+    } else if (index == HeightProperty) {
         QSizeF s = m_values[prop].val;
         s.setHeight(value);
         q_ptr->setValue(prop, s);
@@ -3379,28 +3930,22 @@ void QtSizeFPropertyManagerPrivate::slotDoubleChanged(QtProperty *property, doub
 
 void QtSizeFPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
 {
-    if (QtProperty *pointProp = m_wToProperty.value(property, 0)) {
-        m_propertyToW[pointProp] = 0;
-        m_wToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_hToProperty.value(property, 0)) {
-        m_propertyToH[pointProp] = 0;
-        m_hToProperty.remove(property);
-    }
+    m_subProperties.subPropertyDestroyed(property);
 }
 
 void QtSizeFPropertyManagerPrivate::setValue(QtProperty *property, const QSizeF &val)
 {
-    m_doublePropertyManager->setValue(m_propertyToW.value(property), val.width());
-    m_doublePropertyManager->setValue(m_propertyToH.value(property), val.height());
+    m_doublePropertyManager->setValue(m_subProperties.subProperty(property, WidthProperty), val.width());
+    m_doublePropertyManager->setValue(m_subProperties.subProperty(property, HeightProperty), val.height());
 }
 
 void QtSizeFPropertyManagerPrivate::setRange(QtProperty *property,
                 const QSizeF &minVal, const QSizeF &maxVal, const QSizeF &val)
 {
-    m_doublePropertyManager->setRange(m_propertyToW[property], minVal.width(), maxVal.width());
-    m_doublePropertyManager->setValue(m_propertyToW[property], val.width());
-    m_doublePropertyManager->setRange(m_propertyToH[property], minVal.height(), maxVal.height());
-    m_doublePropertyManager->setValue(m_propertyToH[property], val.height());
+    m_doublePropertyManager->setRange(m_subProperties.subProperty(property, WidthProperty), minVal.width(), maxVal.width());
+    m_doublePropertyManager->setValue(m_subProperties.subProperty(property, WidthProperty), val.width());
+    m_doublePropertyManager->setRange(m_subProperties.subProperty(property, HeightProperty), minVal.height(), maxVal.height());
+    m_doublePropertyManager->setValue(m_subProperties.subProperty(property, HeightProperty), val.height());
 }
 
 /*!
@@ -3416,7 +3961,8 @@ void QtSizeFPropertyManagerPrivate::setRange(QtProperty *property,
     manager can be retrieved using the subDoublePropertyManager() function. In
     order to provide editing widgets for the subproperties in a
     property browser widget, this manager must be associated with an
-    editor factory.
+    editor factory. The subproperties are deferred until a property
+    browser expands the size property.
 
     A size property also has a range of valid values defined by a
     minimum size and a maximum size. These sizes can be retrieved
@@ -3474,6 +4020,8 @@ QtSizeFPropertyManager::QtSizeFPropertyManager(QObject *parent)
     d_ptr->m_doublePropertyManager = new QtDoublePropertyManager(this);
     connect(d_ptr->m_doublePropertyManager, SIGNAL(valueChanged(QtProperty *, double)),
                 this, SLOT(slotDoubleChanged(QtProperty *, double)));
+    connect(d_ptr->m_doublePropertyManager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotDoubleValuesChanged(QList<QtProperty *>)));
     connect(d_ptr->m_doublePropertyManager, SIGNAL(propertyDestroyed(QtProperty *)),
                 this, SLOT(slotPropertyDestroyed(QtProperty *)));
 }
@@ -3604,8 +4152,8 @@ void QtSizeFPropertyManager::setDecimals(QtProperty *property, int prec)
         return;
 
     data.decimals = prec;
-    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_propertyToW[property], prec);
-    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_propertyToH[property], prec);
+    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_subProperties.subProperty(property, QtSizeFPropertyManagerPrivate::WidthProperty), prec);
+    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_subProperties.subProperty(property, QtSizeFPropertyManagerPrivate::HeightProperty), prec);
 
     it.value() = data;
 
@@ -3683,46 +4231,53 @@ void QtSizeFPropertyManager::setRange(QtProperty *property, const QSizeF &minVal
 void QtSizeFPropertyManager::initializeProperty(QtProperty *property)
 {
     d_ptr->m_values[property] = QtSizeFPropertyManagerPrivate::Data();
+}
 
-    QtProperty *wProp = d_ptr->m_doublePropertyManager->addProperty();
-    wProp->setPropertyName(tr("Width"));
-    d_ptr->m_doublePropertyManager->setDecimals(wProp, decimals(property));
-    d_ptr->m_doublePropertyManager->setValue(wProp, 0);
-    d_ptr->m_doublePropertyManager->setMinimum(wProp, 0);
-    d_ptr->m_propertyToW[property] = wProp;
-    d_ptr->m_wToProperty[wProp] = property;
-    property->addSubProperty(wProp);
+/*!
+    \reimp
+*/
+void QtSizeFPropertyManager::uninitializeProperty(QtProperty *property)
+{
+    d_ptr->m_subProperties.remove(property);
 
-    QtProperty *hProp = d_ptr->m_doublePropertyManager->addProperty();
-    hProp->setPropertyName(tr("Height"));
-    d_ptr->m_doublePropertyManager->setDecimals(hProp, decimals(property));
-    d_ptr->m_doublePropertyManager->setValue(hProp, 0);
-    d_ptr->m_doublePropertyManager->setMinimum(hProp, 0);
-    d_ptr->m_propertyToH[property] = hProp;
-    d_ptr->m_hToProperty[hProp] = property;
-    property->addSubProperty(hProp);
+    d_ptr->m_values.remove(property);
 }
 
 /*!
     \reimp
 */
-void QtSizeFPropertyManager::uninitializeProperty(QtProperty *property)
+bool QtSizeFPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
 {
-    QtProperty *wProp = d_ptr->m_propertyToW[property];
-    if (wProp) {
-        d_ptr->m_wToProperty.remove(wProp);
-        delete wProp;
-    }
-    d_ptr->m_propertyToW.remove(property);
+    return d_ptr->m_values.contains(property) && !d_ptr->m_subProperties.contains(property);
+}
 
-    QtProperty *hProp = d_ptr->m_propertyToH[property];
-    if (hProp) {
-        d_ptr->m_hToProperty.remove(hProp);
-        delete hProp;
-    }
-    d_ptr->m_propertyToH.remove(property);
+/*!
+    \reimp
 
-    d_ptr->m_values.remove(property);
+    Creates the \e width and \e height subproperties of the given \a property.
+*/
+void QtSizeFPropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    if (!hasDeferredSubProperties(property))
+        return;
+
+    const QtSizeFPropertyManagerPrivate::Data data = d_ptr->m_values.value(property);
+
+    QtProperty *wProp = d_ptr->m_doublePropertyManager->addProperty();
+    wProp->setPropertyName(tr("Width"));
+    d_ptr->m_doublePropertyManager->setDecimals(wProp, data.decimals);
+    d_ptr->m_doublePropertyManager->setRange(wProp, data.minVal.width(), data.maxVal.width());
+    d_ptr->m_doublePropertyManager->setValue(wProp, data.val.width());
+
+    QtProperty *hProp = d_ptr->m_doublePropertyManager->addProperty();
+    hProp->setPropertyName(tr("Height"));
+    d_ptr->m_doublePropertyManager->setDecimals(hProp, data.decimals);
+    d_ptr->m_doublePropertyManager->setRange(hProp, data.minVal.height(), data.maxVal.height());
+    d_ptr->m_doublePropertyManager->setValue(hProp, data.val.height());
+
+    d_ptr->m_subProperties.insert(property, QVector<QtProperty *>() << wProp << hProp);
+    property->addSubProperty(wProp);
+    property->addSubProperty(hProp);
 }
 
 // QtRectPropertyManager
@@ -3733,9 +4288,13 @@ class QtRectPropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtRectPropertyManager)
 public:
 
+    QtValueTextCache *m_valueTexts;
+
     void slotIntChanged(QtProperty *property, int value);
+    void slotIntValuesChanged(const QList<QtProperty *> &properties)
+        { forwardValuesChanged(this, m_intPropertyManager, &QtRectPropertyManagerPrivate::slotIntChanged, properties); }
     void slotPropertyDestroyed(QtProperty *property);
-    void setConstraint(QtProperty *property, const QRect &constraint, const QRect &val);
+    void setConstraint(const QVector<QtProperty *> &subProperties, const QRect &constraint, const QRect &val);
 
     struct Data
     {
@@ -3744,33 +4303,32 @@ public:
         QRect constraint;
     };
 
+    enum { XProperty, YProperty, WidthProperty, HeightProperty };
+
     typedef QMap<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtIntPropertyManager *m_intPropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToX;
-    QMap<const QtProperty *, QtProperty *> m_propertyToY;
-    QMap<const QtProperty *, QtProperty *> m_propertyToW;
-    QMap<const QtProperty *, QtProperty *> m_propertyToH;
-
-    QMap<const QtProperty *, QtProperty *> m_xToProperty;
-    QMap<const QtProperty *, QtProperty *> m_yToProperty;
-    QMap<const QtProperty *, QtProperty *> m_wToProperty;
-    QMap<const QtProperty *, QtProperty *> m_hToProperty;
+    QtSubPropertyMap m_subProperties;
 };
 
 void QtRectPropertyManagerPrivate::slotIntChanged(QtProperty *property, int value)
 {
-    if (QtProperty *prop = m_xToProperty.value(property, 0)) {
+    int index;
+    QtProperty *prop = m_subProperties.parentProperty(property, &index);
+    if (!prop)
+        return;
+
+    if (index == XProperty) {
         QRect r = m_values[prop].val;
         r.moveLeft(value);
         q_ptr->setValue(prop, r);
-    } else if (QtProperty *prop = m_yToProperty.value(property)) {
+    } else if (index == YProperty) {
         QRect r = m_values[prop].val;
         r.moveTop(value);
         q_ptr->setValue(prop, r);
-    } else if (QtProperty *prop = m_wToProperty.value(property, 0)) {
+    } else if (index == WidthProperty) {
         Data data = m_values[prop];
         QRect r = data.val;
         r.setWidth(value);
@@ -3778,7 +4336,7 @@ void QtRectPropertyManagerPrivate::slotIntChanged(QtProperty *property, int valu
             r.moveLeft(data.constraint.left() + data.constraint.width() - r.width());
         }
         q_ptr->setValue(prop, r);
-    } else if (QtProperty *prop = m_hToProperty.value(property, 0)) {
+    } else if (index == HeightProperty) {
         Data data = m_values[prop];
         QRect r = data.val;
         r.setHeight(value);
@@ -3791,24 +4349,15 @@ void QtRectPropertyManagerPrivate::slotIntChanged(QtProperty *property, int valu
 
 void QtRectPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
 {
-    if (QtProperty *pointProp = m_xToProperty.value(property, 0)) {
-        m_propertyToX[pointProp] = 0;
-        m_xToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_yToProperty.value(property, 0)) {
-        m_propertyToY[pointProp] = 0;
-        m_yToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_wToProperty.value(property, 0)) {
-        m_propertyToW[pointProp] = 0;
-        m_wToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_hToProperty.value(property, 0)) {
-        m_propertyToH[pointProp] = 0;
-        m_hToProperty.remove(property);
-    }
+    m_subProperties.subPropertyDestroyed(property);
 }
 
-void QtRectPropertyManagerPrivate::setConstraint(QtProperty *property,
+void QtRectPropertyManagerPrivate::setConstraint(const QVector<QtProperty *> &subProperties,
             const QRect &constraint, const QRect &val)
 {
+    if (subProperties.isEmpty())
+        return;
+
     const bool isNull = constraint.isNull();
     const int left   = isNull ? INT_MIN : constraint.left();
     const int right  = isNull ? INT_MAX : constraint.left() + constraint.width();
@@ -3817,15 +4366,15 @@ void QtRectPropertyManagerPrivate::setConstraint(QtProperty *property,
     const int width  = isNull ? INT_MAX : constraint.width();
     const int height = isNull ? INT_MAX : constraint.height();
 
-    m_intPropertyManager->setRange(m_propertyToX[property], left, right);
-    m_intPropertyManager->setRange(m_propertyToY[property], top, bottom);
-    m_intPropertyManager->setRange(m_propertyToW[property], 0, width);
-    m_intPropertyManager->setRange(m_propertyToH[property], 0, height);
+    m_intPropertyManager->setRange(subProperties.at(XProperty), left, right);
+    m_intPropertyManager->setRange(subProperties.at(YProperty), top, bottom);
+    m_intPropertyManager->setRange(subProperties.at(WidthProperty), 0, width);
+    m_intPropertyManager->setRange(subProperties.at(HeightProperty), 0, height);
 
-    m_intPropertyManager->setValue(m_propertyToX[property], val.x());
-    m_intPropertyManager->setValue(m_propertyToY[property], val.y());
-    m_intPropertyManager->setValue(m_propertyToW[property], val.width());
-    m_intPropertyManager->setValue(m_propertyToH[property], val.height());
+    m_intPropertyManager->setValue(subProperties.at(XProperty), val.x());
+    m_intPropertyManager->setValue(subProperties.at(YProperty), val.y());
+    m_intPropertyManager->setValue(subProperties.at(WidthProperty), val.width());
+    m_intPropertyManager->setValue(subProperties.at(HeightProperty), val.height());
 }
 
 /*!
@@ -3841,7 +4390,8 @@ void QtRectPropertyManagerPrivate::setConstraint(QtProperty *property,
     manager can be retrieved using the subIntPropertyManager() function. In
     order to provide editing widgets for the subproperties in a
     property browser widget, this manager must be associated with an
-    editor factory.
+    editor factory. The subproperties are deferred until a property
+    browser expands the rectangle property.
 
     A rectangle property also has a constraint rectangle which can be
     retrieved using the constraint() function, and set using the
@@ -3883,10 +4433,13 @@ QtRectPropertyManager::QtRectPropertyManager(QObject *parent)
 {
     d_ptr = new QtRectPropertyManagerPrivate;
     d_ptr->q_ptr = this;
+    d_ptr->m_valueTexts = new QtValueTextCache(this);
 
     d_ptr->m_intPropertyManager = new QtIntPropertyManager(this);
     connect(d_ptr->m_intPropertyManager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotIntChanged(QtProperty *, int)));
+    connect(d_ptr->m_intPropertyManager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotIntValuesChanged(QList<QtProperty *>)));
     connect(d_ptr->m_intPropertyManager, SIGNAL(propertyDestroyed(QtProperty *)),
                 this, SLOT(slotPropertyDestroyed(QtProperty *)));
 }
@@ -3943,14 +4496,17 @@ QRect QtRectPropertyManager::constraint(const QtProperty *property) const
 */
 QString QtRectPropertyManager::valueText(const QtProperty *property) const
 {
+    QString text;
+    if (d_ptr->m_valueTexts->find(property, &text))
+        return text;
     const QtRectPropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
     if (it == d_ptr->m_values.constEnd())
         return QString();
     const QRect v = it.value().val;
-    return QString(tr("[(%1, %2), %3 x %4]").arg(QString::number(v.x()))
+    return d_ptr->m_valueTexts->insert(property, QString(tr("[(%1, %2), %3 x %4]").arg(QString::number(v.x()))
                                 .arg(QString::number(v.y()))
                                 .arg(QString::number(v.width()))
-                                .arg(QString::number(v.height())));
+                                .arg(QString::number(v.height()))));
 }
 
 /*!
@@ -3991,10 +4547,10 @@ void QtRectPropertyManager::setValue(QtProperty *property, const QRect &val)
     data.val = newRect;
 
     it.value() = data;
-    d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToX[property], newRect.x());
-    d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToY[property], newRect.y());
-    d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToW[property], newRect.width());
-    d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToH[property], newRect.height());
+    d_ptr->m_intPropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtRectPropertyManagerPrivate::XProperty), newRect.x());
+    d_ptr->m_intPropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtRectPropertyManagerPrivate::YProperty), newRect.y());
+    d_ptr->m_intPropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtRectPropertyManagerPrivate::WidthProperty), newRect.width());
+    d_ptr->m_intPropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtRectPropertyManagerPrivate::HeightProperty), newRect.height());
 
     emit propertyChanged(property);
     emit valueChanged(property, data.val);
@@ -4050,7 +4606,7 @@ void QtRectPropertyManager::setConstraint(QtProperty *property, const QRect &con
 
     emit constraintChanged(property, data.constraint);
 
-    d_ptr->setConstraint(property, data.constraint, data.val);
+    d_ptr->setConstraint(d_ptr->m_subProperties.subProperties(property), data.constraint, data.val);
 
     if (data.val == oldVal)
         return;
@@ -4065,72 +4621,65 @@ void QtRectPropertyManager::setConstraint(QtProperty *property, const QRect &con
 void QtRectPropertyManager::initializeProperty(QtProperty *property)
 {
     d_ptr->m_values[property] = QtRectPropertyManagerPrivate::Data();
+}
+
+/*!
+    \reimp
+*/
+void QtRectPropertyManager::uninitializeProperty(QtProperty *property)
+{
+    d_ptr->m_subProperties.remove(property);
+
+    d_ptr->m_values.remove(property);
+}
+
+/*!
+    \reimp
+*/
+bool QtRectPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
+{
+    return d_ptr->m_values.contains(property) && !d_ptr->m_subProperties.contains(property);
+}
+
+/*!
+    \reimp
+
+    Creates the \e x, \e y, \e width and \e height subproperties of the given \a property.
+*/
+void QtRectPropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    if (!hasDeferredSubProperties(property))
+        return;
+
+    const QtRectPropertyManagerPrivate::Data data = d_ptr->m_values.value(property);
 
     QtProperty *xProp = d_ptr->m_intPropertyManager->addProperty();
     xProp->setPropertyName(tr("X"));
-    d_ptr->m_intPropertyManager->setValue(xProp, 0);
-    d_ptr->m_propertyToX[property] = xProp;
-    d_ptr->m_xToProperty[xProp] = property;
-    property->addSubProperty(xProp);
+    d_ptr->m_intPropertyManager->setValue(xProp, data.val.x());
 
     QtProperty *yProp = d_ptr->m_intPropertyManager->addProperty();
     yProp->setPropertyName(tr("Y"));
-    d_ptr->m_intPropertyManager->setValue(yProp, 0);
-    d_ptr->m_propertyToY[property] = yProp;
-    d_ptr->m_yToProperty[yProp] = property;
-    property->addSubProperty(yProp);
+    d_ptr->m_intPropertyManager->setValue(yProp, data.val.y());
 
     QtProperty *wProp = d_ptr->m_intPropertyManager->addProperty();
     wProp->setPropertyName(tr("Width"));
-    d_ptr->m_intPropertyManager->setValue(wProp, 0);
     d_ptr->m_intPropertyManager->setMinimum(wProp, 0);
-    d_ptr->m_propertyToW[property] = wProp;
-    d_ptr->m_wToProperty[wProp] = property;
-    property->addSubProperty(wProp);
+    d_ptr->m_intPropertyManager->setValue(wProp, data.val.width());
 
     QtProperty *hProp = d_ptr->m_intPropertyManager->addProperty();
     hProp->setPropertyName(tr("Height"));
-    d_ptr->m_intPropertyManager->setValue(hProp, 0);
     d_ptr->m_intPropertyManager->setMinimum(hProp, 0);
-    d_ptr->m_propertyToH[property] = hProp;
-    d_ptr->m_hToProperty[hProp] = property;
-    property->addSubProperty(hProp);
-}
-
-/*!
-    \reimp
-*/
-void QtRectPropertyManager::uninitializeProperty(QtProperty *property)
-{
-    QtProperty *xProp = d_ptr->m_propertyToX[property];
-    if (xProp) {
-        d_ptr->m_xToProperty.remove(xProp);
-        delete xProp;
-    }
-    d_ptr->m_propertyToX.remove(property);
-
-    QtProperty *yProp = d_ptr->m_propertyToY[property];
-    if (yProp) {
-        d_ptr->m_yToProperty.remove(yProp);
-        delete yProp;
-    }
-    d_ptr->m_propertyToY.remove(property);
-
-    QtProperty *wProp = d_ptr->m_propertyToW[property];
-    if (wProp) {
-        d_ptr->m_wToProperty.remove(wProp);
-        delete wProp;
-    }
-    d_ptr->m_propertyToW.remove(property);
+    d_ptr->m_intPropertyManager->setValue(hProp, data.val.height());
 
-    QtProperty *hProp = d_ptr->m_propertyToH[property];
-    if (hProp) {
-        d_ptr->m_hToProperty.remove(hProp);
-        delete hProp;
-    }
-    d_ptr->m_propertyToH.remove(property);
+    const QVector<QtProperty *> subProperties = QVector<QtProperty *>() << xProp << yProp << wProp << hProp;
+    if (!data.constraint.isNull())
+        d_ptr->setConstraint(subProperties, data.constraint, data.val);
 
-    d_ptr->m_values.remove(property);
+    d_ptr->m_subProperties.insert(property, subProperties);
+    property->addSubProperty(xProp);
+    property->addSubProperty(yProp);
+    property->addSubProperty(wProp);
+    property->addSubProperty(hProp);
 }
 
 // QtRectFPropertyManager
@@ -4141,9 +4690,13 @@ class QtRectFPropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtRectFPropertyManager)
 public:
 
+    QtValueTextCache *m_valueTexts;
+
     void slotDoubleChanged(QtProperty *property, double value);
+    void slotDoubleValuesChanged(const QList<QtProperty *> &properties)
+        { forwardValuesChanged(this, m_doublePropertyManager, &QtRectFPropertyManagerPrivate::slotDoubleChanged, properties); }
     void slotPropertyDestroyed(QtProperty *property);
-    void setConstraint(QtProperty *property, const QRectF &constraint, const QRectF &val);
+    void setConstraint(const QVector<QtProperty *> &subProperties, const QRectF &constraint, const QRectF &val);
 
     struct Data
     {
@@ -4153,33 +4706,32 @@ public:
         int decimals;
     };
 
+    enum { XProperty, YProperty, WidthProperty, HeightProperty };
+
     typedef QMap<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtDoublePropertyManager *m_doublePropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToX;
-    QMap<const QtProperty *, QtProperty *> m_propertyToY;
-    QMap<const QtProperty *, QtProperty *> m_propertyToW;
-    QMap<const QtProperty *, QtProperty *> m_propertyToH;
-
-    QMap<const QtProperty *, QtProperty *> m_xToProperty;
-    QMap<const QtProperty *, QtProperty *> m_yToProperty;
-    QMap<const QtProperty *, QtProperty *> m_wToProperty;
-    QMap<const QtProperty *, QtProperty *> m_hToProperty;
+    QtSubPropertyMap m_subProperties;
 };
 
 void QtRectFPropertyManagerPrivate::slotDoubleChanged(QtProperty *property, double value)
 {
-    if (QtProperty *prop = m_xToProperty.value(property, 0)) {
+    int index;
+    QtProperty *prop = m_subProperties.parentProperty(property, &index);
+    if (!prop)
+        return;
+
+    if (index == XProperty) {
         QRectF r = m_values[prop].val;
         r.moveLeft(value);
         q_ptr->setValue(prop, r);
-    } else if (QtProperty *prop = m_yToProperty.value(property, 0)) {
+    } else if (index == YProperty) {
         QRectF r = m_values[prop].val;
         r.moveTop(value);
         q_ptr->setValue(prop, r);
-    } else if (QtProperty *prop = m_wToProperty.value(property, 0)) {
+    } else if (index == WidthProperty) {
         Data data = m_values[prop];
         QRectF r = data.val;
         r.setWidth(value);
@@ -4187,7 +4739,7 @@ void QtRectFPropertyManagerPrivate::slotDoubleChanged(QtProperty *property, doub
             r.moveLeft(data.constraint.left() + data.constraint.width() - r.width());
         }
         q_ptr->setValue(prop, r);
-    } else if (QtProperty *prop = m_hToProperty.value(property, 0)) {
+    } else if (index == HeightProperty) {
         Data data = m_values[prop];
         QRectF r = data.val;
         r.setHeight(value);
@@ -4200,24 +4752,15 @@ void QtRectFPropertyManagerPrivate::slotDoubleChanged(QtProperty *property, doub
 
 void QtRectFPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
 {
-    if (QtProperty *pointProp = m_xToProperty.value(property, 0)) {
-        m_propertyToX[pointProp] = 0;
-        m_xToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_yToProperty.value(property, 0)) {
-        m_propertyToY[pointProp] = 0;
-        m_yToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_wToProperty.value(property, 0)) {
-        m_propertyToW[pointProp] = 0;
-        m_wToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_hToProperty.value(property, 0)) {
-        m_propertyToH[pointProp] = 0;
-        m_hToProperty.remove(property);
-    }
+    m_subProperties.subPropertyDestroyed(property);
 }
 
-void QtRectFPropertyManagerPrivate::setConstraint(QtProperty *property,
+void QtRectFPropertyManagerPrivate::setConstraint(const QVector<QtProperty *> &subProperties,
             const QRectF &constraint, const QRectF &val)
 {
+    if (subProperties.isEmpty())
+        return;
+
     const bool isNull = constraint.isNull();
     const float left   = isNull ? FLT_MIN : constraint.left();
     const float right  = isNull ? FLT_MAX : constraint.left() + constraint.width();
@@ -4226,15 +4769,15 @@ void QtRectFPropertyManagerPrivate::setConstraint(QtProperty *property,
     const float width  = isNull ? FLT_MAX : constraint.width();
     const float height = isNull ? FLT_MAX : constraint.height();
 
-    m_doublePropertyManager->setRange(m_propertyToX[property], left, right);
-    m_doublePropertyManager->setRange(m_propertyToY[property], top, bottom);
-    m_doublePropertyManager->setRange(m_propertyToW[property], 0, width);
-    m_doublePropertyManager->setRange(m_propertyToH[property], 0, height);
+    m_doublePropertyManager->setRange(subProperties.at(XProperty), left, right);
+    m_doublePropertyManager->setRange(subProperties.at(YProperty), top, bottom);
+    m_doublePropertyManager->setRange(subProperties.at(WidthProperty), 0, width);
+    m_doublePropertyManager->setRange(subProperties.at(HeightProperty), 0, height);
 
-    m_doublePropertyManager->setValue(m_propertyToX[property], val.x());
-    m_doublePropertyManager->setValue(m_propertyToY[property], val.y());
-    m_doublePropertyManager->setValue(m_propertyToW[property], val.width());
-    m_doublePropertyManager->setValue(m_propertyToH[property], val.height());
+    m_doublePropertyManager->setValue(subProperties.at(XProperty), val.x());
+    m_doublePropertyManager->setValue(subProperties.at(YProperty), val.y());
+    m_doublePropertyManager->setValue(subProperties.at(WidthProperty), val.width());
+    m_doublePropertyManager->setValue(subProperties.at(HeightProperty), val.height());
 }
 
 /*!
@@ -4250,7 +4793,8 @@ void QtRectFPropertyManagerPrivate::setConstraint(QtProperty *property,
     manager can be retrieved using the subDoublePropertyManager() function. In
     order to provide editing widgets for the subproperties in a
     property browser widget, this manager must be associated with an
-    editor factory.
+    editor factory. The subproperties are deferred until a property
+    browser expands the rectangle property.
 
     A rectangle property also has a constraint rectangle which can be
     retrieved using the constraint() function, and set using the
@@ -4302,10 +4846,13 @@ QtRectFPropertyManager::QtRectFPropertyManager(QObject *parent)
 {
     d_ptr = new QtRectFPropertyManagerPrivate;
     d_ptr->q_ptr = this;
+    d_ptr->m_valueTexts = new QtValueTextCache(this);
 
     d_ptr->m_doublePropertyManager = new QtDoublePropertyManager(this);
     connect(d_ptr->m_doublePropertyManager, SIGNAL(valueChanged(QtProperty *, double)),
                 this, SLOT(slotDoubleChanged(QtProperty *, double)));
+    connect(d_ptr->m_doublePropertyManager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotDoubleValuesChanged(QList<QtProperty *>)));
     connect(d_ptr->m_doublePropertyManager, SIGNAL(propertyDestroyed(QtProperty *)),
                 this, SLOT(slotPropertyDestroyed(QtProperty *)));
 }
@@ -4372,15 +4919,18 @@ QRectF QtRectFPropertyManager::constraint(const QtProperty *property) const
 */
 QString QtRectFPropertyManager::valueText(const QtProperty *property) const
 {
+    QString text;
+    if (d_ptr->m_valueTexts->find(property, &text))
+        return text;
     const QtRectFPropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
     if (it == d_ptr->m_values.constEnd())
         return QString();
     const QRectF v = it.value().val;
     const int dec = it.value().decimals;
-    return QString(tr("[(%1, %2), %3 x %4]").arg(QString::number(v.x(), 'f', dec))
+    return d_ptr->m_valueTexts->insert(property, QString(tr("[(%1, %2), %3 x %4]").arg(QString::number(v.x(), 'f', dec))
                                 .arg(QString::number(v.y(), 'f', dec))
                                 .arg(QString::number(v.width(), 'f', dec))
-                                .arg(QString::number(v.height(), 'f', dec)));
+                                .arg(QString::number(v.height(), 'f', dec))));
 }
 
 /*!
@@ -4421,10 +4971,10 @@ void QtRectFPropertyManager::setValue(QtProperty *property, const QRectF &val)
     data.val = newRect;
 
     it.value() = data;
-    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_propertyToX[property], newRect.x());
-    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_propertyToY[property], newRect.y());
-    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_propertyToW[property], newRect.width());
-    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_propertyToH[property], newRect.height());
+    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtRectFPropertyManagerPrivate::XProperty), newRect.x());
+    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtRectFPropertyManagerPrivate::YProperty), newRect.y());
+    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtRectFPropertyManagerPrivate::WidthProperty), newRect.width());
+    d_ptr->m_doublePropertyManager->setValue(d_ptr->m_subProperties.subProperty(property, QtRectFPropertyManagerPrivate::HeightProperty), newRect.height());
 
     emit propertyChanged(property);
     emit valueChanged(property, data.val);
@@ -4480,7 +5030,7 @@ void QtRectFPropertyManager::setConstraint(QtProperty *property, const QRectF &c
 
     emit constraintChanged(property, data.constraint);
 
-    d_ptr->setConstraint(property, data.constraint, data.val);
+    d_ptr->setConstraint(d_ptr->m_subProperties.subProperties(property), data.constraint, data.val);
 
     if (data.val == oldVal)
         return;
@@ -4515,13 +5065,14 @@ void QtRectFPropertyManager::setDecimals(QtProperty *property, int prec)
         return;
 
     data.decimals = prec;
-    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_propertyToX[property], prec);
-    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_propertyToY[property], prec);
-    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_propertyToW[property], prec);
-    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_propertyToH[property], prec);
+    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_subProperties.subProperty(property, QtRectFPropertyManagerPrivate::XProperty), prec);
+    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_subProperties.subProperty(property, QtRectFPropertyManagerPrivate::YProperty), prec);
+    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_subProperties.subProperty(property, QtRectFPropertyManagerPrivate::WidthProperty), prec);
+    d_ptr->m_doublePropertyManager->setDecimals(d_ptr->m_subProperties.subProperty(property, QtRectFPropertyManagerPrivate::HeightProperty), prec);
 
     it.value() = data;
 
+    emit propertyChanged(property);
     emit decimalsChanged(property, data.decimals);
 }
 
@@ -4531,76 +5082,69 @@ void QtRectFPropertyManager::setDecimals(QtProperty *property, int prec)
 void QtRectFPropertyManager::initializeProperty(QtProperty *property)
 {
     d_ptr->m_values[property] = QtRectFPropertyManagerPrivate::Data();
+}
+
+/*!
+    \reimp
+*/
+void QtRectFPropertyManager::uninitializeProperty(QtProperty *property)
+{
+    d_ptr->m_subProperties.remove(property);
+
+    d_ptr->m_values.remove(property);
+}
+
+/*!
+    \reimp
+*/
+bool QtRectFPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
+{
+    return d_ptr->m_values.contains(property) && !d_ptr->m_subProperties.contains(property);
+}
+
+/*!
+    \reimp
+
+    Creates the \e x, \e y, \e width and \e height subproperties of the given \a property.
+*/
+void QtRectFPropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    if (!hasDeferredSubProperties(property))
+        return;
+
+    const QtRectFPropertyManagerPrivate::Data data = d_ptr->m_values.value(property);
 
     QtProperty *xProp = d_ptr->m_doublePropertyManager->addProperty();
     xProp->setPropertyName(tr("X"));
-    d_ptr->m_doublePropertyManager->setDecimals(xProp, decimals(property));
-    d_ptr->m_doublePropertyManager->setValue(xProp, 0);
-    d_ptr->m_propertyToX[property] = xProp;
-    d_ptr->m_xToProperty[xProp] = property;
-    property->addSubProperty(xProp);
+    d_ptr->m_doublePropertyManager->setDecimals(xProp, data.decimals);
+    d_ptr->m_doublePropertyManager->setValue(xProp, data.val.x());
 
     QtProperty *yProp = d_ptr->m_doublePropertyManager->addProperty();
     yProp->setPropertyName(tr("Y"));
-    d_ptr->m_doublePropertyManager->setDecimals(yProp, decimals(property));
-    d_ptr->m_doublePropertyManager->setValue(yProp, 0);
-    d_ptr->m_propertyToY[property] = yProp;
-    d_ptr->m_yToProperty[yProp] = property;
-    property->addSubProperty(yProp);
+    d_ptr->m_doublePropertyManager->setDecimals(yProp, data.decimals);
+    d_ptr->m_doublePropertyManager->setValue(yProp, data.val.y());
 
     QtProperty *wProp = d_ptr->m_doublePropertyManager->addProperty();
     wProp->setPropertyName(tr("Width"));
-    d_ptr->m_doublePropertyManager->setDecimals(wProp, decimals(property));
-    d_ptr->m_doublePropertyManager->setValue(wProp, 0);
+    d_ptr->m_doublePropertyManager->setDecimals(wProp, data.decimals);
     d_ptr->m_doublePropertyManager->setMinimum(wProp, 0);
-    d_ptr->m_propertyToW[property] = wProp;
-    d_ptr->m_wToProperty[wProp] = property;
-    property->addSubProperty(wProp);
+    d_ptr->m_doublePropertyManager->setValue(wProp, data.val.width());
 
     QtProperty *hProp = d_ptr->m_doublePropertyManager->addProperty();
     hProp->setPropertyName(tr("Height"));
-    d_ptr->m_doublePropertyManager->setDecimals(hProp, decimals(property));
-    d_ptr->m_doublePropertyManager->setValue(hProp, 0);
+    d_ptr->m_doublePropertyManager->setDecimals(hProp, data.decimals);
     d_ptr->m_doublePropertyManager->setMinimum(hProp, 0);
-    d_ptr->m_propertyToH[property] = hProp;
-    d_ptr->m_hToProperty[hProp] = property;
-    property->addSubProperty(hProp);
-}
-
-/*!
-    \reimp
-*/
-void QtRectFPropertyManager::uninitializeProperty(QtProperty *property)
-{
-    QtProperty *xProp = d_ptr->m_propertyToX[property];
-    if (xProp) {
-        d_ptr->m_xToProperty.remove(xProp);
-        delete xProp;
-    }
-    d_ptr->m_propertyToX.remove(property);
-
-    QtProperty *yProp = d_ptr->m_propertyToY[property];
-    if (yProp) {
-        d_ptr->m_yToProperty.remove(yProp);
-        delete yProp;
-    }
-    d_ptr->m_propertyToY.remove(property);
+    d_ptr->m_doublePropertyManager->setValue(hProp, data.val.height());
 
-    QtProperty *wProp = d_ptr->m_propertyToW[property];
-    if (wProp) {
-        d_ptr->m_wToProperty.remove(wProp);
-        delete wProp;
-    }
-    d_ptr->m_propertyToW.remove(property);
-
-    QtProperty *hProp = d_ptr->m_propertyToH[property];
-    if (hProp) {
-        d_ptr->m_hToProperty.remove(hProp);
-        delete hProp;
-    }
-    d_ptr->m_propertyToH.remove(property);
+    const QVector<QtProperty *> subProperties = QVector<QtProperty *>() << xProp << yProp << wProp << hProp;
+    if (!data.constraint.isNull())
+        d_ptr->setConstraint(subProperties, data.constraint, data.val);
 
-    d_ptr->m_values.remove(property);
+    d_ptr->m_subProperties.insert(property, subProperties);
+    property->addSubProperty(xProp);
+    property->addSubProperty(yProp);
+    property->addSubProperty(wProp);
+    property->addSubProperty(hProp);
 }
 
 // QtEnumPropertyManager
@@ -4611,17 +5155,127 @@ class QtEnumPropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtEnumPropertyManager)
 public:
 
+    // The names and icons of an enum, shared by all properties that use
+    // them. Registered types live until they are unregistered; the types
+    // created by setEnumNames() and setEnumIcons() are interned by
+    // content and go away with the last property using them.
+    struct EnumType : public QSharedData
+    {
+        EnumType() : id(-1), internedTypes(0), model(0) {}
+        ~EnumType();
+        QStringList enumNames;
+        QMap<int, QIcon> enumIcons;
+        int id;
+        QString key;
+        QHash<QString, EnumType *> *internedTypes;
+        QStandardItemModel *model;
+    };
+    typedef QExplicitlySharedDataPointer<EnumType> EnumTypePointer;
+
     struct Data
     {
         Data() : val(-1) {}
         int val;
-        QStringList enumNames;
-        QMap<int, QIcon> enumIcons;
+        EnumTypePointer type;
     };
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
-    PropertyValueMap m_values;
-};
+    EnumTypePointer internType(const QStringList &enumNames, const QMap<int, QIcon> &enumIcons);
+    void setType(QtProperty *property, const EnumTypePointer &type);
+
+    QHash<QString, EnumType *> m_internedTypes;
+    QList<EnumTypePointer> m_registeredTypes;
+
+    typedef QMap<const QtProperty *, Data> PropertyValueMap;
+    PropertyValueMap m_values;
+};
+
+QtEnumPropertyManagerPrivate::EnumType::~EnumType()
+{
+    if (internedTypes)
+        internedTypes->remove(key);
+    delete model;
+}
+
+static bool enumIconsEqual(const QMap<int, QIcon> &icons1, const QMap<int, QIcon> &icons2)
+{
+    if (icons1.count() != icons2.count())
+        return false;
+    QMap<int, QIcon>::ConstIterator it1 = icons1.constBegin();
+    QMap<int, QIcon>::ConstIterator it2 = icons2.constBegin();
+    for ( ; it1 != icons1.constEnd(); ++it1, ++it2) {
+        if (it1.key() != it2.key() || it1.value().cacheKey() != it2.value().cacheKey())
+            return false;
+    }
+    return true;
+}
+
+QtEnumPropertyManagerPrivate::EnumTypePointer QtEnumPropertyManagerPrivate::internType(
+            const QStringList &enumNames, const QMap<int, QIcon> &enumIcons)
+{
+    QString key = enumNames.join(QString(QChar(0)));
+    key += QChar(1);
+    const QMap<int, QIcon>::ConstIterator icend = enumIcons.constEnd();
+    for (QMap<int, QIcon>::ConstIterator it = enumIcons.constBegin(); it != icend; ++it) {
+        key += QString::number(it.key()) + QLatin1Char(':')
+                + QString::number(it.value().cacheKey()) + QLatin1Char(';');
+    }
+
+    EnumType *type = m_internedTypes.value(key, 0);
+    if (type && type->enumNames == enumNames && enumIconsEqual(type->enumIcons, enumIcons))
+        return EnumTypePointer(type);
+
+    type = new EnumType;
+    type->enumNames = enumNames;
+    type->enumIcons = enumIcons;
+    if (!m_internedTypes.contains(key)) {
+        type->key = key;
+        type->internedTypes = &m_internedTypes;
+        m_internedTypes.insert(key, type);
+    }
+    return EnumTypePointer(type);
+}
+
+// Switches property to type, resetting its value like setEnumNames() does
+// when the names differ.
+void QtEnumPropertyManagerPrivate::setType(QtProperty *property, const EnumTypePointer &type)
+{
+    const PropertyValueMap::iterator it = m_values.find(property);
+    if (it == m_values.end())
+        return;
+
+    Data &data = it.value();
+    if (data.type == type)
+        return;
+
+    const EnumTypePointer oldType = data.type;
+    data.type = type;
+
+    const bool iconsChanged = !enumIconsEqual(oldType->enumIcons, type->enumIcons);
+    if (iconsChanged)
+        emit q_ptr->enumIconsChanged(property, type->enumIcons);
+
+    if (oldType->enumNames == type->enumNames) {
+        // Same contents under another type: editors still show the old
+        // type's model, which is about to go away with it.
+        if (!iconsChanged && oldType->model) {
+            if (!type->model && oldType->ref.load() == 1) {
+                type->model = oldType->model;
+                oldType->model = 0;
+            } else {
+                emit q_ptr->enumNamesChanged(property, type->enumNames);
+            }
+        }
+        emit q_ptr->propertyChanged(property);
+        return;
+    }
+
+    data.val = type->enumNames.isEmpty() ? -1 : 0;
+    const int val = data.val;
+
+    emit q_ptr->enumNamesChanged(property, type->enumNames);
+    emit q_ptr->propertyChanged(property);
+    emit q_ptr->valueChanged(property, val);
+}
 
 /*!
     \class QtEnumPropertyManager
@@ -4638,6 +5292,13 @@ public:
     values to icons can be set using the setEnumIcons() function and
     queried with the enumIcons() function.
 
+    Properties with the same names and icons share a single copy of
+    them. An enum type can also be registered up front with
+    registerEnumType() and assigned to any number of properties with
+    setEnumType(). The enumModel() function returns an item model of
+    the names and icons that editors of all properties of the same
+    type can share.
+
     In addition, QtEnumPropertyManager provides the valueChanged() signal
     which is emitted whenever a property created by this manager
     changes. The enumNamesChanged() or enumIconsChanged() signal is emitted
@@ -4716,7 +5377,10 @@ int QtEnumPropertyManager::value(const QtProperty *property) const
 */
 QStringList QtEnumPropertyManager::enumNames(const QtProperty *property) const
 {
-    return getData<QStringList>(d_ptr->m_values, &QtEnumPropertyManagerPrivate::Data::enumNames, property, QStringList());
+    const QtEnumPropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
+        return QStringList();
+    return it.value().type->enumNames;
 }
 
 /*!
@@ -4726,7 +5390,98 @@ QStringList QtEnumPropertyManager::enumNames(const QtProperty *property) const
 */
 QMap<int, QIcon> QtEnumPropertyManager::enumIcons(const QtProperty *property) const
 {
-    return getData<QMap<int, QIcon> >(d_ptr->m_values, &QtEnumPropertyManagerPrivate::Data::enumIcons, property, QMap<int, QIcon>());
+    const QtEnumPropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
+        return QMap<int, QIcon>();
+    return it.value().type->enumIcons;
+}
+
+/*!
+    Returns a list model holding the given \a property's enum names and
+    icons, or 0 if the property is not managed by this manager.
+
+    The model is owned by the manager and shared by all properties with
+    the same enum type. It stays valid until the property's names or
+    icons change.
+
+    \sa enumNames(), enumIcons(), enumNamesChanged()
+*/
+QAbstractItemModel *QtEnumPropertyManager::enumModel(const QtProperty *property) const
+{
+    const QtEnumPropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
+        return 0;
+
+    QtEnumPropertyManagerPrivate::EnumType *type = it.value().type.data();
+    if (!type->model) {
+        type->model = new QStandardItemModel(const_cast<QtEnumPropertyManager *>(this));
+        const int nameCount = type->enumNames.count();
+        for (int i = 0; i < nameCount; i++) {
+            QStandardItem *item = new QStandardItem(type->enumNames.at(i));
+            item->setIcon(type->enumIcons.value(i));
+            type->model->appendRow(item);
+        }
+    }
+    return type->model;
+}
+
+/*!
+    Registers an enum type with the given \a names and \a icons and
+    returns its id, for use with setEnumType().
+
+    Registered types cannot be changed. Calling setEnumNames() or
+    setEnumIcons() on a property gives that property its own type.
+    The ids of unregistered types are reused.
+
+    \sa setEnumType(), enumType(), unregisterEnumType()
+*/
+int QtEnumPropertyManager::registerEnumType(const QStringList &names, const QMap<int, QIcon> &icons)
+{
+    QtEnumPropertyManagerPrivate::EnumTypePointer type(new QtEnumPropertyManagerPrivate::EnumType);
+    type->enumNames = names;
+    type->enumIcons = icons;
+    type->id = d_ptr->m_registeredTypes.indexOf(QtEnumPropertyManagerPrivate::EnumTypePointer());
+    if (type->id == -1) {
+        type->id = d_ptr->m_registeredTypes.count();
+        d_ptr->m_registeredTypes.append(type);
+    } else {
+        d_ptr->m_registeredTypes[type->id] = type;
+    }
+    return type->id;
+}
+
+/*!
+    Releases the registered enum \a type. Properties using the type keep
+    its names and icons until they are given others, but enumType()
+    returns -1 for them and the id can no longer be passed to
+    setEnumType().
+
+    \sa registerEnumType()
+*/
+void QtEnumPropertyManager::unregisterEnumType(int type)
+{
+    if (type < 0 || type >= d_ptr->m_registeredTypes.count())
+        return;
+
+    QtEnumPropertyManagerPrivate::EnumTypePointer &registeredType = d_ptr->m_registeredTypes[type];
+    if (!registeredType)
+        return;
+    registeredType->id = -1;
+    registeredType.reset();
+}
+
+/*!
+    Returns the id of the registered enum type of the given \a property,
+    or -1 if the property does not use a registered type.
+
+    \sa registerEnumType(), setEnumType()
+*/
+int QtEnumPropertyManager::enumType(const QtProperty *property) const
+{
+    const QtEnumPropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
+        return -1;
+    return it.value().type->id;
 }
 
 /*!
@@ -4741,8 +5496,9 @@ QString QtEnumPropertyManager::valueText(const QtProperty *property) const
     const QtEnumPropertyManagerPrivate::Data &data = it.value();
 
     const int v = data.val;
-    if (v >= 0 && v < data.enumNames.count())
-        return data.enumNames.at(v);
+    const QStringList &enumNames = data.type->enumNames;
+    if (v >= 0 && v < enumNames.count())
+        return enumNames.at(v);
     return QString();
 }
 
@@ -4758,7 +5514,7 @@ QIcon QtEnumPropertyManager::valueIcon(const QtProperty *property) const
     const QtEnumPropertyManagerPrivate::Data &data = it.value();
 
     const int v = data.val;
-    return data.enumIcons.value(v);
+    return data.type->enumIcons.value(v);
 }
 
 /*!
@@ -4777,12 +5533,13 @@ void QtEnumPropertyManager::setValue(QtProperty *property, int val)
     if (it == d_ptr->m_values.end())
         return;
 
-    QtEnumPropertyManagerPrivate::Data data = it.value();
+    QtEnumPropertyManagerPrivate::Data &data = it.value();
+    const int nameCount = data.type->enumNames.count();
 
-    if (val >= data.enumNames.count())
+    if (val >= nameCount)
         return;
 
-    if (val < 0 && data.enumNames.count() > 0)
+    if (val < 0 && nameCount > 0)
         return;
 
     if (val < 0)
@@ -4793,10 +5550,8 @@ void QtEnumPropertyManager::setValue(QtProperty *property, int val)
 
     data.val = val;
 
-    it.value() = data;
-
     emit propertyChanged(property);
-    emit valueChanged(property, data.val);
+    emit valueChanged(property, val);
 }
 
 /*!
@@ -4815,24 +5570,12 @@ void QtEnumPropertyManager::setEnumNames(QtProperty *property, const QStringList
     if (it == d_ptr->m_values.end())
         return;
 
-    QtEnumPropertyManagerPrivate::Data data = it.value();
+    const QtEnumPropertyManagerPrivate::EnumTypePointer type = it.value().type;
 
-    if (data.enumNames == enumNames)
+    if (type->enumNames == enumNames)
         return;
 
-    data.enumNames = enumNames;
-
-    data.val = -1;
-
-    if (enumNames.count() > 0)
-        data.val = 0;
-
-    it.value() = data;
-
-    emit enumNamesChanged(property, data.enumNames);
-
-    emit propertyChanged(property);
-    emit valueChanged(property, data.val);
+    d_ptr->setType(property, d_ptr->internType(enumNames, type->enumIcons));
 }
 
 /*!
@@ -4849,11 +5592,26 @@ void QtEnumPropertyManager::setEnumIcons(QtProperty *property, const QMap<int, Q
     if (it == d_ptr->m_values.end())
         return;
 
-    it.value().enumIcons = enumIcons;
+    const QtEnumPropertyManagerPrivate::EnumTypePointer type = it.value().type;
 
-    emit enumIconsChanged(property, it.value().enumIcons);
+    d_ptr->setType(property, d_ptr->internType(type->enumNames, enumIcons));
+}
 
-    emit propertyChanged(property);
+/*!
+    Gives the given \a property the names and icons of the registered
+    enum \a type.
+
+    If the names differ from the property's current names, its value is
+    reset to 0, or to -1 if the type has no names.
+
+    \sa registerEnumType(), enumType()
+*/
+void QtEnumPropertyManager::setEnumType(QtProperty *property, int type)
+{
+    if (type < 0 || type >= d_ptr->m_registeredTypes.count() || !d_ptr->m_registeredTypes.at(type))
+        return;
+
+    d_ptr->setType(property, d_ptr->m_registeredTypes.at(type));
 }
 
 /*!
@@ -4861,7 +5619,9 @@ void QtEnumPropertyManager::setEnumIcons(QtProperty *property, const QMap<int, Q
 */
 void QtEnumPropertyManager::initializeProperty(QtProperty *property)
 {
-    d_ptr->m_values[property] = QtEnumPropertyManagerPrivate::Data();
+    QtEnumPropertyManagerPrivate::Data data;
+    data.type = d_ptr->internType(QStringList(), QMap<int, QIcon>());
+    d_ptr->m_values[property] = data;
 }
 
 /*!
@@ -4883,6 +5643,11 @@ public:
     void slotBoolChanged(QtProperty *property, bool value);
     void slotPropertyDestroyed(QtProperty *property);
 
+    QStringList sharedFlagNames(const QStringList &flagNames);
+    void releaseFlagNames(const QStringList &flagNames);
+    void createFlagProperties(QtProperty *property);
+    void deleteFlagProperties(QtProperty *property);
+
     struct Data
     {
         Data() : val(-1) {}
@@ -4893,8 +5658,21 @@ public:
     typedef QMap<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
+    struct FlagNameList
+    {
+        FlagNameList() : refCount(0) {}
+        QStringList flagNames;
+        int refCount;
+    };
+
+    // One copy of each distinct list of flag names, shared by all
+    // properties using it and dropped with the last of them.
+    QHash<QString, FlagNameList> m_flagNameLists;
+
     QtBoolPropertyManager *m_boolPropertyManager;
 
+    // Only holds the properties whose flag subproperties have been
+    // created, see createDeferredSubProperties().
     QMap<const QtProperty *, QList<QtProperty *> > m_propertyToFlags;
 
     QMap<const QtProperty *, QtProperty *> m_flagToProperty;
@@ -4934,6 +5712,67 @@ void QtFlagPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
     m_flagToProperty.remove(property);
 }
 
+static inline QString flagNameListKey(const QStringList &flagNames)
+{
+    return flagNames.join(QString(QChar(0)));
+}
+
+// Returns the shared copy of flagNames for a property that starts using it;
+// the property must give it back with releaseFlagNames().
+QStringList QtFlagPropertyManagerPrivate::sharedFlagNames(const QStringList &flagNames)
+{
+    if (flagNames.isEmpty())
+        return QStringList();
+
+    FlagNameList &list = m_flagNameLists[flagNameListKey(flagNames)];
+    if (list.refCount == 0)
+        list.flagNames = flagNames;
+    ++list.refCount;
+    return list.flagNames;
+}
+
+void QtFlagPropertyManagerPrivate::releaseFlagNames(const QStringList &flagNames)
+{
+    if (flagNames.isEmpty())
+        return;
+
+    const QHash<QString, FlagNameList>::iterator it = m_flagNameLists.find(flagNameListKey(flagNames));
+    if (it != m_flagNameLists.end() && --it.value().refCount == 0)
+        m_flagNameLists.erase(it);
+}
+
+void QtFlagPropertyManagerPrivate::createFlagProperties(QtProperty *property)
+{
+    const Data data = m_values.value(property);
+    QList<QtProperty *> &flags = m_propertyToFlags[property];
+
+    int level = 0;
+    QStringListIterator itFlag(data.flagNames);
+    while (itFlag.hasNext()) {
+        const QString flagName = itFlag.next();
+        QtProperty *prop = m_boolPropertyManager->addProperty();
+        prop->setPropertyName(flagName);
+        m_boolPropertyManager->setValue(prop, data.val & (1 << level));
+        property->addSubProperty(prop);
+        flags.append(prop);
+        m_flagToProperty[prop] = property;
+        level++;
+    }
+}
+
+void QtFlagPropertyManagerPrivate::deleteFlagProperties(QtProperty *property)
+{
+    QListIterator<QtProperty *> itProp(m_propertyToFlags.value(property));
+    while (itProp.hasNext()) {
+        QtProperty *prop = itProp.next();
+        if (prop) {
+            delete prop;
+            m_flagToProperty.remove(prop);
+        }
+    }
+    m_propertyToFlags.remove(property);
+}
+
 /*!
     \class QtFlagPropertyManager
 
@@ -4957,6 +5796,11 @@ void QtFlagPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
     property browser widget, this manager must be associated with an
     editor factory.
 
+    The subproperties are deferred: they are only created once a
+    property browser expands the flag property, see
+    QtAbstractPropertyBrowser::createDeferredSubProperties(). Properties with equal
+    flag names share one copy of the list.
+
     In addition, QtFlagPropertyManager provides the valueChanged() signal
     which is emitted whenever a property created by this manager
     changes, and the flagNamesChanged() signal which is emitted
@@ -5109,7 +5953,7 @@ void QtFlagPropertyManager::setValue(QtProperty *property, int val)
 
     it.value() = data;
 
-    QListIterator<QtProperty *> itProp(d_ptr->m_propertyToFlags[property]);
+    QListIterator<QtProperty *> itProp(d_ptr->m_propertyToFlags.value(property));
     int level = 0;
     while (itProp.hasNext()) {
         QtProperty *prop = itProp.next();
@@ -5140,29 +5984,17 @@ void QtFlagPropertyManager::setFlagNames(QtProperty *property, const QStringList
     if (data.flagNames == flagNames)
         return;
 
-    data.flagNames = flagNames;
+    d_ptr->releaseFlagNames(data.flagNames);
+    data.flagNames = d_ptr->sharedFlagNames(flagNames);
     data.val = 0;
 
     it.value() = data;
 
-    QListIterator<QtProperty *> itProp(d_ptr->m_propertyToFlags[property]);
-    while (itProp.hasNext()) {
-        QtProperty *prop = itProp.next();
-        if (prop) {
-            delete prop;
-            d_ptr->m_flagToProperty.remove(prop);
-        }
-    }
-    d_ptr->m_propertyToFlags[property].clear();
-
-    QStringListIterator itFlag(flagNames);
-    while (itFlag.hasNext()) {
-        const QString flagName = itFlag.next();
-        QtProperty *prop = d_ptr->m_boolPropertyManager->addProperty();
-        prop->setPropertyName(flagName);
-        property->addSubProperty(prop);
-        d_ptr->m_propertyToFlags[property].append(prop);
-        d_ptr->m_flagToProperty[prop] = property;
+    // Properties already expanded get their new subproperties right
+    // away, the others keep deferring them.
+    if (d_ptr->m_propertyToFlags.contains(property)) {
+        d_ptr->deleteFlagProperties(property);
+        d_ptr->createFlagProperties(property);
     }
 
     emit flagNamesChanged(property, data.flagNames);
@@ -5177,8 +6009,6 @@ void QtFlagPropertyManager::setFlagNames(QtProperty *property, const QStringList
 void QtFlagPropertyManager::initializeProperty(QtProperty *property)
 {
     d_ptr->m_values[property] = QtFlagPropertyManagerPrivate::Data();
-
-    d_ptr->m_propertyToFlags[property] = QList<QtProperty *>();
 }
 
 /*!
@@ -5186,19 +6016,36 @@ void QtFlagPropertyManager::initializeProperty(QtProperty *property)
 */
 void QtFlagPropertyManager::uninitializeProperty(QtProperty *property)
 {
-    QListIterator<QtProperty *> itProp(d_ptr->m_propertyToFlags[property]);
-    while (itProp.hasNext()) {
-        QtProperty *prop = itProp.next();
-        if (prop) {
-            delete prop;
-            d_ptr->m_flagToProperty.remove(prop);
-        }
-    }
-    d_ptr->m_propertyToFlags.remove(property);
+    d_ptr->deleteFlagProperties(property);
 
+    d_ptr->releaseFlagNames(d_ptr->m_values.value(property).flagNames);
     d_ptr->m_values.remove(property);
 }
 
+/*!
+    \reimp
+*/
+bool QtFlagPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
+{
+    const QtFlagPropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
+        return false;
+    return !it.value().flagNames.isEmpty() && !d_ptr->m_propertyToFlags.contains(property);
+}
+
+/*!
+    \reimp
+
+    Creates the boolean subproperties of the given flag \a property.
+*/
+void QtFlagPropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    if (!hasDeferredSubProperties(property))
+        return;
+
+    d_ptr->createFlagProperties(property);
+}
+
 // QtSizePolicyPropertyManager
 
 class QtSizePolicyPropertyManagerPrivate
@@ -5210,6 +6057,8 @@ public:
     QtSizePolicyPropertyManagerPrivate();
 
     void slotIntChanged(QtProperty *property, int value);
+    void slotIntValuesChanged(const QList<QtProperty *> &properties)
+        { forwardValuesChanged(this, m_intPropertyManager, &QtSizePolicyPropertyManagerPrivate::slotIntChanged, properties); }
     void slotEnumChanged(QtProperty *property, int value);
     void slotPropertyDestroyed(QtProperty *property);
 
@@ -5322,6 +6171,8 @@ QtSizePolicyPropertyManager::QtSizePolicyPropertyManager(QObject *parent)
     d_ptr->m_intPropertyManager = new QtIntPropertyManager(this);
     connect(d_ptr->m_intPropertyManager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotIntChanged(QtProperty *, int)));
+    connect(d_ptr->m_intPropertyManager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotIntValuesChanged(QList<QtProperty *>)));
     d_ptr->m_enumPropertyManager = new QtEnumPropertyManager(this);
     connect(d_ptr->m_enumPropertyManager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotEnumChanged(QtProperty *, int)));
@@ -5517,14 +6368,105 @@ void QtSizePolicyPropertyManager::uninitializeProperty(QtProperty *property)
 }
 
 // QtFontPropertyManager:
-// QtFontPropertyManagerPrivate has a mechanism for reacting
-// to QApplication::fontDatabaseChanged() [4.5], which is emitted
-// when someone loads an application font. The signals are compressed
-// using a timer with interval 0, which then causes the family
-// enumeration manager to re-set its strings and index values
-// for each property.
+// The first QFontDatabase query can take a long time on systems with many
+// fonts, so the family list is read once for all font managers, on a worker
+// thread started when control returns to the event loop after the first
+// manager has been created. Qt 5 serializes QFontDatabase queries with an
+// internal mutex, so families() may be called from there; the result comes
+// back to the GUI thread through a queued call. The loader keeps the names in
+// one enum type that the family subproperties of all managers share.
+// QtFontFamilyLoader also reacts to QApplication::fontDatabaseChanged() [4.5],
+// which is emitted when someone loads an application font. The signals are
+// compressed using the same timer with interval 0, which then triggers a
+// reload; the managers then re-set the family enumeration of each property.
+
+class QtFontFamilyLoader : public QObject
+{
+    Q_OBJECT
+public:
+    QtFontFamilyLoader();
+
+    bool isLoaded() const { return m_familyType.data() != 0; }
+    QtEnumPropertyManagerPrivate::EnumTypePointer familyType() const { return m_familyType; }
+
+    void load();
+
+Q_SIGNALS:
+    void familiesLoaded();
+
+private Q_SLOTS:
+    void slotLoad();
+    void slotFamiliesRead(const QStringList &families);
+    void slotFontDatabaseChanged();
+
+private:
+    QtEnumPropertyManagerPrivate::EnumTypePointer m_familyType;
+    QTimer *m_loadTimer;
+    // Destroyed before the QObject part of the loader, waiting for a read
+    // still in progress.
+    QThreadPool m_readerPool;
+};
+
+class QtFontFamilyReader : public QRunnable
+{
+public:
+    explicit QtFontFamilyReader(QtFontFamilyLoader *loader) : m_loader(loader) {}
+
+    void run()
+    {
+        QFontDatabase fontDatabase;
+        QMetaObject::invokeMethod(m_loader, "slotFamiliesRead", Qt::QueuedConnection,
+                    Q_ARG(QStringList, fontDatabase.families()));
+    }
+
+private:
+    QtFontFamilyLoader *m_loader;
+};
+
+QtFontFamilyLoader::QtFontFamilyLoader() :
+    m_loadTimer(0)
+{
+    // One reader at a time, so reloads finish in the order they started.
+    m_readerPool.setMaxThreadCount(1);
+}
+
+void QtFontFamilyLoader::load()
+{
+    if (m_loadTimer)
+        return;
+    m_loadTimer = new QTimer(this);
+    m_loadTimer->setInterval(0);
+    m_loadTimer->setSingleShot(true);
+    QObject::connect(m_loadTimer, SIGNAL(timeout()), this, SLOT(slotLoad()));
+#if QT_VERSION >= 0x040500
+    QObject::connect(qApp, SIGNAL(fontDatabaseChanged()), this, SLOT(slotFontDatabaseChanged()));
+#endif
+    m_loadTimer->start();
+}
+
+void QtFontFamilyLoader::slotLoad()
+{
+    m_readerPool.start(new QtFontFamilyReader(this));
+}
+
+void QtFontFamilyLoader::slotFamiliesRead(const QStringList &families)
+{
+    if (m_familyType && m_familyType->enumNames == families)
+        return;
+    // Properties still pointing at the previous type keep it alive until
+    // the managers have moved them over.
+    m_familyType = new QtEnumPropertyManagerPrivate::EnumType;
+    m_familyType->enumNames = families;
+    emit familiesLoaded();
+}
+
+void QtFontFamilyLoader::slotFontDatabaseChanged()
+{
+    if (!m_loadTimer->isActive())
+        m_loadTimer->start();
+}
 
-Q_GLOBAL_STATIC(QFontDatabase, fontDatabase)
+Q_GLOBAL_STATIC(QtFontFamilyLoader, fontFamilyLoader)
 
 class QtFontPropertyManagerPrivate
 {
@@ -5535,13 +6477,17 @@ public:
     QtFontPropertyManagerPrivate();
 
     void slotIntChanged(QtProperty *property, int value);
+    void slotIntValuesChanged(const QList<QtProperty *> &properties)
+        { forwardValuesChanged(this, m_intPropertyManager, &QtFontPropertyManagerPrivate::slotIntChanged, properties); }
     void slotEnumChanged(QtProperty *property, int value);
     void slotBoolChanged(QtProperty *property, bool value);
     void slotPropertyDestroyed(QtProperty *property);
-    void slotFontDatabaseChanged();
-    void slotFontDatabaseDelayedChange();
+    void slotFontFamiliesLoaded();
+
+    void setFamily(QtProperty *familyProp, const QFont &font);
 
-    QStringList m_familyNames;
+    enum { FamilyProperty, PointSizeProperty, BoldProperty, ItalicProperty,
+            UnderlineProperty, StrikeOutProperty, KerningProperty };
 
     typedef QMap<const QtProperty *, QFont> PropertyValueMap;
     PropertyValueMap m_values;
@@ -5550,29 +6496,13 @@ public:
     QtEnumPropertyManager *m_enumPropertyManager;
     QtBoolPropertyManager *m_boolPropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToFamily;
-    QMap<const QtProperty *, QtProperty *> m_propertyToPointSize;
-    QMap<const QtProperty *, QtProperty *> m_propertyToBold;
-    QMap<const QtProperty *, QtProperty *> m_propertyToItalic;
-    QMap<const QtProperty *, QtProperty *> m_propertyToUnderline;
-    QMap<const QtProperty *, QtProperty *> m_propertyToStrikeOut;
-    QMap<const QtProperty *, QtProperty *> m_propertyToKerning;
-
-    QMap<const QtProperty *, QtProperty *> m_familyToProperty;
-    QMap<const QtProperty *, QtProperty *> m_pointSizeToProperty;
-    QMap<const QtProperty *, QtProperty *> m_boldToProperty;
-    QMap<const QtProperty *, QtProperty *> m_italicToProperty;
-    QMap<const QtProperty *, QtProperty *> m_underlineToProperty;
-    QMap<const QtProperty *, QtProperty *> m_strikeOutToProperty;
-    QMap<const QtProperty *, QtProperty *> m_kerningToProperty;
+    QtSubPropertyMap m_subProperties;
 
     bool m_settingValue;
-    QTimer *m_fontDatabaseChangeTimer;
 };
 
 QtFontPropertyManagerPrivate::QtFontPropertyManagerPrivate() :
-    m_settingValue(false),
-    m_fontDatabaseChangeTimer(0)
+    m_settingValue(false)
 {
 }
 
@@ -5580,7 +6510,9 @@ void QtFontPropertyManagerPrivate::slotIntChanged(QtProperty *property, int valu
 {
     if (m_settingValue)
         return;
-    if (QtProperty *prop = m_pointSizeToProperty.value(property, 0)) {
+    int index;
+    QtProperty *prop = m_subProperties.parentProperty(property, &index);
+    if (prop && index == PointSizeProperty) {
         QFont f = m_values[prop];
         f.setPointSize(value);
         q_ptr->setValue(prop, f);
@@ -5591,9 +6523,11 @@ void QtFontPropertyManagerPrivate::slotEnumChanged(QtProperty *property, int val
 {
     if (m_settingValue)
         return;
-    if (QtProperty *prop = m_familyToProperty.value(property, 0)) {
+    int index;
+    QtProperty *prop = m_subProperties.parentProperty(property, &index);
+    if (prop && index == FamilyProperty) {
         QFont f = m_values[prop];
-        f.setFamily(m_familyNames.at(value));
+        f.setFamily(m_enumPropertyManager->enumNames(property).value(value));
         q_ptr->setValue(prop, f);
     }
 }
@@ -5602,87 +6536,66 @@ void QtFontPropertyManagerPrivate::slotBoolChanged(QtProperty *property, bool va
 {
     if (m_settingValue)
         return;
-    if (QtProperty *prop = m_boldToProperty.value(property, 0)) {
-        QFont f = m_values[prop];
+    int index;
+    QtProperty *prop = m_subProperties.parentProperty(property, &index);
+    if (!prop)
+        return;
+
+    QFont f = m_values[prop];
+    switch (index) {
+    case BoldProperty:
         f.setBold(value);
-        q_ptr->setValue(prop, f);
-    } else if (QtProperty *prop = m_italicToProperty.value(property, 0)) {
-        QFont f = m_values[prop];
+        break;
+    case ItalicProperty:
         f.setItalic(value);
-        q_ptr->setValue(prop, f);
-    } else if (QtProperty *prop = m_underlineToProperty.value(property, 0)) {
-        QFont f = m_values[prop];
+        break;
+    case UnderlineProperty:
         f.setUnderline(value);
-        q_ptr->setValue(prop, f);
-    } else if (QtProperty *prop = m_strikeOutToProperty.value(property, 0)) {
-        QFont f = m_values[prop];
+        break;
+    case StrikeOutProperty:
         f.setStrikeOut(value);
-        q_ptr->setValue(prop, f);
-    } else if (QtProperty *prop = m_kerningToProperty.value(property, 0)) {
-        QFont f = m_values[prop];
+        break;
+    case KerningProperty:
         f.setKerning(value);
-        q_ptr->setValue(prop, f);
+        break;
+    default:
+        return;
     }
+    q_ptr->setValue(prop, f);
 }
 
 void QtFontPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
 {
-    if (QtProperty *pointProp = m_pointSizeToProperty.value(property, 0)) {
-        m_propertyToPointSize[pointProp] = 0;
-        m_pointSizeToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_familyToProperty.value(property, 0)) {
-        m_propertyToFamily[pointProp] = 0;
-        m_familyToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_boldToProperty.value(property, 0)) {
-        m_propertyToBold[pointProp] = 0;
-        m_boldToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_italicToProperty.value(property, 0)) {
-        m_propertyToItalic[pointProp] = 0;
-        m_italicToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_underlineToProperty.value(property, 0)) {
-        m_propertyToUnderline[pointProp] = 0;
-        m_underlineToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_strikeOutToProperty.value(property, 0)) {
-        m_propertyToStrikeOut[pointProp] = 0;
-        m_strikeOutToProperty.remove(property);
-    } else if (QtProperty *pointProp = m_kerningToProperty.value(property, 0)) {
-        m_propertyToKerning[pointProp] = 0;
-        m_kerningToProperty.remove(property);
-    }
+    m_subProperties.subPropertyDestroyed(property);
 }
 
-void  QtFontPropertyManagerPrivate::slotFontDatabaseChanged()
+// Points familyProp at the shared family list, or at just the font's
+// own family while the list is still loading.
+void QtFontPropertyManagerPrivate::setFamily(QtProperty *familyProp, const QFont &font)
 {
-    if (!m_fontDatabaseChangeTimer) {
-        m_fontDatabaseChangeTimer = new QTimer(q_ptr);
-        m_fontDatabaseChangeTimer->setInterval(0);
-        m_fontDatabaseChangeTimer->setSingleShot(true);
-        QObject::connect(m_fontDatabaseChangeTimer, SIGNAL(timeout()), q_ptr, SLOT(slotFontDatabaseDelayedChange()));
+    if (!familyProp)
+        return;
+
+    const bool settingValue = m_settingValue;
+    m_settingValue = true;
+    const QtEnumPropertyManagerPrivate::EnumTypePointer familyType = fontFamilyLoader()->familyType();
+    if (!familyType) {
+        m_enumPropertyManager->setEnumNames(familyProp, QStringList(font.family()));
+        m_enumPropertyManager->setValue(familyProp, 0);
+    } else {
+        m_enumPropertyManager->d_ptr->setType(familyProp, familyType);
+        const int idx = familyType->enumNames.indexOf(font.family());
+        m_enumPropertyManager->setValue(familyProp, idx == -1 ? 0 : idx);
     }
-    if (!m_fontDatabaseChangeTimer->isActive())
-        m_fontDatabaseChangeTimer->start();
+    m_settingValue = settingValue;
 }
 
-void QtFontPropertyManagerPrivate::slotFontDatabaseDelayedChange()
+void QtFontPropertyManagerPrivate::slotFontFamiliesLoaded()
 {
-    typedef QMap<const QtProperty *, QtProperty *> PropertyPropertyMap;
-    // rescan available font names
-    const QStringList oldFamilies = m_familyNames;
-    m_familyNames = fontDatabase()->families();
-
     // Adapt all existing properties
-    if (!m_propertyToFamily.empty()) {
-        PropertyPropertyMap::const_iterator cend = m_propertyToFamily.constEnd();
-        for (PropertyPropertyMap::const_iterator it = m_propertyToFamily.constBegin(); it != cend; ++it) {
-            QtProperty *familyProp = it.value();
-            const int oldIdx = m_enumPropertyManager->value(familyProp);
-            int newIdx = m_familyNames.indexOf(oldFamilies.at(oldIdx));
-            if (newIdx < 0)
-                newIdx = 0;
-            m_enumPropertyManager->setEnumNames(familyProp, m_familyNames);
-            m_enumPropertyManager->setValue(familyProp, newIdx);
-        }
-    }
+    const PropertyValueMap::ConstIterator vcend = m_values.constEnd();
+    for (PropertyValueMap::ConstIterator it = m_values.constBegin(); it != vcend; ++it)
+        setFamily(m_subProperties.subProperty(it.key(), FamilyProperty), it.value());
 }
 
 /*!
@@ -5700,7 +6613,14 @@ void QtFontPropertyManagerPrivate::slotFontDatabaseDelayedChange()
     corresponding subIntPropertyManager(), subEnumPropertyManager() and
     subBoolPropertyManager() functions. In order to provide editing widgets
     for the subproperties in a property browser widget, these managers
-    must be associated with editor factories.
+    must be associated with editor factories. The subproperties are
+    deferred until a property browser expands the font property.
+
+    The list of font families is read once per application, on a
+    worker thread started when control returns to the event loop after
+    the first font manager has been created. Until the list is loaded,
+    the \e family subproperty of a font property lists only that font's
+    own family.
 
     In addition, QtFontPropertyManager provides the valueChanged() signal
     which is emitted whenever a property created by this manager
@@ -5727,13 +6647,12 @@ QtFontPropertyManager::QtFontPropertyManager(QObject *parent)
 {
     d_ptr = new QtFontPropertyManagerPrivate;
     d_ptr->q_ptr = this;
-#if QT_VERSION >= 0x040500
-    QObject::connect(qApp, SIGNAL(fontDatabaseChanged()), this, SLOT(slotFontDatabaseChanged()));
-#endif
 
     d_ptr->m_intPropertyManager = new QtIntPropertyManager(this);
     connect(d_ptr->m_intPropertyManager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotIntChanged(QtProperty *, int)));
+    connect(d_ptr->m_intPropertyManager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotIntValuesChanged(QList<QtProperty *>)));
     d_ptr->m_enumPropertyManager = new QtEnumPropertyManager(this);
     connect(d_ptr->m_enumPropertyManager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotEnumChanged(QtProperty *, int)));
@@ -5747,6 +6666,13 @@ QtFontPropertyManager::QtFontPropertyManager(QObject *parent)
                 this, SLOT(slotPropertyDestroyed(QtProperty *)));
     connect(d_ptr->m_boolPropertyManager, SIGNAL(propertyDestroyed(QtProperty *)),
                 this, SLOT(slotPropertyDestroyed(QtProperty *)));
+
+    QtFontFamilyLoader *loader = fontFamilyLoader();
+    connect(loader, SIGNAL(familiesLoaded()), this, SLOT(slotFontFamiliesLoaded()));
+    if (loader->isLoaded())
+        d_ptr->slotFontFamiliesLoaded();
+    else
+        loader->load();
 }
 
 /*!
@@ -5859,18 +6785,16 @@ void QtFontPropertyManager::setValue(QtProperty *property, const QFont &val)
 
     it.value() = val;
 
-    int idx = d_ptr->m_familyNames.indexOf(val.family());
-    if (idx == -1)
-        idx = 0;
+    const QtSubPropertyMap &subProperties = d_ptr->m_subProperties;
+    d_ptr->setFamily(subProperties.subProperty(property, QtFontPropertyManagerPrivate::FamilyProperty), val);
     bool settingValue = d_ptr->m_settingValue;
     d_ptr->m_settingValue = true;
-    d_ptr->m_enumPropertyManager->setValue(d_ptr->m_propertyToFamily[property], idx);
-    d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToPointSize[property], val.pointSize());
-    d_ptr->m_boolPropertyManager->setValue(d_ptr->m_propertyToBold[property], val.bold());
-    d_ptr->m_boolPropertyManager->setValue(d_ptr->m_propertyToItalic[property], val.italic());
-    d_ptr->m_boolPropertyManager->setValue(d_ptr->m_propertyToUnderline[property], val.underline());
-    d_ptr->m_boolPropertyManager->setValue(d_ptr->m_propertyToStrikeOut[property], val.strikeOut());
-    d_ptr->m_boolPropertyManager->setValue(d_ptr->m_propertyToKerning[property], val.kerning());
+    d_ptr->m_intPropertyManager->setValue(subProperties.subProperty(property, QtFontPropertyManagerPrivate::PointSizeProperty), val.pointSize());
+    d_ptr->m_boolPropertyManager->setValue(subProperties.subProperty(property, QtFontPropertyManagerPrivate::BoldProperty), val.bold());
+    d_ptr->m_boolPropertyManager->setValue(subProperties.subProperty(property, QtFontPropertyManagerPrivate::ItalicProperty), val.italic());
+    d_ptr->m_boolPropertyManager->setValue(subProperties.subProperty(property, QtFontPropertyManagerPrivate::UnderlineProperty), val.underline());
+    d_ptr->m_boolPropertyManager->setValue(subProperties.subProperty(property, QtFontPropertyManagerPrivate::StrikeOutProperty), val.strikeOut());
+    d_ptr->m_boolPropertyManager->setValue(subProperties.subProperty(property, QtFontPropertyManagerPrivate::KerningProperty), val.kerning());
     d_ptr->m_settingValue = settingValue;
 
     emit propertyChanged(property);
@@ -5882,121 +6806,75 @@ void QtFontPropertyManager::setValue(QtProperty *property, const QFont &val)
 */
 void QtFontPropertyManager::initializeProperty(QtProperty *property)
 {
-    QFont val;
-    d_ptr->m_values[property] = val;
+    d_ptr->m_values[property] = QFont();
+}
+
+/*!
+    \reimp
+*/
+void QtFontPropertyManager::uninitializeProperty(QtProperty *property)
+{
+    d_ptr->m_subProperties.remove(property);
+
+    d_ptr->m_values.remove(property);
+}
+
+/*!
+    \reimp
+*/
+bool QtFontPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
+{
+    return d_ptr->m_values.contains(property) && !d_ptr->m_subProperties.contains(property);
+}
+
+/*!
+    \reimp
+
+    Creates the \e family, \e pointSize, \e bold, \e italic,
+    \e underline, \e strikeOut and \e kerning subproperties of the given
+    \a property.
+*/
+void QtFontPropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    if (!hasDeferredSubProperties(property))
+        return;
+
+    const QFont val = d_ptr->m_values.value(property);
 
     QtProperty *familyProp = d_ptr->m_enumPropertyManager->addProperty();
     familyProp->setPropertyName(tr("Family"));
-    if (d_ptr->m_familyNames.empty())
-        d_ptr->m_familyNames = fontDatabase()->families();
-    d_ptr->m_enumPropertyManager->setEnumNames(familyProp, d_ptr->m_familyNames);
-    int idx = d_ptr->m_familyNames.indexOf(val.family());
-    if (idx == -1)
-        idx = 0;
-    d_ptr->m_enumPropertyManager->setValue(familyProp, idx);
-    d_ptr->m_propertyToFamily[property] = familyProp;
-    d_ptr->m_familyToProperty[familyProp] = property;
-    property->addSubProperty(familyProp);
+    d_ptr->setFamily(familyProp, val);
 
     QtProperty *pointSizeProp = d_ptr->m_intPropertyManager->addProperty();
     pointSizeProp->setPropertyName(tr("Point Size"));
     d_ptr->m_intPropertyManager->setValue(pointSizeProp, val.pointSize());
     d_ptr->m_intPropertyManager->setMinimum(pointSizeProp, 1);
-    d_ptr->m_propertyToPointSize[property] = pointSizeProp;
-    d_ptr->m_pointSizeToProperty[pointSizeProp] = property;
-    property->addSubProperty(pointSizeProp);
 
     QtProperty *boldProp = d_ptr->m_boolPropertyManager->addProperty();
     boldProp->setPropertyName(tr("Bold"));
     d_ptr->m_boolPropertyManager->setValue(boldProp, val.bold());
-    d_ptr->m_propertyToBold[property] = boldProp;
-    d_ptr->m_boldToProperty[boldProp] = property;
-    property->addSubProperty(boldProp);
 
     QtProperty *italicProp = d_ptr->m_boolPropertyManager->addProperty();
     italicProp->setPropertyName(tr("Italic"));
     d_ptr->m_boolPropertyManager->setValue(italicProp, val.italic());
-    d_ptr->m_propertyToItalic[property] = italicProp;
-    d_ptr->m_italicToProperty[italicProp] = property;
-    property->addSubProperty(italicProp);
 
     QtProperty *underlineProp = d_ptr->m_boolPropertyManager->addProperty();
     underlineProp->setPropertyName(tr("Underline"));
     d_ptr->m_boolPropertyManager->setValue(underlineProp, val.underline());
-    d_ptr->m_propertyToUnderline[property] = underlineProp;
-    d_ptr->m_underlineToProperty[underlineProp] = property;
-    property->addSubProperty(underlineProp);
 
     QtProperty *strikeOutProp = d_ptr->m_boolPropertyManager->addProperty();
     strikeOutProp->setPropertyName(tr("Strikeout"));
     d_ptr->m_boolPropertyManager->setValue(strikeOutProp, val.strikeOut());
-    d_ptr->m_propertyToStrikeOut[property] = strikeOutProp;
-    d_ptr->m_strikeOutToProperty[strikeOutProp] = property;
-    property->addSubProperty(strikeOutProp);
 
     QtProperty *kerningProp = d_ptr->m_boolPropertyManager->addProperty();
     kerningProp->setPropertyName(tr("Kerning"));
     d_ptr->m_boolPropertyManager->setValue(kerningProp, val.kerning());
-    d_ptr->m_propertyToKerning[property] = kerningProp;
-    d_ptr->m_kerningToProperty[kerningProp] = property;
-    property->addSubProperty(kerningProp);
-}
-
-/*!
-    \reimp
-*/
-void QtFontPropertyManager::uninitializeProperty(QtProperty *property)
-{
-    QtProperty *familyProp = d_ptr->m_propertyToFamily[property];
-    if (familyProp) {
-        d_ptr->m_familyToProperty.remove(familyProp);
-        delete familyProp;
-    }
-    d_ptr->m_propertyToFamily.remove(property);
-
-    QtProperty *pointSizeProp = d_ptr->m_propertyToPointSize[property];
-    if (pointSizeProp) {
-        d_ptr->m_pointSizeToProperty.remove(pointSizeProp);
-        delete pointSizeProp;
-    }
-    d_ptr->m_propertyToPointSize.remove(property);
-
-    QtProperty *boldProp = d_ptr->m_propertyToBold[property];
-    if (boldProp) {
-        d_ptr->m_boldToProperty.remove(boldProp);
-        delete boldProp;
-    }
-    d_ptr->m_propertyToBold.remove(property);
-
-    QtProperty *italicProp = d_ptr->m_propertyToItalic[property];
-    if (italicProp) {
-        d_ptr->m_italicToProperty.remove(italicProp);
-        delete italicProp;
-    }
-    d_ptr->m_propertyToItalic.remove(property);
-
-    QtProperty *underlineProp = d_ptr->m_propertyToUnderline[property];
-    if (underlineProp) {
-        d_ptr->m_underlineToProperty.remove(underlineProp);
-        delete underlineProp;
-    }
-    d_ptr->m_propertyToUnderline.remove(property);
-
-    QtProperty *strikeOutProp = d_ptr->m_propertyToStrikeOut[property];
-    if (strikeOutProp) {
-        d_ptr->m_strikeOutToProperty.remove(strikeOutProp);
-        delete strikeOutProp;
-    }
-    d_ptr->m_propertyToStrikeOut.remove(property);
-
-    QtProperty *kerningProp = d_ptr->m_propertyToKerning[property];
-    if (kerningProp) {
-        d_ptr->m_kerningToProperty.remove(kerningProp);
-        delete kerningProp;
-    }
-    d_ptr->m_propertyToKerning.remove(property);
 
-    d_ptr->m_values.remove(property);
+    const QVector<QtProperty *> subProperties = QVector<QtProperty *>() << familyProp << pointSizeProp
+                << boldProp << italicProp << underlineProp << strikeOutProp << kerningProp;
+    d_ptr->m_subProperties.insert(property, subProperties);
+    for (int i = 0; i < subProperties.count(); i++)
+        property->addSubProperty(subProperties.at(i));
 }
 
 // QtColorPropertyManager
@@ -6008,6 +6886,8 @@ class QtColorPropertyManagerPrivate
 public:
 
     void slotIntChanged(QtProperty *property, int value);
+    void slotIntValuesChanged(const QList<QtProperty *> &properties)
+        { forwardValuesChanged(this, m_intPropertyManager, &QtColorPropertyManagerPrivate::slotIntChanged, properties); }
     void slotPropertyDestroyed(QtProperty *property);
 
     typedef QMap<const QtProperty *, QColor> PropertyValueMap;
@@ -6108,6 +6988,8 @@ QtColorPropertyManager::QtColorPropertyManager(QObject *parent)
     d_ptr->m_intPropertyManager = new QtIntPropertyManager(this);
     connect(d_ptr->m_intPropertyManager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotIntChanged(QtProperty *, int)));
+    connect(d_ptr->m_intPropertyManager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotIntValuesChanged(QList<QtProperty *>)));
 
     connect(d_ptr->m_intPropertyManager, SIGNAL(propertyDestroyed(QtProperty *)),
                 this, SLOT(slotPropertyDestroyed(QtProperty *)));
@@ -42,15 +42,18 @@
 #define QTPROPERTYMANAGER_H
 
 #include "qtpropertybrowser.h"
+#include <QtCore/QVector>
 
 #if QT_VERSION >= 0x040400
 QT_BEGIN_NAMESPACE
 #endif
 
+class QAbstractItemModel;
 class QDate;
 class QTime;
 class QDateTime;
 class QLocale;
+class QRegularExpression;
 
 class QT_QTPROPERTYBROWSER_EXPORT QtGroupPropertyManager : public QtAbstractPropertyManager
 {
@@ -82,12 +85,14 @@ public:
 
 public Q_SLOTS:
     void setValue(QtProperty *property, int val);
+    void setValues(const QList<QtProperty *> &properties, const QVector<int> &values);
     void setMinimum(QtProperty *property, int minVal);
     void setMaximum(QtProperty *property, int maxVal);
     void setRange(QtProperty *property, int minVal, int maxVal);
     void setSingleStep(QtProperty *property, int step);
 Q_SIGNALS:
     void valueChanged(QtProperty *property, int val);
+    void valuesChanged(const QList<QtProperty *> &properties);
     void rangeChanged(QtProperty *property, int minVal, int maxVal);
     void singleStepChanged(QtProperty *property, int step);
 protected:
@@ -143,6 +148,7 @@ public:
 
 public Q_SLOTS:
     void setValue(QtProperty *property, double val);
+    void setValues(const QList<QtProperty *> &properties, const QVector<double> &values);
     void setMinimum(QtProperty *property, double minVal);
     void setMaximum(QtProperty *property, double maxVal);
     void setRange(QtProperty *property, double minVal, double maxVal);
@@ -150,6 +156,7 @@ public Q_SLOTS:
     void setDecimals(QtProperty *property, int prec);
 Q_SIGNALS:
     void valueChanged(QtProperty *property, double val);
+    void valuesChanged(const QList<QtProperty *> &properties);
     void rangeChanged(QtProperty *property, double minVal, double maxVal);
     void singleStepChanged(QtProperty *property, double step);
     void decimalsChanged(QtProperty *property, int prec);
@@ -174,13 +181,16 @@ public:
 
     QString value(const QtProperty *property) const;
     QRegExp regExp(const QtProperty *property) const;
+    QRegularExpression regularExpression(const QtProperty *property) const;
 
 public Q_SLOTS:
     void setValue(QtProperty *property, const QString &val);
     void setRegExp(QtProperty *property, const QRegExp &regExp);
+    void setRegularExpression(QtProperty *property, const QRegularExpression &regularExpression);
 Q_SIGNALS:
     void valueChanged(QtProperty *property, const QString &val);
     void regExpChanged(QtProperty *property, const QRegExp &regExp);
+    void regularExpressionChanged(QtProperty *property, const QRegularExpression &regularExpression);
 protected:
     QString valueText(const QtProperty *property) const;
     virtual void initializeProperty(QtProperty *property);
@@ -371,6 +381,8 @@ Q_SIGNALS:
     void valueChanged(QtProperty *property, const QPoint &val);
 protected:
     QString valueText(const QtProperty *property) const;
+    bool hasDeferredSubProperties(const QtProperty *property) const;
+    void createDeferredSubProperties(QtProperty *property);
     virtual void initializeProperty(QtProperty *property);
     virtual void uninitializeProperty(QtProperty *property);
 private:
@@ -378,6 +390,7 @@ private:
     Q_DECLARE_PRIVATE(QtPointPropertyManager)
     Q_DISABLE_COPY(QtPointPropertyManager)
     Q_PRIVATE_SLOT(d_func(), void slotIntChanged(QtProperty *, int))
+    Q_PRIVATE_SLOT(d_func(), void slotIntValuesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
 };
 
@@ -403,6 +416,8 @@ Q_SIGNALS:
     void decimalsChanged(QtProperty *property, int prec);
 protected:
     QString valueText(const QtProperty *property) const;
+    bool hasDeferredSubProperties(const QtProperty *property) const;
+    void createDeferredSubProperties(QtProperty *property);
     virtual void initializeProperty(QtProperty *property);
     virtual void uninitializeProperty(QtProperty *property);
 private:
@@ -410,6 +425,7 @@ private:
     Q_DECLARE_PRIVATE(QtPointFPropertyManager)
     Q_DISABLE_COPY(QtPointFPropertyManager)
     Q_PRIVATE_SLOT(d_func(), void slotDoubleChanged(QtProperty *, double))
+    Q_PRIVATE_SLOT(d_func(), void slotDoubleValuesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
 };
 
@@ -438,6 +454,8 @@ Q_SIGNALS:
     void rangeChanged(QtProperty *property, const QSize &minVal, const QSize &maxVal);
 protected:
     QString valueText(const QtProperty *property) const;
+    bool hasDeferredSubProperties(const QtProperty *property) const;
+    void createDeferredSubProperties(QtProperty *property);
     virtual void initializeProperty(QtProperty *property);
     virtual void uninitializeProperty(QtProperty *property);
 private:
@@ -445,6 +463,7 @@ private:
     Q_DECLARE_PRIVATE(QtSizePropertyManager)
     Q_DISABLE_COPY(QtSizePropertyManager)
     Q_PRIVATE_SLOT(d_func(), void slotIntChanged(QtProperty *, int))
+    Q_PRIVATE_SLOT(d_func(), void slotIntValuesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
 };
 
@@ -476,6 +495,8 @@ Q_SIGNALS:
     void decimalsChanged(QtProperty *property, int prec);
 protected:
     QString valueText(const QtProperty *property) const;
+    bool hasDeferredSubProperties(const QtProperty *property) const;
+    void createDeferredSubProperties(QtProperty *property);
     virtual void initializeProperty(QtProperty *property);
     virtual void uninitializeProperty(QtProperty *property);
 private:
@@ -483,6 +504,7 @@ private:
     Q_DECLARE_PRIVATE(QtSizeFPropertyManager)
     Q_DISABLE_COPY(QtSizeFPropertyManager)
     Q_PRIVATE_SLOT(d_func(), void slotDoubleChanged(QtProperty *, double))
+    Q_PRIVATE_SLOT(d_func(), void slotDoubleValuesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
 };
 
@@ -508,6 +530,8 @@ Q_SIGNALS:
     void constraintChanged(QtProperty *property, const QRect &constraint);
 protected:
     QString valueText(const QtProperty *property) const;
+    bool hasDeferredSubProperties(const QtProperty *property) const;
+    void createDeferredSubProperties(QtProperty *property);
     virtual void initializeProperty(QtProperty *property);
     virtual void uninitializeProperty(QtProperty *property);
 private:
@@ -515,6 +539,7 @@ private:
     Q_DECLARE_PRIVATE(QtRectPropertyManager)
     Q_DISABLE_COPY(QtRectPropertyManager)
     Q_PRIVATE_SLOT(d_func(), void slotIntChanged(QtProperty *, int))
+    Q_PRIVATE_SLOT(d_func(), void slotIntValuesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
 };
 
@@ -543,6 +568,8 @@ Q_SIGNALS:
     void decimalsChanged(QtProperty *property, int prec);
 protected:
     QString valueText(const QtProperty *property) const;
+    bool hasDeferredSubProperties(const QtProperty *property) const;
+    void createDeferredSubProperties(QtProperty *property);
     virtual void initializeProperty(QtProperty *property);
     virtual void uninitializeProperty(QtProperty *property);
 private:
@@ -550,6 +577,7 @@ private:
     Q_DECLARE_PRIVATE(QtRectFPropertyManager)
     Q_DISABLE_COPY(QtRectFPropertyManager)
     Q_PRIVATE_SLOT(d_func(), void slotDoubleChanged(QtProperty *, double))
+    Q_PRIVATE_SLOT(d_func(), void slotDoubleValuesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
 };
 
@@ -565,11 +593,17 @@ public:
     int value(const QtProperty *property) const;
     QStringList enumNames(const QtProperty *property) const;
     QMap<int, QIcon> enumIcons(const QtProperty *property) const;
+    QAbstractItemModel *enumModel(const QtProperty *property) const;
+
+    int registerEnumType(const QStringList &names, const QMap<int, QIcon> &icons = QMap<int, QIcon>());
+    void unregisterEnumType(int type);
+    int enumType(const QtProperty *property) const;
 
 public Q_SLOTS:
     void setValue(QtProperty *property, int val);
     void setEnumNames(QtProperty *property, const QStringList &names);
     void setEnumIcons(QtProperty *property, const QMap<int, QIcon> &icons);
+    void setEnumType(QtProperty *property, int type);
 Q_SIGNALS:
     void valueChanged(QtProperty *property, int val);
     void enumNamesChanged(QtProperty *property, const QStringList &names);
@@ -583,6 +617,7 @@ private:
     QtEnumPropertyManagerPrivate *d_ptr;
     Q_DECLARE_PRIVATE(QtEnumPropertyManager)
     Q_DISABLE_COPY(QtEnumPropertyManager)
+    friend class QtFontPropertyManagerPrivate;
 };
 
 class QtFlagPropertyManagerPrivate;
@@ -607,6 +642,8 @@ Q_SIGNALS:
     void flagNamesChanged(QtProperty *property, const QStringList &names);
 protected:
     QString valueText(const QtProperty *property) const;
+    bool hasDeferredSubProperties(const QtProperty *property) const;
+    void createDeferredSubProperties(QtProperty *property);
     virtual void initializeProperty(QtProperty *property);
     virtual void uninitializeProperty(QtProperty *property);
 private:
@@ -644,6 +681,7 @@ private:
     Q_DECLARE_PRIVATE(QtSizePolicyPropertyManager)
     Q_DISABLE_COPY(QtSizePolicyPropertyManager)
     Q_PRIVATE_SLOT(d_func(), void slotIntChanged(QtProperty *, int))
+    Q_PRIVATE_SLOT(d_func(), void slotIntValuesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotEnumChanged(QtProperty *, int))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
 };
@@ -670,6 +708,8 @@ Q_SIGNALS:
 protected:
     QString valueText(const QtProperty *property) const;
     QIcon valueIcon(const QtProperty *property) const;
+    bool hasDeferredSubProperties(const QtProperty *property) const;
+    void createDeferredSubProperties(QtProperty *property);
     virtual void initializeProperty(QtProperty *property);
     virtual void uninitializeProperty(QtProperty *property);
 private:
@@ -677,11 +717,11 @@ private:
     Q_DECLARE_PRIVATE(QtFontPropertyManager)
     Q_DISABLE_COPY(QtFontPropertyManager)
     Q_PRIVATE_SLOT(d_func(), void slotIntChanged(QtProperty *, int))
+    Q_PRIVATE_SLOT(d_func(), void slotIntValuesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotEnumChanged(QtProperty *, int))
     Q_PRIVATE_SLOT(d_func(), void slotBoolChanged(QtProperty *, bool))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
-    Q_PRIVATE_SLOT(d_func(), void slotFontDatabaseChanged())
-    Q_PRIVATE_SLOT(d_func(), void slotFontDatabaseDelayedChange())
+    Q_PRIVATE_SLOT(d_func(), void slotFontFamiliesLoaded())
 };
 
 class QtColorPropertyManagerPrivate;
@@ -711,6 +751,7 @@ private:
     Q_DECLARE_PRIVATE(QtColorPropertyManager)
     Q_DISABLE_COPY(QtColorPropertyManager)
     Q_PRIVATE_SLOT(d_func(), void slotIntChanged(QtProperty *, int))
+    Q_PRIVATE_SLOT(d_func(), void slotIntValuesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
 };
 
@@ -39,6 +39,7 @@
 
 
 #include "qttreepropertybrowser.h"
+#include "qtpropertybrowserutils_p.h"
 #include <QtCore/QSet>
 #include <QIcon>
 #include <QTreeWidget>
@@ -69,8 +70,11 @@ public:
     void propertyInserted(QtBrowserItem *index, QtBrowserItem *afterIndex);
     void propertyRemoved(QtBrowserItem *index);
     void propertyChanged(QtBrowserItem *index);
+    void propertiesChanged(const QList<QtBrowserItem *> &indexes);
     QWidget *createEditor(QtProperty *property, QWidget *parent) const
         { return q_ptr->createEditor(property, parent); }
+    void releaseEditor(QWidget *editor) const
+        { q_ptr->releaseEditor(editor); }
     QtProperty *indexToProperty(const QModelIndex &index) const;
     QTreeWidgetItem *indexToItem(const QModelIndex &index) const;
     QtBrowserItem *indexToBrowserItem(const QModelIndex &index) const;
@@ -96,6 +100,8 @@ public:
 
     QTreeWidgetItem *editedItem() const;
 
+    void applyExpandState();
+
 private:
     void updateItem(QTreeWidgetItem *item);
 
@@ -112,6 +118,9 @@ private:
     bool m_markPropertiesWithoutValue;
     bool m_browserChangedBlocked;
     QIcon m_expandIcon;
+
+    QtExpandStateStore m_expandState;
+    bool m_restoringExpandState;
 };
 
 // ------------ QtPropertyEditorView
@@ -228,6 +237,7 @@ public:
 
     QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
             const QModelIndex &index) const;
+    void destroyEditor(QWidget *editor, const QModelIndex &index) const;
 
     void updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option,
             const QModelIndex &index) const;
@@ -304,8 +314,30 @@ void QtPropertyEditorDelegate::slotEditorDestroyed(QObject *object)
 
 void QtPropertyEditorDelegate::closeEditor(QtProperty *property)
 {
+    // Let the view close the editor, so that it is released through
+    // destroyEditor() and the view forgets it.
     if (QWidget *w = m_propertyToEditor.value(property, 0))
-        w->deleteLater();
+        emit QAbstractItemDelegate::closeEditor(w, QAbstractItemDelegate::NoHint);
+}
+
+// Gives the editor back to the browser, whose factory may keep it for
+// the next property that is edited, instead of deleting it.
+void QtPropertyEditorDelegate::destroyEditor(QWidget *editor, const QModelIndex &index) const
+{
+    const EditorToPropertyMap::iterator it = m_editorToProperty.find(editor);
+    if (it == m_editorToProperty.end() || !m_editorPrivate) {
+        QItemDelegate::destroyEditor(editor, index);
+        return;
+    }
+    m_propertyToEditor.remove(it.value());
+    m_editorToProperty.erase(it);
+    if (m_editedWidget == editor) {
+        m_editedWidget = 0;
+        m_editedItem = 0;
+    }
+    disconnect(editor, SIGNAL(destroyed(QObject *)), this, SLOT(slotEditorDestroyed(QObject *)));
+    editor->removeEventFilter(const_cast<QtPropertyEditorDelegate *>(this));
+    m_editorPrivate->releaseEditor(editor);
 }
 
 QWidget *QtPropertyEditorDelegate::createEditor(QWidget *parent,
@@ -427,7 +459,8 @@ QtTreePropertyBrowserPrivate::QtTreePropertyBrowserPrivate() :
     m_resizeMode(QtTreePropertyBrowser::Stretch),
     m_delegate(0),
     m_markPropertiesWithoutValue(false),
-    m_browserChangedBlocked(false)
+    m_browserChangedBlocked(false),
+    m_restoringExpandState(false)
 {
 }
 
@@ -586,9 +619,21 @@ void QtTreePropertyBrowserPrivate::propertyInserted(QtBrowserItem *index, QtBrow
     m_indexToItem[index] = newItem;
 
     newItem->setFlags(newItem->flags() | Qt::ItemIsEditable);
-    m_treeWidget->setItemExpanded(newItem, true);
-
     updateItem(newItem);
+
+    // Items with deferred subproperties start collapsed; their
+    // subproperties are created when the user expands them, or here if
+    // the saved expand state has the item expanded.
+    const bool deferred = q_ptr->hasDeferredSubProperties(index->property());
+    const bool expanded = m_expandState.isExpanded(index, !deferred);
+    if (deferred) {
+        if (!expanded)
+            return;
+        q_ptr->createDeferredSubProperties(index->property());
+    }
+    m_restoringExpandState = true;
+    m_treeWidget->setItemExpanded(newItem, expanded);
+    m_restoringExpandState = false;
 }
 
 void QtTreePropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
@@ -604,13 +649,27 @@ void QtTreePropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
     m_indexToItem.remove(index);
     m_itemToIndex.remove(item);
     m_indexToBackgroundColor.remove(index);
+    m_expandState.itemRemoved(index);
 }
 
 void QtTreePropertyBrowserPrivate::propertyChanged(QtBrowserItem *index)
 {
     QTreeWidgetItem *item = m_indexToItem.value(index);
+    m_expandState.itemChanged(index);
 
     updateItem(item);
+    m_treeWidget->viewport()->update();
+}
+
+void QtTreePropertyBrowserPrivate::propertiesChanged(const QList<QtBrowserItem *> &indexes)
+{
+    QListIterator<QtBrowserItem *> itIndex(indexes);
+    while (itIndex.hasNext()) {
+        QtBrowserItem *index = itIndex.next();
+        m_expandState.itemChanged(index);
+        updateItem(m_indexToItem.value(index));
+    }
+    m_treeWidget->viewport()->update();
 }
 
 void QtTreePropertyBrowserPrivate::updateItem(QTreeWidgetItem *item)
@@ -628,6 +687,8 @@ void QtTreePropertyBrowserPrivate::updateItem(QTreeWidgetItem *item)
         expandIcon = m_expandIcon;
     }
     item->setIcon(0, expandIcon);
+    item->setChildIndicatorPolicy(q_ptr->hasDeferredSubProperties(property)
+                ? QTreeWidgetItem::ShowIndicator : QTreeWidgetItem::DontShowIndicatorWhenChildless);
     item->setFirstColumnSpanned(!property->hasValue());
     item->setToolTip(0, property->propertyName());
     item->setStatusTip(0, property->statusTip());
@@ -650,7 +711,6 @@ void QtTreePropertyBrowserPrivate::updateItem(QTreeWidgetItem *item)
         else
             disableItem(item);
     }
-    m_treeWidget->viewport()->update();
 }
 
 QColor QtTreePropertyBrowserPrivate::calculatedBackgroundColor(QtBrowserItem *item) const
@@ -670,6 +730,8 @@ void QtTreePropertyBrowserPrivate::slotCollapsed(const QModelIndex &index)
 {
     QTreeWidgetItem *item = indexToItem(index);
     QtBrowserItem *idx = m_itemToIndex.value(item);
+    if (idx && !m_restoringExpandState)
+        m_expandState.setExpanded(idx, false);
     if (item)
         emit q_ptr->collapsed(idx);
 }
@@ -678,6 +740,10 @@ void QtTreePropertyBrowserPrivate::slotExpanded(const QModelIndex &index)
 {
     QTreeWidgetItem *item = indexToItem(index);
     QtBrowserItem *idx = m_itemToIndex.value(item);
+    if (idx && !m_restoringExpandState)
+        m_expandState.setExpanded(idx, true);
+    if (idx && !m_restoringExpandState && q_ptr->hasDeferredSubProperties(idx->property()))
+        q_ptr->createDeferredSubProperties(idx->property());
     if (item)
         emit q_ptr->expanded(idx);
 }
@@ -701,6 +767,15 @@ QTreeWidgetItem *QtTreePropertyBrowserPrivate::editedItem() const
     return m_delegate->editedItem();
 }
 
+void QtTreePropertyBrowserPrivate::applyExpandState()
+{
+    QMapIterator<QtBrowserItem *, QTreeWidgetItem *> it(m_indexToItem);
+    while (it.hasNext()) {
+        it.next();
+        it.value()->setExpanded(m_expandState.isExpanded(it.key(), it.value()->isExpanded()));
+    }
+}
+
 void QtTreePropertyBrowserPrivate::editItem(QtBrowserItem *browserItem)
 {
     if (QTreeWidgetItem *treeItem = m_indexToItem.value(browserItem, 0)) {
@@ -762,6 +837,7 @@ QtTreePropertyBrowser::QtTreePropertyBrowser(QWidget *parent)
     d_ptr->q_ptr = this;
 
     d_ptr->init(this);
+    setDeferSubProperties(true);
     connect(this, SIGNAL(currentItemChanged(QtBrowserItem*)), this, SLOT(slotCurrentBrowserItemChanged(QtBrowserItem*)));
 }
 
@@ -812,6 +888,7 @@ void QtTreePropertyBrowser::setRootIsDecorated(bool show)
         if (!property->hasValue())
             d_ptr->updateItem(it.key());
     }
+    d_ptr->m_treeWidget->viewport()->update();
 }
 
 /*!
@@ -938,6 +1015,62 @@ bool QtTreePropertyBrowser::isExpanded(QtBrowserItem *item) const
     return false;
 }
 
+/*!
+    Returns the path under which the expanded state of \a item is stored.
+
+    The path is made of the property ids of the item and all its
+    ancestors, separated by '/'. Properties without an id contribute
+    their name instead.
+
+    \sa expandState()
+*/
+
+QString QtTreePropertyBrowser::itemPath(QtBrowserItem *item) const
+{
+    return d_ptr->m_expandState.itemPath(item);
+}
+
+/*!
+    Returns the expanded state of all items the browser has seen
+    expanded or collapsed, keyed by item path.
+
+    The state outlives the items themselves: when a property is
+    removed and inserted again, its item is restored to the state
+    stored for its path. Items without a stored state are expanded.
+
+    \sa setExpandState(), clearExpandState(), itemPath()
+*/
+
+QHash<QString, bool> QtTreePropertyBrowser::expandState() const
+{
+    return d_ptr->m_expandState.state();
+}
+
+/*!
+    Replaces the stored expanded state with \a state and applies it to
+    the items currently shown in the browser.
+
+    \sa expandState()
+*/
+
+void QtTreePropertyBrowser::setExpandState(const QHash<QString, bool> &state)
+{
+    d_ptr->m_expandState.setState(state);
+    d_ptr->applyExpandState();
+}
+
+/*!
+    Forgets the stored expanded state. Items currently shown in the
+    browser are not changed.
+
+    \sa expandState()
+*/
+
+void QtTreePropertyBrowser::clearExpandState()
+{
+    d_ptr->m_expandState.clear();
+}
+
 /*!
     Returns true if the \a item is visible; otherwise returns false.
 
@@ -1060,6 +1193,14 @@ void QtTreePropertyBrowser::itemChanged(QtBrowserItem *item)
     d_ptr->propertyChanged(item);
 }
 
+/*!
+    \reimp
+*/
+void QtTreePropertyBrowser::itemsChanged(const QList<QtBrowserItem *> &items)
+{
+    d_ptr->propertiesChanged(items);
+}
+
 /*!
     Sets the current item to \a item and opens the relevant editor for it.
 */
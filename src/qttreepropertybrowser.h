@@ -42,6 +42,7 @@
 #define QTTREEPROPERTYBROWSER_H
 
 #include "qtpropertybrowser.h"
+#include <QtCore/QHash>
 
 #if QT_VERSION >= 0x040400
 QT_BEGIN_NAMESPACE
@@ -95,6 +96,11 @@ public:
     void setExpanded(QtBrowserItem *item, bool expanded);
     bool isExpanded(QtBrowserItem *item) const;
 
+    QString itemPath(QtBrowserItem *item) const;
+    QHash<QString, bool> expandState() const;
+    void setExpandState(const QHash<QString, bool> &state);
+    void clearExpandState();
+
     bool isItemVisible(QtBrowserItem *item) const;
     void setItemVisible(QtBrowserItem *item, bool visible);
 
@@ -116,6 +122,7 @@ protected:
     virtual void itemInserted(QtBrowserItem *item, QtBrowserItem *afterItem);
     virtual void itemRemoved(QtBrowserItem *item);
     virtual void itemChanged(QtBrowserItem *item);
+    virtual void itemsChanged(const QList<QtBrowserItem *> &items);
 
 private:
 
@@ -41,10 +41,16 @@
 #include "qtvariantproperty.h"
 #include "qtpropertymanager.h"
 #include "qteditorfactory.h"
+#include "qtpropertybrowserutils_p.h"
 #include <QtCore/QVariant>
+#include <QtCore/QHash>
+#include <QtCore/QVector>
 #include <QtGui/QIcon>
 #include <QtCore/QDate>
 #include <QtCore/QLocale>
+#include <QtCore/QMetaObject>
+#include <QtCore/QRegExp>
+#include <QtCore/QRegularExpression>
 
 #if defined(Q_CC_MSVC)
 #    pragma warning(disable: 4786) /* MS VS 6: truncating debug info after 255 characters */
@@ -135,21 +141,32 @@ int QtVariantPropertyManager::iconMapTypeId()
     return qMetaTypeId<QtIconMap>();
 }
 
-typedef QMap<const QtProperty *, QtProperty *> PropertyMap;
-Q_GLOBAL_STATIC(PropertyMap, propertyToWrappedProperty)
-
-static QtProperty *wrappedProperty(QtProperty *property)
-{
-    return propertyToWrappedProperty()->value(property, 0);
-}
+struct QtVariantPropertyAccessor;
 
 class QtVariantPropertyPrivate
 {
-    QtVariantProperty *q_ptr;
 public:
-    QtVariantPropertyPrivate(QtVariantPropertyManager *m) : manager(m) {}
+    QtVariantPropertyPrivate(QtVariantProperty *q, QtVariantPropertyManager *m)
+        : q_ptr(q), manager(m), propertyType(0), valueType(0), thin(false), wrappedProperty(0),
+          wrappedManager(0), accessor(0), attributeTypes(0) {}
 
+    QtVariantProperty *q_ptr;
     QtVariantPropertyManager *manager;
+    int propertyType;
+    int valueType;
+
+    // A thin property keeps its value here and has no wrapped property
+    // until one is needed.
+    bool thin;
+    QVariant thinValue;
+
+    // The property of the internal manager this property forwards to,
+    // together with the typed access to it. All of it is resolved once
+    // when the property is created.
+    QtProperty *wrappedProperty;
+    QtAbstractPropertyManager *wrappedManager;
+    const QtVariantPropertyAccessor *accessor;
+    const QHash<int, int> *attributeTypes;
 };
 
 /*!
@@ -200,7 +217,7 @@ public:
     \sa QtVariantPropertyManager
 */
 QtVariantProperty::QtVariantProperty(QtVariantPropertyManager *manager)
-    : QtProperty(manager),  d_ptr(new QtVariantPropertyPrivate(manager))
+    : QtProperty(manager),  d_ptr(new QtVariantPropertyPrivate(this, manager))
 {
 
 }
@@ -212,7 +229,8 @@ QtVariantProperty::QtVariantProperty(QtVariantPropertyManager *manager)
 */
 QtVariantProperty::~QtVariantProperty()
 {
-    delete d_ptr;
+    // d_ptr is released by QtVariantPropertyManager::uninitializeProperty(),
+    // which the QtProperty destructor calls after this one has run.
 }
 
 /*!
@@ -239,6 +257,17 @@ QVariant QtVariantProperty::attributeValue(const QString &attribute) const
     return d_ptr->manager->attributeValue(this, attribute);
 }
 
+/*!
+    \overload
+
+    Returns this property's value for the attribute with the given \a
+    attributeId, as returned by QtVariantPropertyManager::attributeId().
+*/
+QVariant QtVariantProperty::attributeValue(int attributeId) const
+{
+    return d_ptr->manager->attributeValue(this, attributeId);
+}
+
 /*!
     Returns the type of this property's value.
 
@@ -306,6 +335,210 @@ void QtVariantProperty::setAttribute(const QString &attribute, const QVariant &v
     d_ptr->manager->setAttribute(this, attribute, value);
 }
 
+/*!
+    \overload
+
+    Sets the attribute with the given \a attributeId, as returned by
+    QtVariantPropertyManager::attributeId(), of this property to \a value.
+*/
+void QtVariantProperty::setAttribute(int attributeId, const QVariant &value)
+{
+    d_ptr->manager->setAttribute(this, attributeId, value);
+}
+
+// Attribute names are interned to ids, so that attributes can be read
+// and written without comparing strings. The ids of the attributes of
+// the built-in property types are fixed.
+enum QtVariantAttribute
+{
+    NoAttribute,
+    ConstraintAttribute,
+    SingleStepAttribute,
+    DecimalsAttribute,
+    EnumIconsAttribute,
+    EnumNamesAttribute,
+    FlagNamesAttribute,
+    MaximumAttribute,
+    MinimumAttribute,
+    RegExpAttribute,
+    RegularExpressionAttribute,
+    BuiltinAttributeCount
+};
+
+class QtVariantAttributeRegistry
+{
+public:
+    QtVariantAttributeRegistry();
+
+    int find(const QString &attribute) const { return m_nameToId.value(attribute, NoAttribute); }
+    int insert(const QString &attribute);
+    QString name(int attributeId) const { return m_names.value(attributeId); }
+
+private:
+    QHash<QString, int> m_nameToId;
+    QStringList m_names;
+};
+
+QtVariantAttributeRegistry::QtVariantAttributeRegistry()
+{
+    static const char * const builtinAttributeNames[] = {
+        "constraint",
+        "singleStep",
+        "decimals",
+        "enumIcons",
+        "enumNames",
+        "flagNames",
+        "maximum",
+        "minimum",
+        "regExp",
+        "regularExpression"
+    };
+
+    m_names.append(QString());
+    for (int id = NoAttribute + 1; id < BuiltinAttributeCount; id++)
+        insert(QLatin1String(builtinAttributeNames[id - 1]));
+}
+
+int QtVariantAttributeRegistry::insert(const QString &attribute)
+{
+    const int id = find(attribute);
+    if (id != NoAttribute)
+        return id;
+    m_nameToId.insert(attribute, m_names.count());
+    m_names.append(attribute);
+    return m_names.count() - 1;
+}
+
+Q_GLOBAL_STATIC(QtVariantAttributeRegistry, variantAttributeRegistry)
+
+// Typed access to the internal manager of a property type. It is
+// resolved once per property when the property is created, so that
+// value(), setValue(), attributeValue() and setAttribute() are a single
+// indirect call instead of a chain of qobject_cast()s. read and write
+// pass the unboxed value, for QtVariantProperty::valueAs() and
+// QtVariantProperty::setValueAs().
+struct QtVariantPropertyAccessor
+{
+    typedef QtVariantPropertyManager::ValueFunction ValueFunction;
+    typedef QtVariantPropertyManager::SetValueFunction SetValueFunction;
+    typedef void (*ReadFunction)(QtAbstractPropertyManager *manager, const QtProperty *property,
+                void *value);
+    typedef void (*WriteFunction)(QtAbstractPropertyManager *manager, QtProperty *property,
+                const void *value);
+    typedef void (*SetValuesFunction)(QtAbstractPropertyManager *manager,
+                const QList<QtProperty *> &properties, const QList<QVariant> &values);
+    typedef QtVariantPropertyManager::AttributeValueFunction AttributeValueFunction;
+    typedef QtVariantPropertyManager::SetAttributeFunction SetAttributeFunction;
+
+    ValueFunction value;
+    SetValueFunction setValue;
+    ReadFunction read;
+    WriteFunction write;
+    SetValuesFunction setValues;
+    AttributeValueFunction attributeValue;
+    SetAttributeFunction setAttribute;
+};
+
+template <class PropertyManager>
+static QVariant managerValue(QtAbstractPropertyManager *manager, const QtProperty *property)
+{
+    return static_cast<const PropertyManager *>(manager)->value(property);
+}
+
+template <class PropertyManager, class Value>
+static void setManagerValue(QtAbstractPropertyManager *manager, QtProperty *property, const QVariant &value)
+{
+    static_cast<PropertyManager *>(manager)->setValue(property, value.value<Value>());
+}
+
+template <class PropertyManager, class Value>
+static void readManagerValue(QtAbstractPropertyManager *manager, const QtProperty *property, void *value)
+{
+    *static_cast<Value *>(value) = static_cast<const PropertyManager *>(manager)->value(property);
+}
+
+template <class PropertyManager, class Value>
+static void writeManagerValue(QtAbstractPropertyManager *manager, QtProperty *property, const void *value)
+{
+    static_cast<PropertyManager *>(manager)->setValue(property, *static_cast<const Value *>(value));
+}
+
+// For managers with a batch setValues()
+template <class PropertyManager, class Value>
+static void setManagerValues(QtAbstractPropertyManager *manager,
+            const QList<QtProperty *> &properties, const QList<QVariant> &values)
+{
+    QVector<Value> managerValues(values.count());
+    for (int i = 0; i < values.count(); ++i)
+        managerValues[i] = values.at(i).value<Value>();
+    static_cast<PropertyManager *>(manager)->setValues(properties, managerValues);
+}
+
+template <class PropertyManager, class Value>
+static QtVariantPropertyAccessor variantPropertyAccessor(
+            QtVariantPropertyAccessor::AttributeValueFunction attributeValue = 0,
+            QtVariantPropertyAccessor::SetAttributeFunction setAttribute = 0)
+{
+    QtVariantPropertyAccessor accessor;
+    accessor.value = managerValue<PropertyManager>;
+    accessor.setValue = setManagerValue<PropertyManager, Value>;
+    accessor.read = readManagerValue<PropertyManager, Value>;
+    accessor.write = writeManagerValue<PropertyManager, Value>;
+    accessor.setValues = 0;
+    accessor.attributeValue = attributeValue;
+    accessor.setAttribute = setAttribute;
+    return accessor;
+}
+
+/*!
+    \fn T QtVariantProperty::valueAs() const
+
+    Returns this property's value as a \c T.
+
+    If \c T is the property's valueType(), the value is read from the
+    internal manager without going through a QVariant. Otherwise the
+    value returned by value() is converted using qvariant_cast().
+
+    \sa value(), setValueAs()
+*/
+
+/*!
+    \fn void QtVariantProperty::setValueAs(const T &val)
+
+    Sets the value of this property to \a val.
+
+    If \c T is the property's valueType(), the value is passed to the
+    internal manager without going through a QVariant. Otherwise this
+    function behaves like setValue().
+
+    \sa setValue(), valueAs()
+*/
+
+bool QtVariantProperty::readValue(int typeId, void *val) const
+{
+    const QtVariantPropertyPrivate *d = d_ptr;
+    if (typeId != d->valueType)
+        return false;
+    if (d->thin) {
+        QMetaType::destruct(typeId, val);
+        QMetaType::construct(typeId, val, d->thinValue.constData());
+        return true;
+    }
+    if (!d->accessor || !d->accessor->read)
+        return false;
+    d->accessor->read(d->wrappedManager, d->wrappedProperty, val);
+    return true;
+}
+
+bool QtVariantProperty::writeValue(int typeId, const void *val)
+{
+    const QtVariantPropertyPrivate *d = d_ptr;
+    if (typeId != d->valueType || d->thin || !d->accessor || !d->accessor->write)
+        return false;
+    d->accessor->write(d->wrappedManager, d->wrappedProperty, val);
+    return true;
+}
+
 class QtVariantPropertyManagerPrivate
 {
     QtVariantPropertyManager *q_ptr;
@@ -322,12 +555,14 @@ public:
     void slotRangeChanged(QtProperty *property, int min, int max);
     void slotSingleStepChanged(QtProperty *property, int step);
     void slotValueChanged(QtProperty *property, double val);
+    void slotValuesChanged(const QList<QtProperty *> &properties);
     void slotRangeChanged(QtProperty *property, double min, double max);
     void slotSingleStepChanged(QtProperty *property, double step);
     void slotDecimalsChanged(QtProperty *property, int prec);
     void slotValueChanged(QtProperty *property, bool val);
     void slotValueChanged(QtProperty *property, const QString &val);
     void slotRegExpChanged(QtProperty *property, const QRegExp &regExp);
+    void slotRegularExpressionChanged(QtProperty *property, const QRegularExpression &regularExpression);
     void slotValueChanged(QtProperty *property, const QDate &val);
     void slotRangeChanged(QtProperty *property, const QDate &min, const QDate &max);
     void slotValueChanged(QtProperty *property, const QTime &val);
@@ -354,25 +589,52 @@ public:
     void slotValueChanged(QtProperty *property, const QCursor &val);
     void slotFlagChanged(QtProperty *property, int val);
     void slotFlagNamesChanged(QtProperty *property, const QStringList &flagNames);
+    void slotTypedValueChanged(QtProperty *property);
     void slotPropertyInserted(QtProperty *property, QtProperty *parent, QtProperty *after);
     void slotPropertyRemoved(QtProperty *property, QtProperty *parent);
 
     void valueChanged(QtProperty *property, const QVariant &val);
+    void reportChangedProperties(const QList<QtProperty *> &changedProperties);
 
     int internalPropertyToType(QtProperty *property) const;
+    void setInternalProperty(QtVariantProperty *property, QtProperty *internal);
+    static QtProperty *wrappedProperty(const QtVariantProperty *property);
+    static int propertyType(const QtVariantProperty *property) { return property->d_ptr->propertyType; }
+    static bool isThin(const QtVariantProperty *property) { return property->d_ptr->thin; }
+    void materializeProperty(QtVariantPropertyPrivate *data);
+    QtVariantPropertyPrivate *materializedProperty(const QtProperty *property);
+    bool hasAttribute(int propertyType, int attributeId) const;
+    QVariant defaultAttributeValue(int propertyType, int attributeId);
+    QVariant boundThinValue(const QtVariantPropertyPrivate *data, const QVariant &val);
+    void setThinValue(QtVariantPropertyPrivate *data, const QVariant &val);
+    static QtPropertyEditorAdapter *editorAdapter(const QtVariantProperty *property);
     QtVariantProperty *createSubProperty(QtVariantProperty *parent, QtVariantProperty *after,
             QtProperty *internal);
     void removeSubProperty(QtVariantProperty *property);
 
     QMap<int, QtAbstractPropertyManager *> m_typeToPropertyManager;
+    QMap<int, QtVariantPropertyAccessor> m_typeToAccessor;
+    void addAttribute(int propertyType, int attributeId, int attributeType);
+
     QMap<int, QMap<QString, int> > m_typeToAttributeToAttributeType;
+    QMap<int, QHash<int, int> > m_typeToAttributeIdToAttributeType;
 
-    QMap<const QtProperty *, QPair<QtVariantProperty *, int> > m_propertyToType;
+    QHash<const QtProperty *, QtVariantPropertyPrivate *> m_propertyToData;
 
     QMap<int, int> m_typeToValueType;
 
 
-    QMap<QtProperty *, QtVariantProperty *> m_internalToProperty;
+    QHash<const QtProperty *, QtVariantProperty *> m_internalToProperty;
+
+    bool m_thinPropertiesEnabled;
+    // A property of each typed manager that keeps its initial attributes;
+    // it answers for the attributes of thin properties.
+    QMap<int, QtProperty *> m_typeToDefaultProperty;
+    // Lets editor factories edit thin properties; created with the first
+    // editor of a thin property.
+    QtPropertyEditorAdapter *m_editorAdapter;
+    // Collects the changed properties while setValues() runs
+    QList<QtProperty *> *m_changedProperties;
 
     const QString m_constraintAttribute;
     const QString m_singleStepAttribute;
@@ -383,19 +645,447 @@ public:
     const QString m_maximumAttribute;
     const QString m_minimumAttribute;
     const QString m_regExpAttribute;
+    const QString m_regularExpressionAttribute;
 };
 
 QtVariantPropertyManagerPrivate::QtVariantPropertyManagerPrivate() :
-    m_constraintAttribute(QLatin1String("constraint")),
-    m_singleStepAttribute(QLatin1String("singleStep")),
-    m_decimalsAttribute(QLatin1String("decimals")),
-    m_enumIconsAttribute(QLatin1String("enumIcons")),
-    m_enumNamesAttribute(QLatin1String("enumNames")),
-    m_flagNamesAttribute(QLatin1String("flagNames")),
-    m_maximumAttribute(QLatin1String("maximum")),
-    m_minimumAttribute(QLatin1String("minimum")),
-    m_regExpAttribute(QLatin1String("regExp"))
+    m_constraintAttribute(variantAttributeRegistry()->name(ConstraintAttribute)),
+    m_singleStepAttribute(variantAttributeRegistry()->name(SingleStepAttribute)),
+    m_decimalsAttribute(variantAttributeRegistry()->name(DecimalsAttribute)),
+    m_enumIconsAttribute(variantAttributeRegistry()->name(EnumIconsAttribute)),
+    m_enumNamesAttribute(variantAttributeRegistry()->name(EnumNamesAttribute)),
+    m_flagNamesAttribute(variantAttributeRegistry()->name(FlagNamesAttribute)),
+    m_maximumAttribute(variantAttributeRegistry()->name(MaximumAttribute)),
+    m_minimumAttribute(variantAttributeRegistry()->name(MinimumAttribute)),
+    m_regExpAttribute(variantAttributeRegistry()->name(RegExpAttribute)),
+    m_regularExpressionAttribute(variantAttributeRegistry()->name(RegularExpressionAttribute))
+{
+}
+
+static QVariant intAttributeValue(QtAbstractPropertyManager *manager,
+            const QtProperty *property, int attributeId)
+{
+    const QtIntPropertyManager *intManager = static_cast<const QtIntPropertyManager *>(manager);
+    if (attributeId == MaximumAttribute)
+        return intManager->maximum(property);
+    if (attributeId == MinimumAttribute)
+        return intManager->minimum(property);
+    if (attributeId == SingleStepAttribute)
+        return intManager->singleStep(property);
+    return QVariant();
+}
+
+static void setIntAttribute(QtAbstractPropertyManager *manager, QtProperty *property,
+            int attributeId, const QVariant &value)
+{
+    QtIntPropertyManager *intManager = static_cast<QtIntPropertyManager *>(manager);
+    if (attributeId == MaximumAttribute)
+        intManager->setMaximum(property, value.value<int>());
+    else if (attributeId == MinimumAttribute)
+        intManager->setMinimum(property, value.value<int>());
+    else if (attributeId == SingleStepAttribute)
+        intManager->setSingleStep(property, value.value<int>());
+}
+
+static QVariant doubleAttributeValue(QtAbstractPropertyManager *manager,
+            const QtProperty *property, int attributeId)
+{
+    const QtDoublePropertyManager *doubleManager = static_cast<const QtDoublePropertyManager *>(manager);
+    if (attributeId == MaximumAttribute)
+        return doubleManager->maximum(property);
+    if (attributeId == MinimumAttribute)
+        return doubleManager->minimum(property);
+    if (attributeId == SingleStepAttribute)
+        return doubleManager->singleStep(property);
+    if (attributeId == DecimalsAttribute)
+        return doubleManager->decimals(property);
+    return QVariant();
+}
+
+static void setDoubleAttribute(QtAbstractPropertyManager *manager, QtProperty *property,
+            int attributeId, const QVariant &value)
+{
+    QtDoublePropertyManager *doubleManager = static_cast<QtDoublePropertyManager *>(manager);
+    if (attributeId == MaximumAttribute)
+        doubleManager->setMaximum(property, value.value<double>());
+    if (attributeId == MinimumAttribute)
+        doubleManager->setMinimum(property, value.value<double>());
+    if (attributeId == SingleStepAttribute)
+        doubleManager->setSingleStep(property, value.value<double>());
+    if (attributeId == DecimalsAttribute)
+        doubleManager->setDecimals(property, value.value<int>());
+}
+
+static QVariant stringAttributeValue(QtAbstractPropertyManager *manager,
+            const QtProperty *property, int attributeId)
+{
+    const QtStringPropertyManager *stringManager = static_cast<const QtStringPropertyManager *>(manager);
+    if (attributeId == RegExpAttribute)
+        return stringManager->regExp(property);
+    if (attributeId == RegularExpressionAttribute)
+        return stringManager->regularExpression(property);
+    return QVariant();
+}
+
+static void setStringAttribute(QtAbstractPropertyManager *manager, QtProperty *property,
+            int attributeId, const QVariant &value)
+{
+    QtStringPropertyManager *stringManager = static_cast<QtStringPropertyManager *>(manager);
+    if (attributeId == RegExpAttribute)
+        stringManager->setRegExp(property, value.value<QRegExp>());
+    if (attributeId == RegularExpressionAttribute)
+        stringManager->setRegularExpression(property, value.value<QRegularExpression>());
+}
+
+static QVariant dateAttributeValue(QtAbstractPropertyManager *manager,
+            const QtProperty *property, int attributeId)
 {
+    const QtDatePropertyManager *dateManager = static_cast<const QtDatePropertyManager *>(manager);
+    if (attributeId == MaximumAttribute)
+        return dateManager->maximum(property);
+    if (attributeId == MinimumAttribute)
+        return dateManager->minimum(property);
+    return QVariant();
+}
+
+static void setDateAttribute(QtAbstractPropertyManager *manager, QtProperty *property,
+            int attributeId, const QVariant &value)
+{
+    QtDatePropertyManager *dateManager = static_cast<QtDatePropertyManager *>(manager);
+    if (attributeId == MaximumAttribute)
+        dateManager->setMaximum(property, value.value<QDate>());
+    if (attributeId == MinimumAttribute)
+        dateManager->setMinimum(property, value.value<QDate>());
+}
+
+static QVariant pointFAttributeValue(QtAbstractPropertyManager *manager,
+            const QtProperty *property, int attributeId)
+{
+    const QtPointFPropertyManager *pointFManager = static_cast<const QtPointFPropertyManager *>(manager);
+    if (attributeId == DecimalsAttribute)
+        return pointFManager->decimals(property);
+    return QVariant();
+}
+
+static void setPointFAttribute(QtAbstractPropertyManager *manager, QtProperty *property,
+            int attributeId, const QVariant &value)
+{
+    QtPointFPropertyManager *pointFManager = static_cast<QtPointFPropertyManager *>(manager);
+    if (attributeId == DecimalsAttribute)
+        pointFManager->setDecimals(property, value.value<int>());
+}
+
+static QVariant sizeAttributeValue(QtAbstractPropertyManager *manager,
+            const QtProperty *property, int attributeId)
+{
+    const QtSizePropertyManager *sizeManager = static_cast<const QtSizePropertyManager *>(manager);
+    if (attributeId == MaximumAttribute)
+        return sizeManager->maximum(property);
+    if (attributeId == MinimumAttribute)
+        return sizeManager->minimum(property);
+    return QVariant();
+}
+
+static void setSizeAttribute(QtAbstractPropertyManager *manager, QtProperty *property,
+            int attributeId, const QVariant &value)
+{
+    QtSizePropertyManager *sizeManager = static_cast<QtSizePropertyManager *>(manager);
+    if (attributeId == MaximumAttribute)
+        sizeManager->setMaximum(property, value.value<QSize>());
+    if (attributeId == MinimumAttribute)
+        sizeManager->setMinimum(property, value.value<QSize>());
+}
+
+static QVariant sizeFAttributeValue(QtAbstractPropertyManager *manager,
+            const QtProperty *property, int attributeId)
+{
+    const QtSizeFPropertyManager *sizeFManager = static_cast<const QtSizeFPropertyManager *>(manager);
+    if (attributeId == MaximumAttribute)
+        return sizeFManager->maximum(property);
+    if (attributeId == MinimumAttribute)
+        return sizeFManager->minimum(property);
+    if (attributeId == DecimalsAttribute)
+        return sizeFManager->decimals(property);
+    return QVariant();
+}
+
+static void setSizeFAttribute(QtAbstractPropertyManager *manager, QtProperty *property,
+            int attributeId, const QVariant &value)
+{
+    QtSizeFPropertyManager *sizeFManager = static_cast<QtSizeFPropertyManager *>(manager);
+    if (attributeId == MaximumAttribute)
+        sizeFManager->setMaximum(property, value.value<QSizeF>());
+    if (attributeId == MinimumAttribute)
+        sizeFManager->setMinimum(property, value.value<QSizeF>());
+    if (attributeId == DecimalsAttribute)
+        sizeFManager->setDecimals(property, value.value<int>());
+}
+
+static QVariant rectAttributeValue(QtAbstractPropertyManager *manager,
+            const QtProperty *property, int attributeId)
+{
+    const QtRectPropertyManager *rectManager = static_cast<const QtRectPropertyManager *>(manager);
+    if (attributeId == ConstraintAttribute)
+        return rectManager->constraint(property);
+    return QVariant();
+}
+
+static void setRectAttribute(QtAbstractPropertyManager *manager, QtProperty *property,
+            int attributeId, const QVariant &value)
+{
+    QtRectPropertyManager *rectManager = static_cast<QtRectPropertyManager *>(manager);
+    if (attributeId == ConstraintAttribute)
+        rectManager->setConstraint(property, value.value<QRect>());
+}
+
+static QVariant rectFAttributeValue(QtAbstractPropertyManager *manager,
+            const QtProperty *property, int attributeId)
+{
+    const QtRectFPropertyManager *rectFManager = static_cast<const QtRectFPropertyManager *>(manager);
+    if (attributeId == ConstraintAttribute)
+        return rectFManager->constraint(property);
+    if (attributeId == DecimalsAttribute)
+        return rectFManager->decimals(property);
+    return QVariant();
+}
+
+static void setRectFAttribute(QtAbstractPropertyManager *manager, QtProperty *property,
+            int attributeId, const QVariant &value)
+{
+    QtRectFPropertyManager *rectFManager = static_cast<QtRectFPropertyManager *>(manager);
+    if (attributeId == ConstraintAttribute)
+        rectFManager->setConstraint(property, value.value<QRectF>());
+    if (attributeId == DecimalsAttribute)
+        rectFManager->setDecimals(property, value.value<int>());
+}
+
+static QVariant enumAttributeValue(QtAbstractPropertyManager *manager,
+            const QtProperty *property, int attributeId)
+{
+    const QtEnumPropertyManager *enumManager = static_cast<const QtEnumPropertyManager *>(manager);
+    if (attributeId == EnumNamesAttribute)
+        return enumManager->enumNames(property);
+    if (attributeId == EnumIconsAttribute) {
+        QVariant v;
+        qVariantSetValue(v, enumManager->enumIcons(property));
+        return v;
+    }
+    return QVariant();
+}
+
+static void setEnumAttribute(QtAbstractPropertyManager *manager, QtProperty *property,
+            int attributeId, const QVariant &value)
+{
+    QtEnumPropertyManager *enumManager = static_cast<QtEnumPropertyManager *>(manager);
+    if (attributeId == EnumNamesAttribute)
+        enumManager->setEnumNames(property, value.value<QStringList>());
+    if (attributeId == EnumIconsAttribute)
+        enumManager->setEnumIcons(property, value.value<QtIconMap>());
+}
+
+static QVariant flagAttributeValue(QtAbstractPropertyManager *manager,
+            const QtProperty *property, int attributeId)
+{
+    const QtFlagPropertyManager *flagManager = static_cast<const QtFlagPropertyManager *>(manager);
+    if (attributeId == FlagNamesAttribute)
+        return flagManager->flagNames(property);
+    return QVariant();
+}
+
+static void setFlagAttribute(QtAbstractPropertyManager *manager, QtProperty *property,
+            int attributeId, const QVariant &value)
+{
+    QtFlagPropertyManager *flagManager = static_cast<QtFlagPropertyManager *>(manager);
+    if (attributeId == FlagNamesAttribute)
+        flagManager->setFlagNames(property, value.value<QStringList>());
+}
+
+// Thin properties are offered for simple value types without sub
+// properties, whose value text and icon the variant manager can produce
+// itself.
+static bool isThinPropertyType(int propertyType)
+{
+    switch (propertyType) {
+    case QVariant::Bool:
+    case QVariant::Int:
+    case QVariant::Double:
+    case QVariant::String:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+// Formats like the typed managers do; decimals is the default of
+// QtDoublePropertyManager.
+static QString thinValueText(const QVariant &value, int decimals)
+{
+    switch (value.userType()) {
+    case QVariant::Bool:
+        return QtPropertyBrowserUtils::boolValueText(value.toBool());
+    case QVariant::Double:
+        return QString::number(value.toDouble(), 'f', decimals);
+    default:
+        break;
+    }
+    return value.toString();
+}
+
+static QIcon thinValueIcon(const QVariant &value)
+{
+    if (value.userType() == QVariant::Bool)
+        return QtPropertyBrowserUtils::boolValueIcon(value.toBool());
+    return QIcon();
+}
+
+// Lets the typed editor factories edit the properties of a variant manager
+// through its variant interface, without an internal property.
+class QtVariantEditorAdapter : public QtPropertyEditorAdapter
+{
+public:
+    explicit QtVariantEditorAdapter(QtVariantPropertyManager *manager);
+
+    QVariant value(const QtProperty *property) const
+        { return m_manager->value(property); }
+    QVariant attributeValue(const QtProperty *property, const QString &attribute) const
+        { return m_manager->attributeValue(property, attribute); }
+    void setValue(QtProperty *property, const QVariant &value)
+        { m_manager->setValue(property, value); }
+
+private:
+    QtVariantPropertyManager *m_manager;
+};
+
+QtVariantEditorAdapter::QtVariantEditorAdapter(QtVariantPropertyManager *manager) :
+    QtPropertyEditorAdapter(manager),
+    m_manager(manager)
+{
+    connect(manager, SIGNAL(valueChanged(QtProperty *, const QVariant &)),
+                this, SIGNAL(valueChanged(QtProperty *)));
+    connect(manager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SIGNAL(valuesChanged(QList<QtProperty *>)));
+    connect(manager, SIGNAL(attributeChanged(QtProperty *, const QString &, const QVariant &)),
+                this, SIGNAL(attributeChanged(QtProperty *)));
+}
+
+QtPropertyEditorAdapter *QtVariantPropertyManagerPrivate::editorAdapter(const QtVariantProperty *property)
+{
+    QtVariantPropertyManagerPrivate *d = property->d_ptr->manager->d_func();
+    if (!d->m_editorAdapter)
+        d->m_editorAdapter = new QtVariantEditorAdapter(d->q_ptr);
+    return d->m_editorAdapter;
+}
+
+void QtVariantPropertyManagerPrivate::materializeProperty(QtVariantPropertyPrivate *data)
+{
+    QtAbstractPropertyManager *manager = m_typeToPropertyManager.value(data->propertyType, 0);
+    const QVariant val = data->thinValue;
+    data->thin = false;
+    data->thinValue = QVariant();
+
+    QtProperty *internal = manager->addProperty();
+    // Transfer the value before the internal property is linked to the
+    // variant property, so that no change is reported for it.
+    m_typeToAccessor.value(data->propertyType).setValue(manager, internal, val);
+    setInternalProperty(data->q_ptr, internal);
+}
+
+QtVariantPropertyPrivate *QtVariantPropertyManagerPrivate::materializedProperty(const QtProperty *property)
+{
+    QtVariantPropertyPrivate *data = m_propertyToData.value(property, 0);
+    if (!data)
+        return 0;
+    if (data->thin)
+        materializeProperty(data);
+    return data->accessor ? data : 0;
+}
+
+bool QtVariantPropertyManagerPrivate::hasAttribute(int propertyType, int attributeId) const
+{
+    const QMap<int, QHash<int, int> >::ConstIterator it =
+            m_typeToAttributeIdToAttributeType.constFind(propertyType);
+    return it != m_typeToAttributeIdToAttributeType.constEnd() && it.value().contains(attributeId);
+}
+
+QVariant QtVariantPropertyManagerPrivate::defaultAttributeValue(int propertyType, int attributeId)
+{
+    const QMap<int, QtVariantPropertyAccessor>::ConstIterator it = m_typeToAccessor.constFind(propertyType);
+    if (it == m_typeToAccessor.constEnd() || !it.value().attributeValue)
+        return QVariant();
+    QtAbstractPropertyManager *manager = m_typeToPropertyManager.value(propertyType, 0);
+    QtProperty *&property = m_typeToDefaultProperty[propertyType];
+    if (!property)
+        property = manager->addProperty();
+    return it.value().attributeValue(manager, property, attributeId);
+}
+
+// Keeps the value within the default range of the typed manager, so that
+// the value of a thin property does not change once it gets an internal
+// property.
+QVariant QtVariantPropertyManagerPrivate::boundThinValue(const QtVariantPropertyPrivate *data,
+            const QVariant &val)
+{
+    QVariant result = val;
+    result.convert(data->valueType);
+    switch (data->valueType) {
+    case QVariant::Int:
+        return QVariant(qBound(defaultAttributeValue(data->propertyType, MinimumAttribute).toInt(), result.toInt(),
+                    defaultAttributeValue(data->propertyType, MaximumAttribute).toInt()));
+    case QVariant::Double:
+        return QVariant(qBound(defaultAttributeValue(data->propertyType, MinimumAttribute).toDouble(), result.toDouble(),
+                    defaultAttributeValue(data->propertyType, MaximumAttribute).toDouble()));
+    default:
+        break;
+    }
+    return result;
+}
+
+void QtVariantPropertyManagerPrivate::setThinValue(QtVariantPropertyPrivate *data, const QVariant &val)
+{
+    const QVariant newVal = boundThinValue(data, val);
+    if (newVal == data->thinValue)
+        return;
+
+    data->thinValue = newVal;
+
+    if (m_changedProperties) {
+        m_changedProperties->append(data->q_ptr);
+        return;
+    }
+    emit q_ptr->valueChanged(data->q_ptr, newVal);
+    emit q_ptr->propertyChanged(data->q_ptr);
+}
+
+void QtVariantPropertyManagerPrivate::addAttribute(int propertyType, int attributeId, int attributeType)
+{
+    m_typeToAttributeToAttributeType[propertyType][variantAttributeRegistry()->name(attributeId)] = attributeType;
+    m_typeToAttributeIdToAttributeType[propertyType][attributeId] = attributeType;
+}
+
+void QtVariantPropertyManagerPrivate::setInternalProperty(QtVariantProperty *property, QtProperty *internal)
+{
+    QtVariantPropertyPrivate *data = property->d_ptr;
+    const QMap<int, QtVariantPropertyAccessor>::ConstIterator it = m_typeToAccessor.constFind(data->propertyType);
+    data->wrappedProperty = internal;
+    data->wrappedManager = internal->propertyManager();
+    data->accessor = it == m_typeToAccessor.constEnd() ? 0 : &it.value();
+    data->valueType = m_typeToValueType.value(data->propertyType, 0);
+    const QMap<int, QHash<int, int> >::ConstIterator itAttributes =
+            m_typeToAttributeIdToAttributeType.constFind(data->propertyType);
+    data->attributeTypes = itAttributes == m_typeToAttributeIdToAttributeType.constEnd()
+            ? 0 : &itAttributes.value();
+    m_internalToProperty.insert(internal, property);
+}
+
+QtProperty *QtVariantPropertyManagerPrivate::wrappedProperty(const QtVariantProperty *property)
+{
+    if (!property)
+        return 0;
+    QtVariantPropertyPrivate *data = property->d_ptr;
+    if (data->thin)
+        data->manager->d_func()->materializeProperty(data);
+    return data->wrappedProperty;
 }
 
 int QtVariantPropertyManagerPrivate::internalPropertyToType(QtProperty *property) const
@@ -434,20 +1124,16 @@ QtVariantProperty *QtVariantPropertyManagerPrivate::createSubProperty(QtVariantP
 
     parent->insertSubProperty(varChild, after);
 
-    m_internalToProperty[internal] = varChild;
-    propertyToWrappedProperty()->insert(varChild, internal);
+    setInternalProperty(varChild, internal);
     return varChild;
 }
 
 void QtVariantPropertyManagerPrivate::removeSubProperty(QtVariantProperty *property)
 {
-    QtProperty *internChild = wrappedProperty(property);
     bool wasDestroyingSubProperties = m_destroyingSubProperties;
     m_destroyingSubProperties = true;
     delete property;
     m_destroyingSubProperties = wasDestroyingSubProperties;
-    m_internalToProperty.remove(internChild);
-    propertyToWrappedProperty()->remove(property);
 }
 
 void QtVariantPropertyManagerPrivate::slotPropertyInserted(QtProperty *property,
@@ -481,11 +1167,44 @@ void QtVariantPropertyManagerPrivate::slotPropertyRemoved(QtProperty *property,
     removeSubProperty(varProperty);
 }
 
+// Reports the properties collected in a batch once each, with a single
+// propertiesChanged() and valuesChanged() signal, or hands them on to the
+// enclosing batch. m_changedProperties must already be restored.
+void QtVariantPropertyManagerPrivate::reportChangedProperties(const QList<QtProperty *> &changedProperties)
+{
+    if (changedProperties.isEmpty())
+        return;
+
+    // A property may have been reported by both its own and a parent's change
+    QSet<QtProperty *> seen;
+    QList<QtProperty *> changed;
+    QListIterator<QtProperty *> itChanged(changedProperties);
+    while (itChanged.hasNext()) {
+        QtProperty *property = itChanged.next();
+        if (!seen.contains(property)) {
+            seen.insert(property);
+            changed.append(property);
+        }
+    }
+
+    if (m_changedProperties) {
+        *m_changedProperties += changed;
+        return;
+    }
+
+    emit q_ptr->propertiesChanged(changed);
+    emit q_ptr->valuesChanged(changed);
+}
+
 void QtVariantPropertyManagerPrivate::valueChanged(QtProperty *property, const QVariant &val)
 {
     QtVariantProperty *varProp = m_internalToProperty.value(property, 0);
     if (!varProp)
         return;
+    if (m_changedProperties) {
+        m_changedProperties->append(varProp);
+        return;
+    }
     emit q_ptr->valueChanged(varProp, val);
     emit q_ptr->propertyChanged(varProp);
 }
@@ -514,6 +1233,30 @@ void QtVariantPropertyManagerPrivate::slotValueChanged(QtProperty *property, dou
     valueChanged(property, QVariant(val));
 }
 
+void QtVariantPropertyManagerPrivate::slotTypedValueChanged(QtProperty *property)
+{
+    QtVariantProperty *varProp = m_internalToProperty.value(property, 0);
+    if (!varProp)
+        return;
+    const QtVariantPropertyPrivate *data = varProp->d_ptr;
+    if (data->accessor)
+        valueChanged(property, data->accessor->value(data->wrappedManager, property));
+}
+
+void QtVariantPropertyManagerPrivate::slotValuesChanged(const QList<QtProperty *> &properties)
+{
+    QList<QtProperty *> changedProperties;
+    QList<QtProperty *> *wasChangedProperties = m_changedProperties;
+    m_changedProperties = &changedProperties;
+
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext())
+        slotTypedValueChanged(itProperty.next());
+
+    m_changedProperties = wasChangedProperties;
+    reportChangedProperties(changedProperties);
+}
+
 void QtVariantPropertyManagerPrivate::slotRangeChanged(QtProperty *property, double min, double max)
 {
     if (QtVariantProperty *varProp = m_internalToProperty.value(property, 0)) {
@@ -550,6 +1293,12 @@ void QtVariantPropertyManagerPrivate::slotRegExpChanged(QtProperty *property, co
         emit q_ptr->attributeChanged(varProp, m_regExpAttribute, QVariant(regExp));
 }
 
+void QtVariantPropertyManagerPrivate::slotRegularExpressionChanged(QtProperty *property, const QRegularExpression &regularExpression)
+{
+    if (QtVariantProperty *varProp = m_internalToProperty.value(property, 0))
+        emit q_ptr->attributeChanged(varProp, m_regularExpressionAttribute, QVariant(regularExpression));
+}
+
 void QtVariantPropertyManagerPrivate::slotValueChanged(QtProperty *property, const QDate &val)
 {
     valueChanged(property, QVariant(val));
@@ -837,6 +1586,10 @@ void QtVariantPropertyManagerPrivate::slotFlagNamesChanged(QtProperty *property,
         \o QString
         \o regExp
         \o QVariant::RegExp
+    \row
+        \o
+        \o regularExpression
+        \o QVariant::RegularExpression
     \row
         \o QDate
         \o minimum
@@ -919,6 +1672,17 @@ void QtVariantPropertyManagerPrivate::slotFlagNamesChanged(QtProperty *property,
     \sa setValue()
 */
 
+/*!
+    \fn void QtVariantPropertyManager::valuesChanged(const QList<QtProperty *> &properties)
+
+    This signal is emitted once by setValues() for all \a properties
+    whose value changed, instead of valueChanged() for each of them.
+    It is also emitted when an internal manager reports a batch of
+    changes, e.g. from QtIntPropertyManager::setValues().
+
+    \sa setValues()
+*/
+
 /*!
     \fn void QtVariantPropertyManager::attributeChanged(QtProperty *property,
                 const QString &attribute, const QVariant &value)
@@ -943,16 +1707,24 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     d_ptr->m_creatingSubProperties = false;
     d_ptr->m_destroyingSubProperties = false;
     d_ptr->m_propertyType = 0;
+    d_ptr->m_thinPropertiesEnabled = false;
+    d_ptr->m_editorAdapter = 0;
+    d_ptr->m_changedProperties = 0;
 
     // IntPropertyManager
     QtIntPropertyManager *intPropertyManager = new QtIntPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Int] = intPropertyManager;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Int][d_ptr->m_minimumAttribute] = QVariant::Int;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Int][d_ptr->m_maximumAttribute] = QVariant::Int;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Int][d_ptr->m_singleStepAttribute] = QVariant::Int;
+    d_ptr->m_typeToAccessor[QVariant::Int] = variantPropertyAccessor<QtIntPropertyManager, int>(
+                intAttributeValue, setIntAttribute);
+    d_ptr->m_typeToAccessor[QVariant::Int].setValues = setManagerValues<QtIntPropertyManager, int>;
+    d_ptr->addAttribute(QVariant::Int, MinimumAttribute, QVariant::Int);
+    d_ptr->addAttribute(QVariant::Int, MaximumAttribute, QVariant::Int);
+    d_ptr->addAttribute(QVariant::Int, SingleStepAttribute, QVariant::Int);
     d_ptr->m_typeToValueType[QVariant::Int] = QVariant::Int;
     connect(intPropertyManager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotValueChanged(QtProperty *, int)));
+    connect(intPropertyManager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotValuesChanged(QList<QtProperty *>)));
     connect(intPropertyManager, SIGNAL(rangeChanged(QtProperty *, int, int)),
                 this, SLOT(slotRangeChanged(QtProperty *, int, int)));
     connect(intPropertyManager, SIGNAL(singleStepChanged(QtProperty *, int)),
@@ -960,17 +1732,18 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // DoublePropertyManager
     QtDoublePropertyManager *doublePropertyManager = new QtDoublePropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Double] = doublePropertyManager;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Double][d_ptr->m_minimumAttribute] =
-            QVariant::Double;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Double][d_ptr->m_maximumAttribute] =
-            QVariant::Double;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Double][d_ptr->m_singleStepAttribute] =
-            QVariant::Double;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Double][d_ptr->m_decimalsAttribute] =
-            QVariant::Int;
+    d_ptr->m_typeToAccessor[QVariant::Double] = variantPropertyAccessor<QtDoublePropertyManager, double>(
+                doubleAttributeValue, setDoubleAttribute);
+    d_ptr->m_typeToAccessor[QVariant::Double].setValues = setManagerValues<QtDoublePropertyManager, double>;
+    d_ptr->addAttribute(QVariant::Double, MinimumAttribute, QVariant::Double);
+    d_ptr->addAttribute(QVariant::Double, MaximumAttribute, QVariant::Double);
+    d_ptr->addAttribute(QVariant::Double, SingleStepAttribute, QVariant::Double);
+    d_ptr->addAttribute(QVariant::Double, DecimalsAttribute, QVariant::Int);
     d_ptr->m_typeToValueType[QVariant::Double] = QVariant::Double;
     connect(doublePropertyManager, SIGNAL(valueChanged(QtProperty *, double)),
                 this, SLOT(slotValueChanged(QtProperty *, double)));
+    connect(doublePropertyManager, SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotValuesChanged(QList<QtProperty *>)));
     connect(doublePropertyManager, SIGNAL(rangeChanged(QtProperty *, double, double)),
                 this, SLOT(slotRangeChanged(QtProperty *, double, double)));
     connect(doublePropertyManager, SIGNAL(singleStepChanged(QtProperty *, double)),
@@ -980,27 +1753,32 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // BoolPropertyManager
     QtBoolPropertyManager *boolPropertyManager = new QtBoolPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Bool] = boolPropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::Bool] = variantPropertyAccessor<QtBoolPropertyManager, bool>();
     d_ptr->m_typeToValueType[QVariant::Bool] = QVariant::Bool;
     connect(boolPropertyManager, SIGNAL(valueChanged(QtProperty *, bool)),
                 this, SLOT(slotValueChanged(QtProperty *, bool)));
     // StringPropertyManager
     QtStringPropertyManager *stringPropertyManager = new QtStringPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::String] = stringPropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::String] = variantPropertyAccessor<QtStringPropertyManager, QString>(
+                stringAttributeValue, setStringAttribute);
     d_ptr->m_typeToValueType[QVariant::String] = QVariant::String;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::String][d_ptr->m_regExpAttribute] =
-            QVariant::RegExp;
+    d_ptr->addAttribute(QVariant::String, RegExpAttribute, QVariant::RegExp);
+    d_ptr->addAttribute(QVariant::String, RegularExpressionAttribute, QVariant::RegularExpression);
     connect(stringPropertyManager, SIGNAL(valueChanged(QtProperty *, const QString &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QString &)));
     connect(stringPropertyManager, SIGNAL(regExpChanged(QtProperty *, const QRegExp &)),
                 this, SLOT(slotRegExpChanged(QtProperty *, const QRegExp &)));
+    connect(stringPropertyManager, SIGNAL(regularExpressionChanged(QtProperty *, const QRegularExpression &)),
+                this, SLOT(slotRegularExpressionChanged(QtProperty *, const QRegularExpression &)));
     // DatePropertyManager
     QtDatePropertyManager *datePropertyManager = new QtDatePropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Date] = datePropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::Date] = variantPropertyAccessor<QtDatePropertyManager, QDate>(
+                dateAttributeValue, setDateAttribute);
     d_ptr->m_typeToValueType[QVariant::Date] = QVariant::Date;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Date][d_ptr->m_minimumAttribute] =
-            QVariant::Date;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Date][d_ptr->m_maximumAttribute] =
-            QVariant::Date;
+    d_ptr->addAttribute(QVariant::Date, MinimumAttribute, QVariant::Date);
+    d_ptr->addAttribute(QVariant::Date, MaximumAttribute, QVariant::Date);
     connect(datePropertyManager, SIGNAL(valueChanged(QtProperty *, const QDate &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QDate &)));
     connect(datePropertyManager, SIGNAL(rangeChanged(QtProperty *, const QDate &, const QDate &)),
@@ -1008,30 +1786,35 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // TimePropertyManager
     QtTimePropertyManager *timePropertyManager = new QtTimePropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Time] = timePropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::Time] = variantPropertyAccessor<QtTimePropertyManager, QTime>();
     d_ptr->m_typeToValueType[QVariant::Time] = QVariant::Time;
     connect(timePropertyManager, SIGNAL(valueChanged(QtProperty *, const QTime &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QTime &)));
     // DateTimePropertyManager
     QtDateTimePropertyManager *dateTimePropertyManager = new QtDateTimePropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::DateTime] = dateTimePropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::DateTime] = variantPropertyAccessor<QtDateTimePropertyManager, QDateTime>();
     d_ptr->m_typeToValueType[QVariant::DateTime] = QVariant::DateTime;
     connect(dateTimePropertyManager, SIGNAL(valueChanged(QtProperty *, const QDateTime &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QDateTime &)));
     // KeySequencePropertyManager
     QtKeySequencePropertyManager *keySequencePropertyManager = new QtKeySequencePropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::KeySequence] = keySequencePropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::KeySequence] = variantPropertyAccessor<QtKeySequencePropertyManager, QKeySequence>();
     d_ptr->m_typeToValueType[QVariant::KeySequence] = QVariant::KeySequence;
     connect(keySequencePropertyManager, SIGNAL(valueChanged(QtProperty *, const QKeySequence &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QKeySequence &)));
     // CharPropertyManager
     QtCharPropertyManager *charPropertyManager = new QtCharPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Char] = charPropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::Char] = variantPropertyAccessor<QtCharPropertyManager, QChar>();
     d_ptr->m_typeToValueType[QVariant::Char] = QVariant::Char;
     connect(charPropertyManager, SIGNAL(valueChanged(QtProperty *, const QChar &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QChar &)));
     // LocalePropertyManager
     QtLocalePropertyManager *localePropertyManager = new QtLocalePropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Locale] = localePropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::Locale] = variantPropertyAccessor<QtLocalePropertyManager, QLocale>();
     d_ptr->m_typeToValueType[QVariant::Locale] = QVariant::Locale;
     connect(localePropertyManager, SIGNAL(valueChanged(QtProperty *, const QLocale &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QLocale &)));
@@ -1044,11 +1827,14 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // PointPropertyManager
     QtPointPropertyManager *pointPropertyManager = new QtPointPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Point] = pointPropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::Point] = variantPropertyAccessor<QtPointPropertyManager, QPoint>();
     d_ptr->m_typeToValueType[QVariant::Point] = QVariant::Point;
     connect(pointPropertyManager, SIGNAL(valueChanged(QtProperty *, const QPoint &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QPoint &)));
     connect(pointPropertyManager->subIntPropertyManager(), SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotValueChanged(QtProperty *, int)));
+    connect(pointPropertyManager->subIntPropertyManager(), SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotValuesChanged(QList<QtProperty *>)));
     connect(pointPropertyManager, SIGNAL(propertyInserted(QtProperty *, QtProperty *, QtProperty *)),
                 this, SLOT(slotPropertyInserted(QtProperty *, QtProperty *, QtProperty *)));
     connect(pointPropertyManager, SIGNAL(propertyRemoved(QtProperty *, QtProperty *)),
@@ -1056,15 +1842,18 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // PointFPropertyManager
     QtPointFPropertyManager *pointFPropertyManager = new QtPointFPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::PointF] = pointFPropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::PointF] = variantPropertyAccessor<QtPointFPropertyManager, QPointF>(
+                pointFAttributeValue, setPointFAttribute);
     d_ptr->m_typeToValueType[QVariant::PointF] = QVariant::PointF;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::PointF][d_ptr->m_decimalsAttribute] =
-            QVariant::Int;
+    d_ptr->addAttribute(QVariant::PointF, DecimalsAttribute, QVariant::Int);
     connect(pointFPropertyManager, SIGNAL(valueChanged(QtProperty *, const QPointF &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QPointF &)));
     connect(pointFPropertyManager, SIGNAL(decimalsChanged(QtProperty *, int)),
                 this, SLOT(slotDecimalsChanged(QtProperty *, int)));
     connect(pointFPropertyManager->subDoublePropertyManager(), SIGNAL(valueChanged(QtProperty *, double)),
                 this, SLOT(slotValueChanged(QtProperty *, double)));
+    connect(pointFPropertyManager->subDoublePropertyManager(), SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotValuesChanged(QList<QtProperty *>)));
     connect(pointFPropertyManager, SIGNAL(propertyInserted(QtProperty *, QtProperty *, QtProperty *)),
                 this, SLOT(slotPropertyInserted(QtProperty *, QtProperty *, QtProperty *)));
     connect(pointFPropertyManager, SIGNAL(propertyRemoved(QtProperty *, QtProperty *)),
@@ -1072,17 +1861,19 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // SizePropertyManager
     QtSizePropertyManager *sizePropertyManager = new QtSizePropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Size] = sizePropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::Size] = variantPropertyAccessor<QtSizePropertyManager, QSize>(
+                sizeAttributeValue, setSizeAttribute);
     d_ptr->m_typeToValueType[QVariant::Size] = QVariant::Size;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Size][d_ptr->m_minimumAttribute] =
-            QVariant::Size;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Size][d_ptr->m_maximumAttribute] =
-            QVariant::Size;
+    d_ptr->addAttribute(QVariant::Size, MinimumAttribute, QVariant::Size);
+    d_ptr->addAttribute(QVariant::Size, MaximumAttribute, QVariant::Size);
     connect(sizePropertyManager, SIGNAL(valueChanged(QtProperty *, const QSize &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QSize &)));
     connect(sizePropertyManager, SIGNAL(rangeChanged(QtProperty *, const QSize &, const QSize &)),
                 this, SLOT(slotRangeChanged(QtProperty *, const QSize &, const QSize &)));
     connect(sizePropertyManager->subIntPropertyManager(), SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotValueChanged(QtProperty *, int)));
+    connect(sizePropertyManager->subIntPropertyManager(), SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotValuesChanged(QList<QtProperty *>)));
     connect(sizePropertyManager->subIntPropertyManager(), SIGNAL(rangeChanged(QtProperty *, int, int)),
                 this, SLOT(slotRangeChanged(QtProperty *, int, int)));
     connect(sizePropertyManager, SIGNAL(propertyInserted(QtProperty *, QtProperty *, QtProperty *)),
@@ -1092,13 +1883,12 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // SizeFPropertyManager
     QtSizeFPropertyManager *sizeFPropertyManager = new QtSizeFPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::SizeF] = sizeFPropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::SizeF] = variantPropertyAccessor<QtSizeFPropertyManager, QSizeF>(
+                sizeFAttributeValue, setSizeFAttribute);
     d_ptr->m_typeToValueType[QVariant::SizeF] = QVariant::SizeF;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::SizeF][d_ptr->m_minimumAttribute] =
-            QVariant::SizeF;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::SizeF][d_ptr->m_maximumAttribute] =
-            QVariant::SizeF;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::SizeF][d_ptr->m_decimalsAttribute] =
-            QVariant::Int;
+    d_ptr->addAttribute(QVariant::SizeF, MinimumAttribute, QVariant::SizeF);
+    d_ptr->addAttribute(QVariant::SizeF, MaximumAttribute, QVariant::SizeF);
+    d_ptr->addAttribute(QVariant::SizeF, DecimalsAttribute, QVariant::Int);
     connect(sizeFPropertyManager, SIGNAL(valueChanged(QtProperty *, const QSizeF &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QSizeF &)));
     connect(sizeFPropertyManager, SIGNAL(rangeChanged(QtProperty *, const QSizeF &, const QSizeF &)),
@@ -1107,6 +1897,8 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
                 this, SLOT(slotDecimalsChanged(QtProperty *, int)));
     connect(sizeFPropertyManager->subDoublePropertyManager(), SIGNAL(valueChanged(QtProperty *, double)),
                 this, SLOT(slotValueChanged(QtProperty *, double)));
+    connect(sizeFPropertyManager->subDoublePropertyManager(), SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotValuesChanged(QList<QtProperty *>)));
     connect(sizeFPropertyManager->subDoublePropertyManager(), SIGNAL(rangeChanged(QtProperty *, double, double)),
                 this, SLOT(slotRangeChanged(QtProperty *, double, double)));
     connect(sizeFPropertyManager, SIGNAL(propertyInserted(QtProperty *, QtProperty *, QtProperty *)),
@@ -1116,15 +1908,18 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // RectPropertyManager
     QtRectPropertyManager *rectPropertyManager = new QtRectPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Rect] = rectPropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::Rect] = variantPropertyAccessor<QtRectPropertyManager, QRect>(
+                rectAttributeValue, setRectAttribute);
     d_ptr->m_typeToValueType[QVariant::Rect] = QVariant::Rect;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::Rect][d_ptr->m_constraintAttribute] =
-            QVariant::Rect;
+    d_ptr->addAttribute(QVariant::Rect, ConstraintAttribute, QVariant::Rect);
     connect(rectPropertyManager, SIGNAL(valueChanged(QtProperty *, const QRect &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QRect &)));
     connect(rectPropertyManager, SIGNAL(constraintChanged(QtProperty *, const QRect &)),
                 this, SLOT(slotConstraintChanged(QtProperty *, const QRect &)));
     connect(rectPropertyManager->subIntPropertyManager(), SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotValueChanged(QtProperty *, int)));
+    connect(rectPropertyManager->subIntPropertyManager(), SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotValuesChanged(QList<QtProperty *>)));
     connect(rectPropertyManager->subIntPropertyManager(), SIGNAL(rangeChanged(QtProperty *, int, int)),
                 this, SLOT(slotRangeChanged(QtProperty *, int, int)));
     connect(rectPropertyManager, SIGNAL(propertyInserted(QtProperty *, QtProperty *, QtProperty *)),
@@ -1134,11 +1929,11 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // RectFPropertyManager
     QtRectFPropertyManager *rectFPropertyManager = new QtRectFPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::RectF] = rectFPropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::RectF] = variantPropertyAccessor<QtRectFPropertyManager, QRectF>(
+                rectFAttributeValue, setRectFAttribute);
     d_ptr->m_typeToValueType[QVariant::RectF] = QVariant::RectF;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::RectF][d_ptr->m_constraintAttribute] =
-            QVariant::RectF;
-    d_ptr->m_typeToAttributeToAttributeType[QVariant::RectF][d_ptr->m_decimalsAttribute] =
-            QVariant::Int;
+    d_ptr->addAttribute(QVariant::RectF, ConstraintAttribute, QVariant::RectF);
+    d_ptr->addAttribute(QVariant::RectF, DecimalsAttribute, QVariant::Int);
     connect(rectFPropertyManager, SIGNAL(valueChanged(QtProperty *, const QRectF &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QRectF &)));
     connect(rectFPropertyManager, SIGNAL(constraintChanged(QtProperty *, const QRectF &)),
@@ -1147,6 +1942,8 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
                 this, SLOT(slotDecimalsChanged(QtProperty *, int)));
     connect(rectFPropertyManager->subDoublePropertyManager(), SIGNAL(valueChanged(QtProperty *, double)),
                 this, SLOT(slotValueChanged(QtProperty *, double)));
+    connect(rectFPropertyManager->subDoublePropertyManager(), SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotValuesChanged(QList<QtProperty *>)));
     connect(rectFPropertyManager->subDoublePropertyManager(), SIGNAL(rangeChanged(QtProperty *, double, double)),
                 this, SLOT(slotRangeChanged(QtProperty *, double, double)));
     connect(rectFPropertyManager, SIGNAL(propertyInserted(QtProperty *, QtProperty *, QtProperty *)),
@@ -1156,11 +1953,14 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // ColorPropertyManager
     QtColorPropertyManager *colorPropertyManager = new QtColorPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Color] = colorPropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::Color] = variantPropertyAccessor<QtColorPropertyManager, QColor>();
     d_ptr->m_typeToValueType[QVariant::Color] = QVariant::Color;
     connect(colorPropertyManager, SIGNAL(valueChanged(QtProperty *, const QColor &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QColor &)));
     connect(colorPropertyManager->subIntPropertyManager(), SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotValueChanged(QtProperty *, int)));
+    connect(colorPropertyManager->subIntPropertyManager(), SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotValuesChanged(QList<QtProperty *>)));
     connect(colorPropertyManager, SIGNAL(propertyInserted(QtProperty *, QtProperty *, QtProperty *)),
                 this, SLOT(slotPropertyInserted(QtProperty *, QtProperty *, QtProperty *)));
     connect(colorPropertyManager, SIGNAL(propertyRemoved(QtProperty *, QtProperty *)),
@@ -1169,11 +1969,11 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     int enumId = enumTypeId();
     QtEnumPropertyManager *enumPropertyManager = new QtEnumPropertyManager(this);
     d_ptr->m_typeToPropertyManager[enumId] = enumPropertyManager;
+    d_ptr->m_typeToAccessor[enumId] = variantPropertyAccessor<QtEnumPropertyManager, int>(
+                enumAttributeValue, setEnumAttribute);
     d_ptr->m_typeToValueType[enumId] = QVariant::Int;
-    d_ptr->m_typeToAttributeToAttributeType[enumId][d_ptr->m_enumNamesAttribute] =
-            QVariant::StringList;
-    d_ptr->m_typeToAttributeToAttributeType[enumId][d_ptr->m_enumIconsAttribute] =
-            iconMapTypeId();
+    d_ptr->addAttribute(enumId, EnumNamesAttribute, QVariant::StringList);
+    d_ptr->addAttribute(enumId, EnumIconsAttribute, iconMapTypeId());
     connect(enumPropertyManager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotValueChanged(QtProperty *, int)));
     connect(enumPropertyManager, SIGNAL(enumNamesChanged(QtProperty *, const QStringList &)),
@@ -1183,11 +1983,14 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // SizePolicyPropertyManager
     QtSizePolicyPropertyManager *sizePolicyPropertyManager = new QtSizePolicyPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::SizePolicy] = sizePolicyPropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::SizePolicy] = variantPropertyAccessor<QtSizePolicyPropertyManager, QSizePolicy>();
     d_ptr->m_typeToValueType[QVariant::SizePolicy] = QVariant::SizePolicy;
     connect(sizePolicyPropertyManager, SIGNAL(valueChanged(QtProperty *, const QSizePolicy &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QSizePolicy &)));
     connect(sizePolicyPropertyManager->subIntPropertyManager(), SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotValueChanged(QtProperty *, int)));
+    connect(sizePolicyPropertyManager->subIntPropertyManager(), SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotValuesChanged(QList<QtProperty *>)));
     connect(sizePolicyPropertyManager->subIntPropertyManager(), SIGNAL(rangeChanged(QtProperty *, int, int)),
                 this, SLOT(slotRangeChanged(QtProperty *, int, int)));
     connect(sizePolicyPropertyManager->subEnumPropertyManager(), SIGNAL(valueChanged(QtProperty *, int)),
@@ -1202,11 +2005,14 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // FontPropertyManager
     QtFontPropertyManager *fontPropertyManager = new QtFontPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Font] = fontPropertyManager;
+    d_ptr->m_typeToAccessor[QVariant::Font] = variantPropertyAccessor<QtFontPropertyManager, QFont>();
     d_ptr->m_typeToValueType[QVariant::Font] = QVariant::Font;
     connect(fontPropertyManager, SIGNAL(valueChanged(QtProperty *, const QFont &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QFont &)));
     connect(fontPropertyManager->subIntPropertyManager(), SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotValueChanged(QtProperty *, int)));
+    connect(fontPropertyManager->subIntPropertyManager(), SIGNAL(valuesChanged(QList<QtProperty *>)),
+                this, SLOT(slotValuesChanged(QList<QtProperty *>)));
     connect(fontPropertyManager->subIntPropertyManager(), SIGNAL(rangeChanged(QtProperty *, int, int)),
                 this, SLOT(slotRangeChanged(QtProperty *, int, int)));
     connect(fontPropertyManager->subEnumPropertyManager(), SIGNAL(valueChanged(QtProperty *, int)),
@@ -1223,6 +2029,9 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     // CursorPropertyManager
     QtCursorPropertyManager *cursorPropertyManager = new QtCursorPropertyManager(this);
     d_ptr->m_typeToPropertyManager[QVariant::Cursor] = cursorPropertyManager;
+#ifndef QT_NO_CURSOR
+    d_ptr->m_typeToAccessor[QVariant::Cursor] = variantPropertyAccessor<QtCursorPropertyManager, QCursor>();
+#endif
     d_ptr->m_typeToValueType[QVariant::Cursor] = QVariant::Cursor;
     connect(cursorPropertyManager, SIGNAL(valueChanged(QtProperty *, const QCursor &)),
                 this, SLOT(slotValueChanged(QtProperty *, const QCursor &)));
@@ -1230,9 +2039,10 @@ QtVariantPropertyManager::QtVariantPropertyManager(QObject *parent)
     int flagId = flagTypeId();
     QtFlagPropertyManager *flagPropertyManager = new QtFlagPropertyManager(this);
     d_ptr->m_typeToPropertyManager[flagId] = flagPropertyManager;
+    d_ptr->m_typeToAccessor[flagId] = variantPropertyAccessor<QtFlagPropertyManager, int>(
+                flagAttributeValue, setFlagAttribute);
     d_ptr->m_typeToValueType[flagId] = QVariant::Int;
-    d_ptr->m_typeToAttributeToAttributeType[flagId][d_ptr->m_flagNamesAttribute] =
-            QVariant::StringList;
+    d_ptr->addAttribute(flagId, FlagNamesAttribute, QVariant::StringList);
     connect(flagPropertyManager, SIGNAL(valueChanged(QtProperty *, int)),
                 this, SLOT(slotValueChanged(QtProperty *, int)));
     connect(flagPropertyManager, SIGNAL(flagNamesChanged(QtProperty *, const QStringList &)),
@@ -1259,6 +2069,148 @@ QtVariantPropertyManager::~QtVariantPropertyManager()
     delete d_ptr;
 }
 
+/*!
+    \typedef QtVariantPropertyManager::ValueFunction
+
+    A function returning the value of a \a property of a typed \a manager
+    as a QVariant. Used by registerPropertyType().
+*/
+
+/*!
+    \typedef QtVariantPropertyManager::SetValueFunction
+
+    A function setting the value of a \a property of a typed \a manager
+    from a QVariant. Used by registerPropertyType().
+*/
+
+/*!
+    \typedef QtVariantPropertyManager::AttributeValueFunction
+
+    A function returning the value of the attribute with the given
+    \a attributeId of a \a property of a typed \a manager. Used by
+    registerPropertyType().
+*/
+
+/*!
+    \typedef QtVariantPropertyManager::SetAttributeFunction
+
+    A function setting the value of the attribute with the given
+    \a attributeId of a \a property of a typed \a manager. Used by
+    registerPropertyType().
+*/
+
+// Returns the signal of manager called name whose first parameter is of
+// firstParameterType, or an invalid method if there is none.
+static QMetaMethod propertySignal(const QtAbstractPropertyManager *manager, const char *name,
+            const char *firstParameterType, int parameterCount)
+{
+    const QMetaObject *metaObject = manager->metaObject();
+    for (int i = 0; i < metaObject->methodCount(); i++) {
+        const QMetaMethod method = metaObject->method(i);
+        if (method.methodType() == QMetaMethod::Signal && method.name() == name
+                    && method.parameterCount() == parameterCount
+                    && method.parameterTypes().first() == firstParameterType)
+            return method;
+    }
+    return QMetaMethod();
+}
+
+/*!
+    Adds support for the given \a propertyType, whose values are of the
+    given \a valueType and whose properties are created by the typed
+    \a manager. This manager takes ownership of \a manager.
+
+    Properties of the type read and write their value through \a value
+    and \a setValue. The attributes of the type and their types are
+    given by \a attributeTypes; their values are read and written
+    through \a attributeValue and \a setAttribute, which are passed the
+    ids returned by attributeId().
+
+    A registered type is dispatched like the built-in types, so unlike
+    reimplementing isPropertyTypeSupported(), value(), setValue() and
+    the other virtual functions, it does not add to the cost of
+    accessing properties of other types.
+
+    \a manager must have a \c{valueChanged(QtProperty *, Value)}
+    signal, like the built-in typed managers; otherwise the type is not
+    registered. valueChanged() is emitted whenever \a manager emits
+    that signal for one of its properties, but not for its
+    propertyChanged() signal, which is also emitted for attribute
+    changes. If \a manager has a \c{valuesChanged(QList<QtProperty *>)}
+    signal, valueChanged() is emitted for each property it reports.
+
+    Types must be registered before properties of them are added. An
+    already supported \a propertyType is not replaced.
+
+    \sa QtVariantEditorFactory::registerEditorFactory(), attributeId()
+*/
+void QtVariantPropertyManager::registerPropertyType(int propertyType, int valueType,
+            QtAbstractPropertyManager *manager, ValueFunction value, SetValueFunction setValue,
+            const QMap<QString, int> &attributeTypes, AttributeValueFunction attributeValue,
+            SetAttributeFunction setAttribute)
+{
+    if (!manager || !value || !setValue || d_ptr->m_typeToValueType.contains(propertyType))
+        return;
+
+    // Only the typed value signals are followed; propertyChanged() is
+    // emitted for attribute changes as well.
+    const QMetaMethod valueChangedSignal = propertySignal(manager, "valueChanged", "QtProperty*", 2);
+    if (!valueChangedSignal.isValid())
+        return;
+    const QMetaMethod valuesChangedSignal = propertySignal(manager, "valuesChanged", "QList<QtProperty*>", 1);
+
+    manager->setParent(this);
+    d_ptr->m_typeToPropertyManager[propertyType] = manager;
+    d_ptr->m_typeToValueType[propertyType] = valueType;
+
+    QtVariantPropertyAccessor accessor;
+    accessor.value = value;
+    accessor.setValue = setValue;
+    accessor.read = 0;
+    accessor.write = 0;
+    accessor.setValues = 0;
+    accessor.attributeValue = attributeValue;
+    accessor.setAttribute = setAttribute;
+    d_ptr->m_typeToAccessor[propertyType] = accessor;
+
+    QMapIterator<QString, int> itAttribute(attributeTypes);
+    while (itAttribute.hasNext()) {
+        itAttribute.next();
+        d_ptr->addAttribute(propertyType, attributeId(itAttribute.key()), itAttribute.value());
+    }
+
+    const QMetaObject *metaObject = &QtVariantPropertyManager::staticMetaObject;
+    connect(manager, valueChangedSignal,
+                this, metaObject->method(metaObject->indexOfSlot("slotTypedValueChanged(QtProperty*)")));
+    if (valuesChangedSignal.isValid()) {
+        connect(manager, valuesChangedSignal,
+                    this, metaObject->method(metaObject->indexOfSlot("slotValuesChanged(QList<QtProperty*>)")));
+    }
+    connect(manager, SIGNAL(propertyInserted(QtProperty *, QtProperty *, QtProperty *)),
+                this, SLOT(slotPropertyInserted(QtProperty *, QtProperty *, QtProperty *)));
+    connect(manager, SIGNAL(propertyRemoved(QtProperty *, QtProperty *)),
+                this, SLOT(slotPropertyRemoved(QtProperty *, QtProperty *)));
+}
+
+/*!
+    \fn void QtVariantPropertyManager::registerPropertyType(int propertyType,
+                PropertyManager *manager, const QMap<QString, int> &attributeTypes,
+                AttributeValueFunction attributeValue, SetAttributeFunction setAttribute)
+
+    \overload
+
+    Adds support for the given \a propertyType, whose properties are
+    created by the typed \a manager of type \c PropertyManager. The
+    value type is \c Value, which must be known to QMetaType; the value
+    is read and written through \c PropertyManager::value() and
+    \c PropertyManager::setValue().
+
+    \code
+        variantManager->registerPropertyType<MyPropertyManager, MyValue>(
+                    qMetaTypeId<MyPropertyType>(), new MyPropertyManager);
+    \endcode
+*/
+
 /*!
     Returns the given \a property converted into a QtVariantProperty.
 
@@ -1269,10 +2221,8 @@ QtVariantPropertyManager::~QtVariantPropertyManager()
 */
 QtVariantProperty *QtVariantPropertyManager::variantProperty(const QtProperty *property) const
 {
-    const QMap<const QtProperty *, QPair<QtVariantProperty *, int> >::const_iterator it = d_ptr->m_propertyToType.constFind(property);
-    if (it == d_ptr->m_propertyToType.constEnd())
-        return 0;
-    return it.value().first;
+    const QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.value(property, 0);
+    return data ? data->q_ptr : 0;
 }
 
 /*!
@@ -1372,6 +2322,39 @@ void QtVariantPropertyManager::setProperties(QSet<QtProperty *> properties)
     }
 }
 
+/*!
+    Returns true if properties of simple value types are created thin;
+    otherwise false.
+
+    \sa setThinPropertiesEnabled()
+*/
+bool QtVariantPropertyManager::thinPropertiesEnabled() const
+{
+    return d_ptr->m_thinPropertiesEnabled;
+}
+
+/*!
+    Sets whether the \c bool, \c int, \c double and QString properties
+    added from now on are created thin, to \a enabled. The default is
+    false.
+
+    A thin property keeps its value in this manager instead of in an
+    internal property of a typed manager, which saves an object and the
+    forwarding of its signals per property. Its attributes have the
+    typed managers' default values. The internal property is created
+    when it is first needed, i.e. when one of its attributes is set to a
+    value other than the default. QtVariantEditorFactory edits a thin
+    property with the editors of its typed factories, which read and
+    write it through this manager without creating the internal
+    property.
+
+    \sa thinPropertiesEnabled(), addProperty()
+*/
+void QtVariantPropertyManager::setThinPropertiesEnabled(bool enabled)
+{
+    d_ptr->m_thinPropertiesEnabled = enabled;
+}
+
 /*!
     Returns the given \a property's value.
 
@@ -1382,60 +2365,14 @@ void QtVariantPropertyManager::setProperties(QSet<QtProperty *> properties)
 */
 QVariant QtVariantPropertyManager::value(const QtProperty *property) const
 {
-    QtProperty *internProp = propertyToWrappedProperty()->value(property, 0);
-    if (internProp == 0)
+    const QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.value(property, 0);
+    if (!data)
         return QVariant();
-
-    QtAbstractPropertyManager *manager = internProp->propertyManager();
-    if (QtIntPropertyManager *intManager = qobject_cast<QtIntPropertyManager *>(manager)) {
-        return intManager->value(internProp);
-    } else if (QtDoublePropertyManager *doubleManager = qobject_cast<QtDoublePropertyManager *>(manager)) {
-        return doubleManager->value(internProp);
-    } else if (QtBoolPropertyManager *boolManager = qobject_cast<QtBoolPropertyManager *>(manager)) {
-        return boolManager->value(internProp);
-    } else if (QtStringPropertyManager *stringManager = qobject_cast<QtStringPropertyManager *>(manager)) {
-        return stringManager->value(internProp);
-    } else if (QtDatePropertyManager *dateManager = qobject_cast<QtDatePropertyManager *>(manager)) {
-        return dateManager->value(internProp);
-    } else if (QtTimePropertyManager *timeManager = qobject_cast<QtTimePropertyManager *>(manager)) {
-        return timeManager->value(internProp);
-    } else if (QtDateTimePropertyManager *dateTimeManager = qobject_cast<QtDateTimePropertyManager *>(manager)) {
-        return dateTimeManager->value(internProp);
-    } else if (QtKeySequencePropertyManager *keySequenceManager = qobject_cast<QtKeySequencePropertyManager *>(manager)) {
-        return keySequenceManager->value(internProp);
-    } else if (QtCharPropertyManager *charManager = qobject_cast<QtCharPropertyManager *>(manager)) {
-        return charManager->value(internProp);
-    } else if (QtLocalePropertyManager *localeManager = qobject_cast<QtLocalePropertyManager *>(manager)) {
-        return localeManager->value(internProp);
-    } else if (QtPointPropertyManager *pointManager = qobject_cast<QtPointPropertyManager *>(manager)) {
-        return pointManager->value(internProp);
-    } else if (QtPointFPropertyManager *pointFManager = qobject_cast<QtPointFPropertyManager *>(manager)) {
-        return pointFManager->value(internProp);
-    } else if (QtSizePropertyManager *sizeManager = qobject_cast<QtSizePropertyManager *>(manager)) {
-        return sizeManager->value(internProp);
-    } else if (QtSizeFPropertyManager *sizeFManager = qobject_cast<QtSizeFPropertyManager *>(manager)) {
-        return sizeFManager->value(internProp);
-    } else if (QtRectPropertyManager *rectManager = qobject_cast<QtRectPropertyManager *>(manager)) {
-        return rectManager->value(internProp);
-    } else if (QtRectFPropertyManager *rectFManager = qobject_cast<QtRectFPropertyManager *>(manager)) {
-        return rectFManager->value(internProp);
-    } else if (QtColorPropertyManager *colorManager = qobject_cast<QtColorPropertyManager *>(manager)) {
-        return colorManager->value(internProp);
-    } else if (QtEnumPropertyManager *enumManager = qobject_cast<QtEnumPropertyManager *>(manager)) {
-        return enumManager->value(internProp);
-    } else if (QtSizePolicyPropertyManager *sizePolicyManager =
-               qobject_cast<QtSizePolicyPropertyManager *>(manager)) {
-        return sizePolicyManager->value(internProp);
-    } else if (QtFontPropertyManager *fontManager = qobject_cast<QtFontPropertyManager *>(manager)) {
-        return fontManager->value(internProp);
-#ifndef QT_NO_CURSOR
-    } else if (QtCursorPropertyManager *cursorManager = qobject_cast<QtCursorPropertyManager *>(manager)) {
-        return cursorManager->value(internProp);
-#endif
-    } else if (QtFlagPropertyManager *flagManager = qobject_cast<QtFlagPropertyManager *>(manager)) {
-        return flagManager->value(internProp);
-    }
-    return QVariant();
+    if (data->thin)
+        return data->thinValue;
+    if (!data->accessor)
+        return QVariant();
+    return data->accessor->value(data->wrappedManager, data->wrappedProperty);
 }
 
 /*!
@@ -1468,10 +2405,8 @@ int QtVariantPropertyManager::valueType(int propertyType) const
 */
 int QtVariantPropertyManager::propertyType(const QtProperty *property) const
 {
-    const QMap<const QtProperty *, QPair<QtVariantProperty *, int> >::const_iterator it = d_ptr->m_propertyToType.constFind(property);
-    if (it == d_ptr->m_propertyToType.constEnd())
-        return 0;
-    return it.value().second;
+    const QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.value(property, 0);
+    return data ? data->propertyType : 0;
 }
 
 /*!
@@ -1486,96 +2421,53 @@ int QtVariantPropertyManager::propertyType(const QtProperty *property) const
 */
 QVariant QtVariantPropertyManager::attributeValue(const QtProperty *property, const QString &attribute) const
 {
-    int propType = propertyType(property);
-    if (!propType)
-        return QVariant();
+    return attributeValue(property, variantAttributeRegistry()->find(attribute));
+}
 
-    QMap<int, QMap<QString, int> >::ConstIterator it =
-            d_ptr->m_typeToAttributeToAttributeType.find(propType);
-    if (it == d_ptr->m_typeToAttributeToAttributeType.constEnd())
-        return QVariant();
+/*!
+    \overload
 
-    QMap<QString, int> attributes = it.value();
-    QMap<QString, int>::ConstIterator itAttr = attributes.find(attribute);
-    if (itAttr == attributes.constEnd())
-        return QVariant();
+    Returns the given \a property's value for the attribute with the
+    given \a attributeId, as returned by attributeId().
 
-    QtProperty *internProp = propertyToWrappedProperty()->value(property, 0);
-    if (internProp == 0)
-        return QVariant();
+    This avoids comparing attribute names. Unlike the overload taking
+    the attribute name, this function is not virtual; it only knows
+    the attributes of the built-in property types.
+*/
+QVariant QtVariantPropertyManager::attributeValue(const QtProperty *property, int attributeId) const
+{
+    const QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.value(property, 0);
+    if (data && data->thin)
+        return d_ptr->defaultAttributeValue(data->propertyType, attributeId);
 
-    QtAbstractPropertyManager *manager = internProp->propertyManager();
-    if (QtIntPropertyManager *intManager = qobject_cast<QtIntPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_maximumAttribute)
-            return intManager->maximum(internProp);
-        if (attribute == d_ptr->m_minimumAttribute)
-            return intManager->minimum(internProp);
-        if (attribute == d_ptr->m_singleStepAttribute)
-            return intManager->singleStep(internProp);
-        return QVariant();
-    } else if (QtDoublePropertyManager *doubleManager = qobject_cast<QtDoublePropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_maximumAttribute)
-            return doubleManager->maximum(internProp);
-        if (attribute == d_ptr->m_minimumAttribute)
-            return doubleManager->minimum(internProp);
-        if (attribute == d_ptr->m_singleStepAttribute)
-            return doubleManager->singleStep(internProp);
-        if (attribute == d_ptr->m_decimalsAttribute)
-            return doubleManager->decimals(internProp);
-        return QVariant();
-    } else if (QtStringPropertyManager *stringManager = qobject_cast<QtStringPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_regExpAttribute)
-            return stringManager->regExp(internProp);
-        return QVariant();
-    } else if (QtDatePropertyManager *dateManager = qobject_cast<QtDatePropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_maximumAttribute)
-            return dateManager->maximum(internProp);
-        if (attribute == d_ptr->m_minimumAttribute)
-            return dateManager->minimum(internProp);
-        return QVariant();
-    } else if (QtPointFPropertyManager *pointFManager = qobject_cast<QtPointFPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_decimalsAttribute)
-            return pointFManager->decimals(internProp);
-        return QVariant();
-    } else if (QtSizePropertyManager *sizeManager = qobject_cast<QtSizePropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_maximumAttribute)
-            return sizeManager->maximum(internProp);
-        if (attribute == d_ptr->m_minimumAttribute)
-            return sizeManager->minimum(internProp);
+    const QtVariantPropertyPrivate *internal = d_ptr->materializedProperty(property);
+    if (!internal || !internal->accessor->attributeValue)
         return QVariant();
-    } else if (QtSizeFPropertyManager *sizeFManager = qobject_cast<QtSizeFPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_maximumAttribute)
-            return sizeFManager->maximum(internProp);
-        if (attribute == d_ptr->m_minimumAttribute)
-            return sizeFManager->minimum(internProp);
-        if (attribute == d_ptr->m_decimalsAttribute)
-            return sizeFManager->decimals(internProp);
-        return QVariant();
-    } else if (QtRectPropertyManager *rectManager = qobject_cast<QtRectPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_constraintAttribute)
-            return rectManager->constraint(internProp);
-        return QVariant();
-    } else if (QtRectFPropertyManager *rectFManager = qobject_cast<QtRectFPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_constraintAttribute)
-            return rectFManager->constraint(internProp);
-        if (attribute == d_ptr->m_decimalsAttribute)
-            return rectFManager->decimals(internProp);
-        return QVariant();
-    } else if (QtEnumPropertyManager *enumManager = qobject_cast<QtEnumPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_enumNamesAttribute)
-            return enumManager->enumNames(internProp);
-        if (attribute == d_ptr->m_enumIconsAttribute) {
-            QVariant v;
-            qVariantSetValue(v, enumManager->enumIcons(internProp));
-            return v;
-        }
-        return QVariant();
-    } else if (QtFlagPropertyManager *flagManager = qobject_cast<QtFlagPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_flagNamesAttribute)
-            return flagManager->flagNames(internProp);
-        return QVariant();
-    }
-    return QVariant();
+    return internal->accessor->attributeValue(internal->wrappedManager, internal->wrappedProperty, attributeId);
+}
+
+/*!
+    Returns the id of the given \a attribute name, registering the name
+    if it is not known yet. Ids are stable for the lifetime of the
+    application and can be passed to the attributeValue() and
+    setAttribute() overloads taking an id.
+
+    \sa attributeName()
+*/
+int QtVariantPropertyManager::attributeId(const QString &attribute)
+{
+    return variantAttributeRegistry()->insert(attribute);
+}
+
+/*!
+    Returns the name of the attribute with the given \a attributeId, or
+    an empty string if the id is unknown.
+
+    \sa attributeId()
+*/
+QString QtVariantPropertyManager::attributeName(int attributeId)
+{
+    return variantAttributeRegistry()->name(attributeId);
 }
 
 /*!
@@ -1634,87 +2526,85 @@ void QtVariantPropertyManager::setValue(QtProperty *property, const QVariant &va
     if (!propType)
         return;
 
-    int valType = valueType(property);
+    QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.value(property, 0);
+    if (!data || (!data->thin && !data->accessor))
+        return;
+
+    int valType = data->valueType;
 
     if (propType != valType && !val.canConvert(static_cast<QVariant::Type>(valType)))
         return;
 
-    QtProperty *internProp = propertyToWrappedProperty()->value(property, 0);
-    if (internProp == 0)
+    if (data->thin) {
+        d_ptr->setThinValue(data, val);
         return;
+    }
 
+    data->accessor->setValue(data->wrappedManager, data->wrappedProperty, val);
+}
 
-    QtAbstractPropertyManager *manager = internProp->propertyManager();
-    if (QtIntPropertyManager *intManager = qobject_cast<QtIntPropertyManager *>(manager)) {
-        intManager->setValue(internProp, val.value<int>());
-        return;
-    } else if (QtDoublePropertyManager *doubleManager = qobject_cast<QtDoublePropertyManager *>(manager)) {
-        doubleManager->setValue(internProp, val.value<double>());
-        return;
-    } else if (QtBoolPropertyManager *boolManager = qobject_cast<QtBoolPropertyManager *>(manager)) {
-        boolManager->setValue(internProp, val.value<bool>());
-        return;
-    } else if (QtStringPropertyManager *stringManager = qobject_cast<QtStringPropertyManager *>(manager)) {
-        stringManager->setValue(internProp, val.value<QString>());
-        return;
-    } else if (QtDatePropertyManager *dateManager = qobject_cast<QtDatePropertyManager *>(manager)) {
-        dateManager->setValue(internProp, val.value<QDate>());
-        return;
-    } else if (QtTimePropertyManager *timeManager = qobject_cast<QtTimePropertyManager *>(manager)) {
-        timeManager->setValue(internProp, val.value<QTime>());
-        return;
-    } else if (QtDateTimePropertyManager *dateTimeManager = qobject_cast<QtDateTimePropertyManager *>(manager)) {
-        dateTimeManager->setValue(internProp, val.value<QDateTime>());
-        return;
-    } else if (QtKeySequencePropertyManager *keySequenceManager = qobject_cast<QtKeySequencePropertyManager *>(manager)) {
-        keySequenceManager->setValue(internProp, val.value<QKeySequence>());
-        return;
-    } else if (QtCharPropertyManager *charManager = qobject_cast<QtCharPropertyManager *>(manager)) {
-        charManager->setValue(internProp, val.value<QChar>());
-        return;
-    } else if (QtLocalePropertyManager *localeManager = qobject_cast<QtLocalePropertyManager *>(manager)) {
-        localeManager->setValue(internProp, val.value<QLocale>());
-        return;
-    } else if (QtPointPropertyManager *pointManager = qobject_cast<QtPointPropertyManager *>(manager)) {
-        pointManager->setValue(internProp, val.value<QPoint>());
-        return;
-    } else if (QtPointFPropertyManager *pointFManager = qobject_cast<QtPointFPropertyManager *>(manager)) {
-        pointFManager->setValue(internProp, val.value<QPointF>());
-        return;
-    } else if (QtSizePropertyManager *sizeManager = qobject_cast<QtSizePropertyManager *>(manager)) {
-        sizeManager->setValue(internProp, val.value<QSize>());
-        return;
-    } else if (QtSizeFPropertyManager *sizeFManager = qobject_cast<QtSizeFPropertyManager *>(manager)) {
-        sizeFManager->setValue(internProp, val.value<QSizeF>());
-        return;
-    } else if (QtRectPropertyManager *rectManager = qobject_cast<QtRectPropertyManager *>(manager)) {
-        rectManager->setValue(internProp, val.value<QRect>());
-        return;
-    } else if (QtRectFPropertyManager *rectFManager = qobject_cast<QtRectFPropertyManager *>(manager)) {
-        rectFManager->setValue(internProp, val.value<QRectF>());
-        return;
-    } else if (QtColorPropertyManager *colorManager = qobject_cast<QtColorPropertyManager *>(manager)) {
-        colorManager->setValue(internProp, val.value<QColor>());
-        return;
-    } else if (QtEnumPropertyManager *enumManager = qobject_cast<QtEnumPropertyManager *>(manager)) {
-        enumManager->setValue(internProp, val.value<int>());
-        return;
-    } else if (QtSizePolicyPropertyManager *sizePolicyManager =
-               qobject_cast<QtSizePolicyPropertyManager *>(manager)) {
-        sizePolicyManager->setValue(internProp, val.value<QSizePolicy>());
-        return;
-    } else if (QtFontPropertyManager *fontManager = qobject_cast<QtFontPropertyManager *>(manager)) {
-        fontManager->setValue(internProp, val.value<QFont>());
-        return;
-#ifndef QT_NO_CURSOR
-    } else if (QtCursorPropertyManager *cursorManager = qobject_cast<QtCursorPropertyManager *>(manager)) {
-        cursorManager->setValue(internProp, val.value<QCursor>());
-        return;
-#endif
-    } else if (QtFlagPropertyManager *flagManager = qobject_cast<QtFlagPropertyManager *>(manager)) {
-        flagManager->setValue(internProp, val.value<int>());
-        return;
+// The values setValues() passes to one internal manager at once
+struct QtVariantValueBatch
+{
+    const QtVariantPropertyAccessor *accessor;
+    QList<QtProperty *> properties;
+    QList<QVariant> values;
+};
+
+/*!
+    Sets the values of the properties in \a values, which maps each
+    property to its new value.
+
+    Values are checked like in setValue(). Properties of the same
+    internal manager are applied together where that manager supports
+    it, e.g. QtIntPropertyManager::setValues(). The properties whose
+    value changed, including subproperties, are reported with a single
+    valuesChanged() and propertiesChanged() signal instead of
+    valueChanged() and propertyChanged() for each of them.
+
+    \sa setValue(), valuesChanged()
+*/
+void QtVariantPropertyManager::setValues(const QHash<QtProperty *, QVariant> &values)
+{
+    QHash<QtAbstractPropertyManager *, QtVariantValueBatch> batches;
+
+    QList<QtProperty *> changedProperties;
+    QList<QtProperty *> *wasChangedProperties = d_ptr->m_changedProperties;
+    d_ptr->m_changedProperties = &changedProperties;
+
+    const QHash<QtProperty *, QVariant>::ConstIterator vcend = values.constEnd();
+    for (QHash<QtProperty *, QVariant>::ConstIterator it = values.constBegin(); it != vcend; ++it) {
+        const QVariant &val = it.value();
+        const int propType = val.userType();
+        if (!propType)
+            continue;
+
+        QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.value(it.key(), 0);
+        if (!data || (!data->thin && !data->accessor))
+            continue;
+
+        const int valType = data->valueType;
+        if (propType != valType && !val.canConvert(static_cast<QVariant::Type>(valType)))
+            continue;
+
+        if (data->thin) {
+            d_ptr->setThinValue(data, val);
+        } else if (data->accessor->setValues) {
+            QtVariantValueBatch &batch = batches[data->wrappedManager];
+            batch.accessor = data->accessor;
+            batch.properties.append(data->wrappedProperty);
+            batch.values.append(val);
+        } else {
+            data->accessor->setValue(data->wrappedManager, data->wrappedProperty, val);
+        }
     }
+
+    const QHash<QtAbstractPropertyManager *, QtVariantValueBatch>::ConstIterator bcend = batches.constEnd();
+    for (QHash<QtAbstractPropertyManager *, QtVariantValueBatch>::ConstIterator it = batches.constBegin(); it != bcend; ++it)
+        it.value().accessor->setValues(it.key(), it.value().properties, it.value().values);
+
+    d_ptr->m_changedProperties = wasChangedProperties;
+    d_ptr->reportChangedProperties(changedProperties);
 }
 
 /*!
@@ -1731,90 +2621,50 @@ void QtVariantPropertyManager::setValue(QtProperty *property, const QVariant &va
 void QtVariantPropertyManager::setAttribute(QtProperty *property,
         const QString &attribute, const QVariant &value)
 {
-    QVariant oldAttr = attributeValue(property, attribute);
-    if (!oldAttr.isValid())
-        return;
+    setAttribute(property, variantAttributeRegistry()->find(attribute), value);
+}
 
-    int attrType = value.userType();
-    if (!attrType)
-        return;
+/*!
+    \overload
 
-    if (attrType != attributeType(propertyType(property), attribute) &&
-                !value.canConvert((QVariant::Type)attrType))
-        return;
+    Sets the value of the attribute with the given \a attributeId, as
+    returned by attributeId(), of the given \a property to \a value.
 
-    QtProperty *internProp = propertyToWrappedProperty()->value(property, 0);
-    if (internProp == 0)
+    This avoids comparing attribute names. Unlike the overload taking
+    the attribute name, this function is not virtual; it only knows
+    the attributes of the built-in property types.
+*/
+void QtVariantPropertyManager::setAttribute(QtProperty *property, int attributeId, const QVariant &value)
+{
+    if (!d_ptr->hasAttribute(propertyType(property), attributeId))
         return;
 
-    QtAbstractPropertyManager *manager = internProp->propertyManager();
-    if (QtIntPropertyManager *intManager = qobject_cast<QtIntPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_maximumAttribute)
-            intManager->setMaximum(internProp, value.value<int>());
-        else if (attribute == d_ptr->m_minimumAttribute)
-            intManager->setMinimum(internProp, value.value<int>());
-        else if (attribute == d_ptr->m_singleStepAttribute)
-            intManager->setSingleStep(internProp, value.value<int>());
-        return;
-    } else if (QtDoublePropertyManager *doubleManager = qobject_cast<QtDoublePropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_maximumAttribute)
-            doubleManager->setMaximum(internProp, value.value<double>());
-        if (attribute == d_ptr->m_minimumAttribute)
-            doubleManager->setMinimum(internProp, value.value<double>());
-        if (attribute == d_ptr->m_singleStepAttribute)
-            doubleManager->setSingleStep(internProp, value.value<double>());
-        if (attribute == d_ptr->m_decimalsAttribute)
-            doubleManager->setDecimals(internProp, value.value<int>());
-        return;
-    } else if (QtStringPropertyManager *stringManager = qobject_cast<QtStringPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_regExpAttribute)
-            stringManager->setRegExp(internProp, value.value<QRegExp>());
-        return;
-    } else if (QtDatePropertyManager *dateManager = qobject_cast<QtDatePropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_maximumAttribute)
-            dateManager->setMaximum(internProp, value.value<QDate>());
-        if (attribute == d_ptr->m_minimumAttribute)
-            dateManager->setMinimum(internProp, value.value<QDate>());
-        return;
-    } else if (QtPointFPropertyManager *pointFManager = qobject_cast<QtPointFPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_decimalsAttribute)
-            pointFManager->setDecimals(internProp, value.value<int>());
-        return;
-    } else if (QtSizePropertyManager *sizeManager = qobject_cast<QtSizePropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_maximumAttribute)
-            sizeManager->setMaximum(internProp, value.value<QSize>());
-        if (attribute == d_ptr->m_minimumAttribute)
-            sizeManager->setMinimum(internProp, value.value<QSize>());
-        return;
-    } else if (QtSizeFPropertyManager *sizeFManager = qobject_cast<QtSizeFPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_maximumAttribute)
-            sizeFManager->setMaximum(internProp, value.value<QSizeF>());
-        if (attribute == d_ptr->m_minimumAttribute)
-            sizeFManager->setMinimum(internProp, value.value<QSizeF>());
-        if (attribute == d_ptr->m_decimalsAttribute)
-            sizeFManager->setDecimals(internProp, value.value<int>());
-        return;
-    } else if (QtRectPropertyManager *rectManager = qobject_cast<QtRectPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_constraintAttribute)
-            rectManager->setConstraint(internProp, value.value<QRect>());
+    const QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.value(property, 0);
+    if (data && data->thin) {
+        // Setting an attribute to its default keeps the property thin
+        const QVariant defaultValue = d_ptr->defaultAttributeValue(data->propertyType, attributeId);
+        QVariant newValue = value;
+        if (newValue.convert(defaultValue.userType()) && newValue == defaultValue)
+            return;
+    }
+
+    const QtVariantPropertyPrivate *internal = d_ptr->materializedProperty(property);
+    if (!internal || !internal->accessor->setAttribute || !internal->attributeTypes)
         return;
-    } else if (QtRectFPropertyManager *rectFManager = qobject_cast<QtRectFPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_constraintAttribute)
-            rectFManager->setConstraint(internProp, value.value<QRectF>());
-        if (attribute == d_ptr->m_decimalsAttribute)
-            rectFManager->setDecimals(internProp, value.value<int>());
+
+    const int registeredType = internal->attributeTypes->value(attributeId, 0);
+    if (!registeredType)
         return;
-    } else if (QtEnumPropertyManager *enumManager = qobject_cast<QtEnumPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_enumNamesAttribute)
-            enumManager->setEnumNames(internProp, value.value<QStringList>());
-        if (attribute == d_ptr->m_enumIconsAttribute)
-            enumManager->setEnumIcons(internProp, value.value<QtIconMap>());
+
+    int attrType = value.userType();
+    if (!attrType)
         return;
-    } else if (QtFlagPropertyManager *flagManager = qobject_cast<QtFlagPropertyManager *>(manager)) {
-        if (attribute == d_ptr->m_flagNamesAttribute)
-            flagManager->setFlagNames(internProp, value.value<QStringList>());
+
+    if (attrType != registeredType &&
+                !value.canConvert((QVariant::Type)attrType))
         return;
-    }
+
+    internal->accessor->setAttribute(internal->wrappedManager, internal->wrappedProperty, attributeId, value);
 }
 
 /*!
@@ -1832,8 +2682,13 @@ bool QtVariantPropertyManager::hasValue(const QtProperty *property) const
 */
 QString QtVariantPropertyManager::valueText(const QtProperty *property) const
 {
-    const QtProperty *internProp = propertyToWrappedProperty()->value(property, 0);
-    return internProp ? internProp->valueText() : QString();
+    const QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.value(property, 0);
+    if (data && data->thin) {
+        const int decimals = data->valueType == QVariant::Double
+                ? d_ptr->defaultAttributeValue(data->propertyType, DecimalsAttribute).toInt() : 0;
+        return thinValueText(data->thinValue, decimals);
+    }
+    return data && data->wrappedProperty ? data->wrappedProperty->valueText() : QString();
 }
 
 /*!
@@ -1841,8 +2696,31 @@ QString QtVariantPropertyManager::valueText(const QtProperty *property) const
 */
 QIcon QtVariantPropertyManager::valueIcon(const QtProperty *property) const
 {
-    const QtProperty *internProp = propertyToWrappedProperty()->value(property, 0);
-    return internProp ? internProp->valueIcon() : QIcon();
+    const QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.value(property, 0);
+    if (data && data->thin)
+        return thinValueIcon(data->thinValue);
+    return data && data->wrappedProperty ? data->wrappedProperty->valueIcon() : QIcon();
+}
+
+/*!
+    \reimp
+*/
+bool QtVariantPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
+{
+    const QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.value(property, 0);
+    if (!data || !data->wrappedProperty)
+        return false;
+    return data->wrappedProperty->propertyManager()->hasDeferredSubProperties(data->wrappedProperty);
+}
+
+/*!
+    \reimp
+*/
+void QtVariantPropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    const QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.value(property, 0);
+    if (data && data->wrappedProperty)
+        data->wrappedProperty->propertyManager()->createDeferredSubProperties(data->wrappedProperty);
 }
 
 /*!
@@ -1859,12 +2737,18 @@ void QtVariantPropertyManager::initializeProperty(QtProperty *property)
     if (it != d_ptr->m_typeToPropertyManager.constEnd()) {
         QtProperty *internProp = 0;
         if (!d_ptr->m_creatingSubProperties) {
+            if (d_ptr->m_thinPropertiesEnabled && isThinPropertyType(d_ptr->m_propertyType)) {
+                QtVariantPropertyPrivate *data = varProp->d_ptr;
+                data->thin = true;
+                data->valueType = d_ptr->m_typeToValueType.value(data->propertyType, 0);
+                data->thinValue = QVariant(static_cast<QVariant::Type>(data->valueType));
+                return;
+            }
             QtAbstractPropertyManager *manager = it.value();
             internProp = manager->addProperty();
-            d_ptr->m_internalToProperty[internProp] = varProp;
         }
-        propertyToWrappedProperty()->insert(varProp, internProp);
         if (internProp) {
+            d_ptr->setInternalProperty(varProp, internProp);
             QList<QtProperty *> children = internProp->subProperties();
             QListIterator<QtProperty *> itChild(children);
             QtVariantProperty *lastProperty = 0;
@@ -1881,22 +2765,19 @@ void QtVariantPropertyManager::initializeProperty(QtProperty *property)
 */
 void QtVariantPropertyManager::uninitializeProperty(QtProperty *property)
 {
-    const QMap<const QtProperty *, QPair<QtVariantProperty *, int> >::iterator type_it = d_ptr->m_propertyToType.find(property);
-    if (type_it == d_ptr->m_propertyToType.end())
+    QtVariantPropertyPrivate *data = d_ptr->m_propertyToData.take(property);
+    if (!data)
         return;
 
-    PropertyMap::iterator it = propertyToWrappedProperty()->find(property);
-    if (it != propertyToWrappedProperty()->end()) {
-        QtProperty *internProp = it.value();
-        if (internProp) {
-            d_ptr->m_internalToProperty.remove(internProp);
-            if (!d_ptr->m_destroyingSubProperties) {
-                delete internProp;
-            }
+    if (QtProperty *internProp = data->wrappedProperty) {
+        d_ptr->m_internalToProperty.remove(internProp);
+        if (!d_ptr->m_destroyingSubProperties) {
+            delete internProp;
         }
-        propertyToWrappedProperty()->erase(it);
     }
-    d_ptr->m_propertyToType.erase(type_it);
+    // The QtVariantProperty destructor has already run and left its
+    // private data to be released here.
+    delete data;
 }
 
 /*!
@@ -1908,7 +2789,8 @@ QtProperty *QtVariantPropertyManager::createProperty()
         return 0;
 
     QtVariantProperty *property = new QtVariantProperty(this);
-    d_ptr->m_propertyToType.insert(property, qMakePair(property, d_ptr->m_propertyType));
+    property->d_ptr->propertyType = d_ptr->m_propertyType;
+    d_ptr->m_propertyToData.insert(property, property->d_ptr);
 
     return property;
 }
@@ -1935,10 +2817,29 @@ public:
     QtColorEditorFactory       *m_colorEditorFactory;
     QtFontEditorFactory        *m_fontEditorFactory;
 
-    QMap<QtAbstractEditorFactoryBase *, int> m_factoryToType;
-    QMap<int, QtAbstractEditorFactoryBase *> m_typeToFactory;
+    QHash<QtAbstractEditorFactoryBase *, int> m_factoryToType;
+    QHash<int, QtAbstractEditorFactoryBase *> m_typeToFactory;
+
+    struct RegisteredFactory
+    {
+        QtAbstractEditorFactoryBase *factory;
+        QtVariantEditorFactory::ManagerFunction addPropertyManagers;
+        QtVariantEditorFactory::ManagerFunction removePropertyManagers;
+    };
+    QList<RegisteredFactory> m_registeredFactories;
+
+    void slotEditorDestroyed(QObject *object);
+
+    // The sub-factory that created each editor, so that released
+    // editors go back to it for reuse
+    QHash<QObject *, QtAbstractEditorFactoryBase *> m_editorToFactory;
 };
 
+void QtVariantEditorFactoryPrivate::slotEditorDestroyed(QObject *object)
+{
+    m_editorToFactory.remove(object);
+}
+
 /*!
     \class QtVariantEditorFactory
 
@@ -2067,6 +2968,43 @@ QtVariantEditorFactory::~QtVariantEditorFactory()
     delete d_ptr;
 }
 
+/*!
+    \fn void QtVariantEditorFactory::registerEditorFactory(int propertyType,
+                QtAbstractEditorFactory<PropertyManager> *factory)
+
+    Makes this factory create the editors of properties of the given
+    \a propertyType with \a factory, which is connected to the
+    \c PropertyManager direct children of every variant manager this
+    factory is connected to, i.e. to the managers registered with
+    QtVariantPropertyManager::registerPropertyType() but not to the
+    managers of their subproperties. This factory takes ownership of \a factory.
+
+    Use it together with QtVariantPropertyManager::registerPropertyType()
+    to provide editors for custom property types. An already supported
+    \a propertyType is not replaced.
+*/
+
+void QtVariantEditorFactory::registerEditorFactory(int propertyType, QtAbstractEditorFactoryBase *factory,
+            ManagerFunction addPropertyManagers, ManagerFunction removePropertyManagers)
+{
+    if (!factory || d_ptr->m_typeToFactory.contains(propertyType))
+        return;
+
+    factory->setParent(this);
+    d_ptr->m_factoryToType[factory] = propertyType;
+    d_ptr->m_typeToFactory[propertyType] = factory;
+
+    QtVariantEditorFactoryPrivate::RegisteredFactory registered;
+    registered.factory = factory;
+    registered.addPropertyManagers = addPropertyManagers;
+    registered.removePropertyManagers = removePropertyManagers;
+    d_ptr->m_registeredFactories.append(registered);
+
+    QSetIterator<QtVariantPropertyManager *> itManager(propertyManagers());
+    while (itManager.hasNext())
+        addPropertyManagers(factory, itManager.next());
+}
+
 /*!
     \internal
 
@@ -2194,6 +3132,12 @@ void QtVariantEditorFactory::connectPropertyManager(QtVariantPropertyManager *ma
     QListIterator<QtFlagPropertyManager *> itFlag(flagPropertyManagers);
     while (itFlag.hasNext())
         d_ptr->m_checkBoxFactory->addPropertyManager(itFlag.next()->subBoolPropertyManager());
+
+    QListIterator<QtVariantEditorFactoryPrivate::RegisteredFactory> itRegistered(d_ptr->m_registeredFactories);
+    while (itRegistered.hasNext()) {
+        const QtVariantEditorFactoryPrivate::RegisteredFactory &registered = itRegistered.next();
+        registered.addPropertyManagers(registered.factory, manager);
+    }
 }
 
 /*!
@@ -2204,11 +3148,44 @@ void QtVariantEditorFactory::connectPropertyManager(QtVariantPropertyManager *ma
 QWidget *QtVariantEditorFactory::createEditor(QtVariantPropertyManager *manager, QtProperty *property,
         QWidget *parent)
 {
-    const int propType = manager->propertyType(property);
-    QtAbstractEditorFactoryBase *factory = d_ptr->m_typeToFactory.value(propType, 0);
+    // Resolve the variant property once; its type and wrapped property
+    // are then read directly from it.
+    const QtVariantProperty *varProp = manager->variantProperty(property);
+    if (!varProp)
+        return 0;
+    QtAbstractEditorFactoryBase *factory =
+            d_ptr->m_typeToFactory.value(QtVariantPropertyManagerPrivate::propertyType(varProp), 0);
     if (!factory)
         return 0;
-    return factory->createEditor(wrappedProperty(property), parent);
+    QWidget *editor = 0;
+    if (QtVariantPropertyManagerPrivate::isThin(varProp)) {
+        // The sub-factory edits the thin property through the manager
+        editor = factory->createAdaptedEditor(QtVariantPropertyManagerPrivate::editorAdapter(varProp),
+                    property, parent);
+    } else if (QtProperty *internal = QtVariantPropertyManagerPrivate::wrappedProperty(varProp)) {
+        editor = factory->createEditor(internal, parent);
+    }
+    if (editor) {
+        d_ptr->m_editorToFactory.insert(editor, factory);
+        connect(editor, SIGNAL(destroyed(QObject *)),
+                    this, SLOT(slotEditorDestroyed(QObject *)), Qt::UniqueConnection);
+    }
+    return editor;
+}
+
+/*!
+    \internal
+
+    Reimplemented from the QtAbstractEditorFactoryBase class. Hands the
+    released \a editor back to the factory that created it, which may
+    keep it for reuse.
+*/
+void QtVariantEditorFactory::releaseEditor(QWidget *editor)
+{
+    if (QtAbstractEditorFactoryBase *factory = d_ptr->m_editorToFactory.take(editor))
+        factory->releaseEditor(editor);
+    else
+        QtAbstractEditorFactoryBase::releaseEditor(editor);
 }
 
 /*!
@@ -2349,6 +3326,12 @@ void QtVariantEditorFactory::disconnectPropertyManager(QtVariantPropertyManager
     QListIterator<QtFlagPropertyManager *> itFlag(flagPropertyManagers);
     while (itFlag.hasNext())
         d_ptr->m_checkBoxFactory->removePropertyManager(itFlag.next()->subBoolPropertyManager());
+
+    QListIterator<QtVariantEditorFactoryPrivate::RegisteredFactory> itRegistered(d_ptr->m_registeredFactories);
+    while (itRegistered.hasNext()) {
+        const QtVariantEditorFactoryPrivate::RegisteredFactory &registered = itRegistered.next();
+        registered.removePropertyManagers(registered.factory, manager);
+    }
 }
 
 #if QT_VERSION >= 0x040400
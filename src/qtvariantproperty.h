@@ -43,6 +43,7 @@
 
 #include "qtpropertybrowser.h"
 #include <QtCore/QVariant>
+#include <QtCore/QHash>
 #include <QtGui/QIcon>
 
 #if QT_VERSION >= 0x040400
@@ -59,34 +60,78 @@ class QT_QTPROPERTYBROWSER_EXPORT QtVariantProperty : public QtProperty
 public:
     ~QtVariantProperty();
     QVariant value() const;
+    template <class T> T valueAs() const;
     QVariant attributeValue(const QString &attribute) const;
+    QVariant attributeValue(int attributeId) const;
     int valueType() const;
     int propertyType() const;
 
     virtual bool compare(QtProperty* otherProperty)const;
 
     void setValue(const QVariant &value);
+    template <class T> void setValueAs(const T &val);
     void setAttribute(const QString &attribute, const QVariant &value);
+    void setAttribute(int attributeId, const QVariant &value);
 protected:
     QtVariantProperty(QtVariantPropertyManager *manager);
 private:
+    bool readValue(int typeId, void *val) const;
+    bool writeValue(int typeId, const void *val);
+
     friend class QtVariantPropertyManager;
+    friend class QtVariantPropertyManagerPrivate;
     QtVariantPropertyPrivate *d_ptr;
 };
 
+template <class T>
+T QtVariantProperty::valueAs() const
+{
+    T val = T();
+    if (readValue(qMetaTypeId<T>(), &val))
+        return val;
+    return qvariant_cast<T>(value());
+}
+
+template <class T>
+void QtVariantProperty::setValueAs(const T &val)
+{
+    if (!writeValue(qMetaTypeId<T>(), &val))
+        setValue(QVariant::fromValue(val));
+}
+
 class QtVariantPropertyManagerPrivate;
 
 class QT_QTPROPERTYBROWSER_EXPORT QtVariantPropertyManager : public QtAbstractPropertyManager
 {
     Q_OBJECT
 public:
+    typedef QVariant (*ValueFunction)(QtAbstractPropertyManager *manager, const QtProperty *property);
+    typedef void (*SetValueFunction)(QtAbstractPropertyManager *manager, QtProperty *property,
+                const QVariant &value);
+    typedef QVariant (*AttributeValueFunction)(QtAbstractPropertyManager *manager,
+                const QtProperty *property, int attributeId);
+    typedef void (*SetAttributeFunction)(QtAbstractPropertyManager *manager, QtProperty *property,
+                int attributeId, const QVariant &value);
+
     QtVariantPropertyManager(QObject *parent = 0);
     ~QtVariantPropertyManager();
 
+    void registerPropertyType(int propertyType, int valueType, QtAbstractPropertyManager *manager,
+                ValueFunction value, SetValueFunction setValue,
+                const QMap<QString, int> &attributeTypes = QMap<QString, int>(),
+                AttributeValueFunction attributeValue = 0, SetAttributeFunction setAttribute = 0);
+    template <class PropertyManager, class Value>
+    void registerPropertyType(int propertyType, PropertyManager *manager,
+                const QMap<QString, int> &attributeTypes = QMap<QString, int>(),
+                AttributeValueFunction attributeValue = 0, SetAttributeFunction setAttribute = 0);
+
     virtual QtVariantProperty *addProperty(int propertyType, const QString &name = QString());
 
     void setProperties(QSet<QtProperty *> properties);
 
+    bool thinPropertiesEnabled() const;
+    void setThinPropertiesEnabled(bool enabled);
+
     int propertyType(const QtProperty *property) const;
     int valueType(const QtProperty *property) const;
     QtVariantProperty *variantProperty(const QtProperty *property) const;
@@ -98,6 +143,10 @@ public:
 
     virtual QVariant value(const QtProperty *property) const;
     virtual QVariant attributeValue(const QtProperty *property, const QString &attribute) const;
+    QVariant attributeValue(const QtProperty *property, int attributeId) const;
+
+    static int attributeId(const QString &attribute);
+    static QString attributeName(int attributeId);
 
     static int enumTypeId();
     static int flagTypeId();
@@ -105,31 +154,50 @@ public:
     static int iconMapTypeId();
 public Q_SLOTS:
     virtual void setValue(QtProperty *property, const QVariant &val);
+    void setValues(const QHash<QtProperty *, QVariant> &values);
     virtual void setAttribute(QtProperty *property,
                 const QString &attribute, const QVariant &value);
+    void setAttribute(QtProperty *property, int attributeId, const QVariant &value);
 Q_SIGNALS:
     void valueChanged(QtProperty *property, const QVariant &val);
+    void valuesChanged(const QList<QtProperty *> &properties);
     void attributeChanged(QtProperty *property,
                 const QString &attribute, const QVariant &val);
 protected:
     virtual bool hasValue(const QtProperty *property) const;
     QString valueText(const QtProperty *property) const;
     QIcon valueIcon(const QtProperty *property) const;
+    bool hasDeferredSubProperties(const QtProperty *property) const;
+    void createDeferredSubProperties(QtProperty *property);
     virtual void initializeProperty(QtProperty *property);
     virtual void uninitializeProperty(QtProperty *property);
     virtual QtProperty *createProperty();
 private:
+    template <class PropertyManager, class Value>
+    static QVariant typedValue(QtAbstractPropertyManager *manager, const QtProperty *property)
+    {
+        return QVariant::fromValue(static_cast<const PropertyManager *>(manager)->value(property));
+    }
+    template <class PropertyManager, class Value>
+    static void setTypedValue(QtAbstractPropertyManager *manager, QtProperty *property, const QVariant &value)
+    {
+        static_cast<PropertyManager *>(manager)->setValue(property, qvariant_cast<Value>(value));
+    }
+
     QtVariantPropertyManagerPrivate *d_ptr;
+    Q_PRIVATE_SLOT(d_func(), void slotTypedValueChanged(QtProperty *))
     Q_PRIVATE_SLOT(d_func(), void slotValueChanged(QtProperty *, int))
     Q_PRIVATE_SLOT(d_func(), void slotRangeChanged(QtProperty *, int, int))
     Q_PRIVATE_SLOT(d_func(), void slotSingleStepChanged(QtProperty *, int))
     Q_PRIVATE_SLOT(d_func(), void slotValueChanged(QtProperty *, double))
+    Q_PRIVATE_SLOT(d_func(), void slotValuesChanged(const QList<QtProperty *> &))
     Q_PRIVATE_SLOT(d_func(), void slotRangeChanged(QtProperty *, double, double))
     Q_PRIVATE_SLOT(d_func(), void slotSingleStepChanged(QtProperty *, double))
     Q_PRIVATE_SLOT(d_func(), void slotDecimalsChanged(QtProperty *, int))
     Q_PRIVATE_SLOT(d_func(), void slotValueChanged(QtProperty *, bool))
     Q_PRIVATE_SLOT(d_func(), void slotValueChanged(QtProperty *, const QString &))
     Q_PRIVATE_SLOT(d_func(), void slotRegExpChanged(QtProperty *, const QRegExp &))
+    Q_PRIVATE_SLOT(d_func(), void slotRegularExpressionChanged(QtProperty *, const QRegularExpression &))
     Q_PRIVATE_SLOT(d_func(), void slotValueChanged(QtProperty *, const QDate &))
     Q_PRIVATE_SLOT(d_func(), void slotRangeChanged(QtProperty *, const QDate &, const QDate &))
     Q_PRIVATE_SLOT(d_func(), void slotValueChanged(QtProperty *, const QTime &))
@@ -161,6 +229,17 @@ private:
     Q_DISABLE_COPY(QtVariantPropertyManager)
 };
 
+template <class PropertyManager, class Value>
+void QtVariantPropertyManager::registerPropertyType(int propertyType, PropertyManager *manager,
+            const QMap<QString, int> &attributeTypes, AttributeValueFunction attributeValue,
+            SetAttributeFunction setAttribute)
+{
+    registerPropertyType(propertyType, qMetaTypeId<Value>(), manager,
+                &QtVariantPropertyManager::typedValue<PropertyManager, Value>,
+                &QtVariantPropertyManager::setTypedValue<PropertyManager, Value>,
+                attributeTypes, attributeValue, setAttribute);
+}
+
 class QtVariantEditorFactoryPrivate;
 
 class QT_QTPROPERTYBROWSER_EXPORT QtVariantEditorFactory : public QtAbstractEditorFactory<QtVariantPropertyManager>
@@ -169,6 +248,11 @@ class QT_QTPROPERTYBROWSER_EXPORT QtVariantEditorFactory : public QtAbstractEdit
 public:
     QtVariantEditorFactory(QObject *parent = 0);
     ~QtVariantEditorFactory();
+
+    void releaseEditor(QWidget *editor);
+
+    template <class PropertyManager>
+    void registerEditorFactory(int propertyType, QtAbstractEditorFactory<PropertyManager> *factory);
 protected:
     void connectPropertyManager(QtVariantPropertyManager *manager);
     QWidget *createEditor(QtVariantPropertyManager *manager, QtProperty *property,
@@ -176,11 +260,42 @@ protected:
     QWidget *createEditor(QtProperty *property, QWidget *parent);
     void disconnectPropertyManager(QtVariantPropertyManager *manager);
 private:
+    typedef void (*ManagerFunction)(QtAbstractEditorFactoryBase *factory, QtVariantPropertyManager *manager);
+    void registerEditorFactory(int propertyType, QtAbstractEditorFactoryBase *factory,
+                ManagerFunction addPropertyManagers, ManagerFunction removePropertyManagers);
+
+    template <class PropertyManager>
+    static void addPropertyManagers(QtAbstractEditorFactoryBase *factory, QtVariantPropertyManager *manager)
+    {
+        QList<PropertyManager *> managers = manager->findChildren<PropertyManager *>(QString(), Qt::FindDirectChildrenOnly);
+        QListIterator<PropertyManager *> it(managers);
+        while (it.hasNext())
+            static_cast<QtAbstractEditorFactory<PropertyManager> *>(factory)->addPropertyManager(it.next());
+    }
+    template <class PropertyManager>
+    static void removePropertyManagers(QtAbstractEditorFactoryBase *factory, QtVariantPropertyManager *manager)
+    {
+        QList<PropertyManager *> managers = manager->findChildren<PropertyManager *>(QString(), Qt::FindDirectChildrenOnly);
+        QListIterator<PropertyManager *> it(managers);
+        while (it.hasNext())
+            static_cast<QtAbstractEditorFactory<PropertyManager> *>(factory)->removePropertyManager(it.next());
+    }
+
     QtVariantEditorFactoryPrivate *d_ptr;
     Q_DECLARE_PRIVATE(QtVariantEditorFactory)
+    Q_PRIVATE_SLOT(d_func(), void slotEditorDestroyed(QObject *))
     Q_DISABLE_COPY(QtVariantEditorFactory)
 };
 
+template <class PropertyManager>
+void QtVariantEditorFactory::registerEditorFactory(int propertyType,
+            QtAbstractEditorFactory<PropertyManager> *factory)
+{
+    registerEditorFactory(propertyType, factory,
+                &QtVariantEditorFactory::addPropertyManagers<PropertyManager>,
+                &QtVariantEditorFactory::removePropertyManagers<PropertyManager>);
+}
+
 #if QT_VERSION >= 0x040400
 QT_END_NAMESPACE
 #endif
@@ -0,0 +1,702 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+**
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of a Qt Solutions component.
+**
+** You may use this file under the terms of the BSD license as follows:
+**
+** "Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are
+** met:
+**   * Redistributions of source code must retain the above copyright
+**     notice, this list of conditions and the following disclaimer.
+**   * Redistributions in binary form must reproduce the above copyright
+**     notice, this list of conditions and the following disclaimer in
+**     the documentation and/or other materials provided with the
+**     distribution.
+**   * Neither the name of Nokia Corporation and its Subsidiary(-ies) nor
+**     the names of its contributors may be used to endorse or promote
+**     products derived from this software without specific prior written
+**     permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+** "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+** LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+** A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+** OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+** OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE."
+**
+****************************************************************************/
+
+
+#include "qtvirtualgroupboxpropertybrowser.h"
+#include <QtCore/QSet>
+#include <QtCore/QMap>
+#include <QtCore/QHash>
+#include <QtCore/QTimer>
+#include <QAbstractScrollArea>
+#include <QApplication>
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QScrollBar>
+#include <QStyle>
+#include <QStyleOptionGroupBox>
+
+#if QT_VERSION >= 0x040400
+QT_BEGIN_NAMESPACE
+#endif
+
+class QtVirtualGroupBoxView;
+
+class QtVirtualGroupBoxPropertyBrowserPrivate
+{
+    QtVirtualGroupBoxPropertyBrowser *q_ptr;
+    Q_DECLARE_PUBLIC(QtVirtualGroupBoxPropertyBrowser)
+public:
+    QtVirtualGroupBoxPropertyBrowserPrivate();
+    void init(QWidget *parent);
+
+    void propertyInserted(QtBrowserItem *index, QtBrowserItem *afterIndex);
+    void propertyRemoved(QtBrowserItem *index);
+    void propertyChanged(QtBrowserItem *index);
+    void propertiesChanged(const QList<QtBrowserItem *> &indexes);
+    QWidget *createEditor(QtProperty *property, QWidget *parent) const
+        { return q_ptr->createEditor(property, parent); }
+
+    void slotEditorDestroyed();
+    void slotUpdate();
+
+    void updateScrollBars();
+    void layoutRows();
+    void paintGroups(QPainter *painter, const QRect &clip);
+
+    enum RowType
+    {
+        PropertyRow,    // label and editor (or value label)
+        GroupTitleRow,  // group box title, painted
+        GroupEditorRow, // editor (or value label) of a property with children
+        GroupEndRow     // bottom margin of the group box, painted
+    };
+
+    struct Row
+    {
+        QtBrowserItem *index;
+        RowType type;
+        int depth;
+        int top;
+        int height;
+    };
+
+    struct Group
+    {
+        QtBrowserItem *index;
+        int depth;
+        int firstRow;
+        int lastRow;
+    };
+
+    struct WidgetItem
+    {
+        WidgetItem() : widget(0), label(0), widgetLabel(0) { }
+        QWidget *widget; // can be null
+        QLabel *label; // null for the editor row of a group
+        QLabel *widgetLabel; // label substitute showing the current value if there is no widget
+    };
+
+    QtVirtualGroupBoxView *m_view;
+    QMap<QtBrowserItem *, WidgetItem *> m_indexToItem;
+    QMap<QWidget *, QtBrowserItem *> m_widgetToIndex;
+private:
+    void updateLater();
+    void rebuildRows();
+    void appendRows(QtBrowserItem *index, int depth);
+    void appendRow(QtBrowserItem *index, RowType type, int depth, int height);
+    int rowHeight(QtBrowserItem *index) const;
+    void measureItem(QtBrowserItem *index, WidgetItem *item);
+    int rowAt(int y) const;
+    int left(int depth) const;
+    int right(int depth) const;
+    WidgetItem *realizeItem(QtBrowserItem *index, RowType type);
+    void releaseItem(QtBrowserItem *index);
+    void placeItem(WidgetItem *item, const Row &row);
+    QLabel *takeLabel();
+    void recycleLabel(QLabel *label);
+    void updateItem(QtBrowserItem *index, WidgetItem *item);
+    bool hasFocusWithin(QWidget *widget) const;
+
+    QList<Row> m_rows;
+    QList<Group> m_groups;
+    QHash<QtBrowserItem *, int> m_indexToRow;
+    // Measured height of the rows whose widgets have been created, and the
+    // last height measured per manager as estimate for the other rows.
+    QHash<QtBrowserItem *, int> m_indexToHeight;
+    QHash<QtAbstractPropertyManager *, int> m_managerToHeight;
+    QList<QLabel *> m_labelPool;
+    int m_contentsHeight;
+    int m_rowHeight;
+    int m_titleHeight;
+    int m_spacing;
+    int m_indentation;
+    bool m_rowsDirty;
+    bool m_updatePending;
+};
+
+// ------------ QtVirtualGroupBoxView
+class QtVirtualGroupBoxView : public QAbstractScrollArea
+{
+public:
+    QtVirtualGroupBoxView(QtVirtualGroupBoxPropertyBrowserPrivate *editorPrivate, QWidget *parent = 0)
+        : QAbstractScrollArea(parent), m_editorPrivate(editorPrivate)
+    {
+        setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        setFrameShape(QFrame::NoFrame);
+    }
+
+protected:
+    void paintEvent(QPaintEvent *event)
+    {
+        QPainter painter(viewport());
+        m_editorPrivate->paintGroups(&painter, event->rect());
+    }
+
+    void resizeEvent(QResizeEvent *event)
+    {
+        QAbstractScrollArea::resizeEvent(event);
+        m_editorPrivate->updateScrollBars();
+        m_editorPrivate->layoutRows();
+    }
+
+    void scrollContentsBy(int, int)
+    {
+        m_editorPrivate->layoutRows();
+        viewport()->update();
+    }
+
+private:
+    QtVirtualGroupBoxPropertyBrowserPrivate *m_editorPrivate;
+};
+
+//  -------- QtVirtualGroupBoxPropertyBrowserPrivate implementation
+QtVirtualGroupBoxPropertyBrowserPrivate::QtVirtualGroupBoxPropertyBrowserPrivate() :
+    m_view(0),
+    m_contentsHeight(0),
+    m_rowHeight(0),
+    m_titleHeight(0),
+    m_spacing(0),
+    m_indentation(0),
+    m_rowsDirty(false),
+    m_updatePending(false)
+{
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::init(QWidget *parent)
+{
+    QHBoxLayout *layout = new QHBoxLayout(parent);
+    layout->setMargin(0);
+    m_view = new QtVirtualGroupBoxView(this, parent);
+    layout->addWidget(m_view);
+
+    // Rows whose widgets have not been created yet are estimated with the
+    // height of a common editor, so that the position of any row is known
+    // without creating its widgets.
+    QComboBox probe;
+    m_spacing = parent->style()->pixelMetric(QStyle::PM_LayoutVerticalSpacing);
+    if (m_spacing < 0)
+        m_spacing = 6;
+    m_rowHeight = probe.sizeHint().height();
+    m_titleHeight = parent->fontMetrics().height() + m_spacing;
+    m_indentation = 2 * m_spacing;
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::slotEditorDestroyed()
+{
+    QWidget *editor = qobject_cast<QWidget *>(q_ptr->sender());
+    if (!editor)
+        return;
+    QtBrowserItem *index = m_widgetToIndex.take(editor);
+    if (WidgetItem *item = m_indexToItem.value(index))
+        item->widget = 0;
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::slotUpdate()
+{
+    m_updatePending = false;
+    if (m_rowsDirty)
+        rebuildRows();
+    layoutRows();
+    m_view->viewport()->update();
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::updateLater()
+{
+    if (m_updatePending)
+        return;
+    m_updatePending = true;
+    QTimer::singleShot(0, q_ptr, SLOT(slotUpdate()));
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::appendRow(QtBrowserItem *index, RowType type, int depth, int height)
+{
+    Row row;
+    row.index = index;
+    row.type = type;
+    row.depth = depth;
+    row.top = m_contentsHeight;
+    row.height = height;
+    if (type == PropertyRow || type == GroupEditorRow)
+        m_indexToRow[index] = m_rows.count();
+    m_rows.append(row);
+    m_contentsHeight += height;
+}
+
+int QtVirtualGroupBoxPropertyBrowserPrivate::rowHeight(QtBrowserItem *index) const
+{
+    const QHash<QtBrowserItem *, int>::ConstIterator it = m_indexToHeight.constFind(index);
+    if (it != m_indexToHeight.constEnd())
+        return it.value();
+    return m_managerToHeight.value(index->property()->propertyManager(), m_rowHeight);
+}
+
+// Records the height the widgets of item need. If it differs from the height
+// the row was laid out with, the rows are rebuilt.
+void QtVirtualGroupBoxPropertyBrowserPrivate::measureItem(QtBrowserItem *index, WidgetItem *item)
+{
+    int height = 0;
+    if (item->label)
+        height = item->label->sizeHint().height();
+    if (item->widget)
+        height = qMax(height, item->widget->sizeHint().height());
+    else if (item->widgetLabel)
+        height = qMax(height, item->widgetLabel->sizeHint().height());
+    if (height <= 0)
+        height = m_rowHeight;
+
+    const int oldHeight = rowHeight(index);
+    m_indexToHeight[index] = height;
+    m_managerToHeight[index->property()->propertyManager()] = height;
+    if (height != oldHeight) {
+        m_rowsDirty = true;
+        updateLater();
+    }
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::appendRows(QtBrowserItem *index, int depth)
+{
+    const QList<QtBrowserItem *> children = index->children();
+    if (children.isEmpty()) {
+        appendRow(index, PropertyRow, depth, rowHeight(index) + m_spacing);
+        return;
+    }
+
+    const int groupIndex = m_groups.count();
+    Group group;
+    group.index = index;
+    group.depth = depth;
+    group.firstRow = m_rows.count();
+    group.lastRow = group.firstRow;
+    m_groups.append(group);
+
+    appendRow(index, GroupTitleRow, depth, m_titleHeight);
+    if (index->property()->hasValue())
+        appendRow(index, GroupEditorRow, depth + 1, rowHeight(index) + m_spacing);
+    QListIterator<QtBrowserItem *> itChild(children);
+    while (itChild.hasNext())
+        appendRows(itChild.next(), depth + 1);
+    appendRow(index, GroupEndRow, depth, m_spacing);
+
+    m_groups[groupIndex].lastRow = m_rows.count() - 1;
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::rebuildRows()
+{
+    m_rows.clear();
+    m_groups.clear();
+    m_indexToRow.clear();
+    m_contentsHeight = m_spacing;
+
+    QListIterator<QtBrowserItem *> itTopLevel(q_ptr->topLevelItems());
+    while (itTopLevel.hasNext())
+        appendRows(itTopLevel.next(), 0);
+
+    m_rowsDirty = false;
+    updateScrollBars();
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::updateScrollBars()
+{
+    const int viewportHeight = m_view->viewport()->height();
+    QScrollBar *scrollBar = m_view->verticalScrollBar();
+    scrollBar->setSingleStep(m_rowHeight + m_spacing);
+    scrollBar->setPageStep(viewportHeight);
+    scrollBar->setRange(0, qMax(0, m_contentsHeight - viewportHeight));
+}
+
+int QtVirtualGroupBoxPropertyBrowserPrivate::rowAt(int y) const
+{
+    int first = 0;
+    int last = m_rows.count() - 1;
+    while (first < last) {
+        const int middle = (first + last + 1) / 2;
+        if (m_rows.at(middle).top <= y)
+            first = middle;
+        else
+            last = middle - 1;
+    }
+    return first;
+}
+
+int QtVirtualGroupBoxPropertyBrowserPrivate::left(int depth) const
+{
+    return m_spacing + depth * m_indentation;
+}
+
+int QtVirtualGroupBoxPropertyBrowserPrivate::right(int depth) const
+{
+    return m_view->viewport()->width() - m_spacing - depth * m_indentation;
+}
+
+QLabel *QtVirtualGroupBoxPropertyBrowserPrivate::takeLabel()
+{
+    if (!m_labelPool.isEmpty())
+        return m_labelPool.takeLast();
+    QLabel *label = new QLabel(m_view->viewport());
+    label->setTextFormat(Qt::PlainText);
+    return label;
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::recycleLabel(QLabel *label)
+{
+    if (!label)
+        return;
+    label->hide();
+    m_labelPool.append(label);
+}
+
+bool QtVirtualGroupBoxPropertyBrowserPrivate::hasFocusWithin(QWidget *widget) const
+{
+    QWidget *focusWidget = QApplication::focusWidget();
+    return focusWidget && (focusWidget == widget || widget->isAncestorOf(focusWidget));
+}
+
+QtVirtualGroupBoxPropertyBrowserPrivate::WidgetItem *QtVirtualGroupBoxPropertyBrowserPrivate::realizeItem(QtBrowserItem *index, RowType type)
+{
+    WidgetItem *item = m_indexToItem.value(index);
+    if (item)
+        return item;
+
+    item = new WidgetItem();
+    if (type == PropertyRow)
+        item->label = takeLabel();
+    item->widget = createEditor(index->property(), m_view->viewport());
+    if (item->widget) {
+        QObject::connect(item->widget, SIGNAL(destroyed()), q_ptr, SLOT(slotEditorDestroyed()));
+        m_widgetToIndex[item->widget] = index;
+    } else {
+        item->widgetLabel = takeLabel();
+    }
+    m_indexToItem[index] = item;
+
+    updateItem(index, item);
+    measureItem(index, item);
+    return item;
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::releaseItem(QtBrowserItem *index)
+{
+    WidgetItem *item = m_indexToItem.take(index);
+    if (!item)
+        return;
+
+    if (item->widget) {
+        QObject::disconnect(item->widget, SIGNAL(destroyed()), q_ptr, SLOT(slotEditorDestroyed()));
+        m_widgetToIndex.remove(item->widget);
+        // Give the editor back to its factory, which may hand it out again
+        // for a row scrolled into view.
+        q_ptr->releaseEditor(item->widget);
+    }
+    recycleLabel(item->label);
+    recycleLabel(item->widgetLabel);
+    delete item;
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::placeItem(WidgetItem *item, const Row &row)
+{
+    const int offset = m_view->verticalScrollBar()->value();
+    const int x = left(row.depth);
+    const int width = right(row.depth) - x;
+    const int y = row.top - offset + m_spacing / 2;
+    const int height = row.height - m_spacing;
+
+    QWidget *valueWidget = item->widget ? item->widget : item->widgetLabel;
+    if (item->label) {
+        const int labelWidth = width * 2 / 5;
+        item->label->setGeometry(x, y, labelWidth - m_spacing, height);
+        item->label->show();
+        if (valueWidget)
+            valueWidget->setGeometry(x + labelWidth, y, width - labelWidth, height);
+    } else if (valueWidget) {
+        valueWidget->setGeometry(x, y, width, height);
+    }
+    if (valueWidget)
+        valueWidget->show();
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::layoutRows()
+{
+    if (m_rowsDirty)
+        rebuildRows();
+
+    const int offset = m_view->verticalScrollBar()->value();
+    const int bottom = offset + m_view->viewport()->height();
+
+    QSet<QtBrowserItem *> visibleItems;
+    for (int i = rowAt(offset); i < m_rows.count() && m_rows.at(i).top < bottom; ++i) {
+        const Row &row = m_rows.at(i);
+        if (row.type != PropertyRow && row.type != GroupEditorRow)
+            continue;
+        visibleItems.insert(row.index);
+        placeItem(realizeItem(row.index, row.type), row);
+    }
+
+    // Widgets scrolled out of the viewport are released, unless the user is
+    // still editing in them.
+    const QList<QtBrowserItem *> realizedItems = m_indexToItem.keys();
+    QListIterator<QtBrowserItem *> itRealized(realizedItems);
+    while (itRealized.hasNext()) {
+        QtBrowserItem *index = itRealized.next();
+        if (visibleItems.contains(index))
+            continue;
+        WidgetItem *item = m_indexToItem.value(index);
+        if (item->widget && hasFocusWithin(item->widget) && m_indexToRow.contains(index))
+            placeItem(item, m_rows.at(m_indexToRow.value(index)));
+        else
+            releaseItem(index);
+    }
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::paintGroups(QPainter *painter, const QRect &clip)
+{
+    if (m_rowsDirty)
+        rebuildRows();
+
+    const int offset = m_view->verticalScrollBar()->value();
+    QListIterator<Group> itGroup(m_groups);
+    while (itGroup.hasNext()) {
+        const Group &group = itGroup.next();
+        const Row &firstRow = m_rows.at(group.firstRow);
+        const Row &lastRow = m_rows.at(group.lastRow);
+        const int x = left(group.depth);
+        const QRect rect(x, firstRow.top - offset, right(group.depth) - x,
+                    lastRow.top + lastRow.height - firstRow.top);
+        if (!rect.intersects(clip))
+            continue;
+
+        QtProperty *property = group.index->property();
+        QStyleOptionGroupBox option;
+        option.initFrom(q_ptr);
+        option.rect = rect;
+        option.text = property->propertyName();
+        option.textAlignment = Qt::AlignLeft;
+        option.subControls = QStyle::SC_GroupBoxFrame | QStyle::SC_GroupBoxLabel;
+        option.lineWidth = 1;
+        option.midLineWidth = 0;
+        option.textColor = q_ptr->palette().color(QPalette::WindowText);
+        if (!property->isEnabled())
+            option.state &= ~QStyle::State_Enabled;
+
+        QFont font = q_ptr->font();
+        font.setUnderline(property->isModified());
+        painter->setFont(font);
+        q_ptr->style()->drawComplexControl(QStyle::CC_GroupBox, &option, painter, q_ptr);
+    }
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::propertyInserted(QtBrowserItem *index, QtBrowserItem *afterIndex)
+{
+    Q_UNUSED(afterIndex)
+    // The parent may turn from a plain row into a group, which lays out
+    // its widgets differently.
+    if (index->parent())
+        releaseItem(index->parent());
+    m_rowsDirty = true;
+    updateLater();
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
+{
+    releaseItem(index);
+    m_indexToHeight.remove(index);
+    if (index->parent())
+        releaseItem(index->parent());
+    m_rowsDirty = true;
+    updateLater();
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::propertyChanged(QtBrowserItem *index)
+{
+    if (WidgetItem *item = m_indexToItem.value(index))
+        updateItem(index, item);
+    if (index->children().count() > 0)
+        m_view->viewport()->update();
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::propertiesChanged(const QList<QtBrowserItem *> &indexes)
+{
+    bool headerChanged = false;
+    QListIterator<QtBrowserItem *> itIndex(indexes);
+    while (itIndex.hasNext()) {
+        QtBrowserItem *index = itIndex.next();
+        if (WidgetItem *item = m_indexToItem.value(index))
+            updateItem(index, item);
+        if (index->children().count() > 0)
+            headerChanged = true;
+    }
+    if (headerChanged)
+        m_view->viewport()->update();
+}
+
+void QtVirtualGroupBoxPropertyBrowserPrivate::updateItem(QtBrowserItem *index, WidgetItem *item)
+{
+    QtProperty *property = index->property();
+    if (item->label) {
+        QFont font = item->label->font();
+        font.setUnderline(property->isModified());
+        item->label->setFont(font);
+        item->label->setText(property->propertyName());
+        item->label->setToolTip(property->toolTip());
+        item->label->setStatusTip(property->statusTip());
+        item->label->setWhatsThis(property->whatsThis());
+        item->label->setEnabled(property->isEnabled());
+    }
+    if (item->widgetLabel) {
+        QFont font = item->widgetLabel->font();
+        font.setUnderline(false);
+        item->widgetLabel->setFont(font);
+        item->widgetLabel->setText(property->valueText());
+        item->widgetLabel->setToolTip(property->valueText());
+        item->widgetLabel->setStatusTip(QString());
+        item->widgetLabel->setWhatsThis(QString());
+        item->widgetLabel->setEnabled(property->isEnabled());
+    }
+    if (item->widget) {
+        QFont font = item->widget->font();
+        font.setUnderline(false);
+        item->widget->setFont(font);
+        item->widget->setEnabled(property->isEnabled());
+        item->widget->setToolTip(property->valueText());
+    }
+}
+
+/*!
+    \class QtVirtualGroupBoxPropertyBrowser
+
+    \brief The QtVirtualGroupBoxPropertyBrowser class provides a
+    QGroupBox styled property browser that only creates widgets for
+    the visible properties.
+
+    QtVirtualGroupBoxPropertyBrowser shows properties the same way as
+    QtGroupBoxPropertyBrowser: subproperties are enclosed by a group
+    box with the parent property's name as its title. Instead of
+    creating a label and an editor for every property up front, it
+    lays the properties out in a scroll area and creates the widgets
+    of a property only while its row is inside the visible area.
+
+    Name and value labels of rows scrolled out of view are recycled
+    for the rows scrolled into view. Editors of rows leaving the
+    visible area are handed back to their factory with
+    releaseEditor(); the factories shipped with this solution keep
+    them and reuse them for rows of the same type scrolled into
+    view. An editor that has the keyboard focus is kept alive until
+    the focus moves elsewhere.
+
+    Each row is as tall as the size hint of its widgets. Rows that
+    have not been shown yet are assumed to be as tall as the last
+    row of the same property manager (initially the height of a
+    combobox), and the layout is corrected when they are shown. The
+    group box frames are painted rather than being QGroupBox widgets.
+
+    \sa QtGroupBoxPropertyBrowser, QtAbstractPropertyBrowser
+*/
+
+/*!
+    Creates a property browser with the given \a parent.
+*/
+QtVirtualGroupBoxPropertyBrowser::QtVirtualGroupBoxPropertyBrowser(QWidget *parent)
+    : QtAbstractPropertyBrowser(parent)
+{
+    d_ptr = new QtVirtualGroupBoxPropertyBrowserPrivate;
+    d_ptr->q_ptr = this;
+
+    d_ptr->init(this);
+}
+
+/*!
+    Destroys this property browser.
+
+    Note that the properties that were inserted into this browser are
+    \e not destroyed since they may still be used in other
+    browsers. The properties are owned by the manager that created
+    them.
+
+    \sa QtProperty, QtAbstractPropertyManager
+*/
+QtVirtualGroupBoxPropertyBrowser::~QtVirtualGroupBoxPropertyBrowser()
+{
+    const QMap<QWidget *, QtBrowserItem *>::ConstIterator wcend = d_ptr->m_widgetToIndex.constEnd();
+    for (QMap<QWidget *, QtBrowserItem *>::ConstIterator it = d_ptr->m_widgetToIndex.constBegin(); it != wcend; ++it)
+        disconnect(it.key(), SIGNAL(destroyed()), this, SLOT(slotEditorDestroyed()));
+    const QMap<QtBrowserItem *, QtVirtualGroupBoxPropertyBrowserPrivate::WidgetItem *>::ConstIterator icend = d_ptr->m_indexToItem.constEnd();
+    for (QMap<QtBrowserItem *, QtVirtualGroupBoxPropertyBrowserPrivate::WidgetItem *>::ConstIterator it = d_ptr->m_indexToItem.constBegin(); it != icend; ++it)
+        delete it.value();
+    delete d_ptr;
+}
+
+/*!
+    \reimp
+*/
+void QtVirtualGroupBoxPropertyBrowser::itemInserted(QtBrowserItem *item, QtBrowserItem *afterItem)
+{
+    d_ptr->propertyInserted(item, afterItem);
+}
+
+/*!
+    \reimp
+*/
+void QtVirtualGroupBoxPropertyBrowser::itemRemoved(QtBrowserItem *item)
+{
+    d_ptr->propertyRemoved(item);
+}
+
+/*!
+    \reimp
+*/
+void QtVirtualGroupBoxPropertyBrowser::itemChanged(QtBrowserItem *item)
+{
+    d_ptr->propertyChanged(item);
+}
+
+/*!
+    \reimp
+*/
+void QtVirtualGroupBoxPropertyBrowser::itemsChanged(const QList<QtBrowserItem *> &items)
+{
+    d_ptr->propertiesChanged(items);
+}
+
+#if QT_VERSION >= 0x040400
+QT_END_NAMESPACE
+#endif
+
+#include "moc_qtvirtualgroupboxpropertybrowser.cpp"